@@ -0,0 +1,415 @@
+/**
+ * bridge_client.c
+ *
+ * Load generator for bridge_server
+ * Opens several connections, keeps a fixed number of requests in flight on
+ * each (pipelining) and reports throughput and latency percentiles. Each
+ * connection is non-blocking and polled, so replies are drained while large
+ * requests are still being written.
+ *
+ * Usage: bridge_client [socket-path] [connections] [requests] [depth] [text|binary] [size]
+ *   requests  per connection
+ *   depth     requests in flight per connection
+ *   text      command batches: add two tensors, decode, release
+ *   binary    COMPUTE messages: add two tensor frames, frame reply
+ *   size      floats per operand tensor
+ */
+
+#include "scheme_neural_bridge.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <time.h>
+#include <unistd.h>
+
+#define DEFAULT_SOCKET_PATH "/tmp/neural_bridge.sock"
+
+// ============================================================================
+// CONNECTION WORKERS
+// ============================================================================
+
+/**
+ * Per-connection worker state
+ */
+typedef struct {
+    const char* path;
+    const uint8_t* request;     // Complete message, header included
+    size_t request_size;
+    size_t n_requests;
+    size_t depth;
+    double* latencies;          // [n_requests] seconds
+    size_t n_errors;
+    size_t bytes_received;
+    bool started;
+    bool failed;
+} client_worker_t;
+
+/**
+ * In-progress traffic on one non-blocking connection
+ */
+typedef struct {
+    double* sent_at;            // [depth] ring, replies come back in request order
+    size_t n_sent;              // Requests fully written
+    size_t n_done;              // Replies fully read
+    size_t out_offset;          // Bytes of the current request already written
+    uint8_t header[BRIDGE_MESSAGE_HEADER_SIZE];
+    size_t header_have;
+    uint8_t reply_type;
+    size_t reply_length;
+    size_t reply_have;
+    uint8_t* reply;
+    size_t reply_capacity;
+} client_stream_t;
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/**
+ * Send from the current request until the window is full or the socket would block
+ */
+static bool worker_send(client_worker_t* worker, int fd, client_stream_t* stream) {
+    while (stream->n_sent < worker->n_requests &&
+           stream->n_sent - stream->n_done < worker->depth) {
+        if (stream->out_offset == 0) {
+            stream->sent_at[stream->n_sent % worker->depth] = now_seconds();
+        }
+        ssize_t sent = send(fd, worker->request + stream->out_offset,
+                            worker->request_size - stream->out_offset, MSG_NOSIGNAL);
+        if (sent < 0) {
+            if (errno == EINTR) continue;
+            return errno == EAGAIN || errno == EWOULDBLOCK;
+        }
+        stream->out_offset += (size_t)sent;
+        if (stream->out_offset == worker->request_size) {
+            stream->out_offset = 0;
+            stream->n_sent++;
+        }
+    }
+    return true;
+}
+
+/**
+ * Read whatever has arrived, completing replies header first, then payload
+ */
+static bool worker_receive(client_worker_t* worker, int fd, client_stream_t* stream) {
+    for (;;) {
+        bool in_header = stream->header_have < BRIDGE_MESSAGE_HEADER_SIZE;
+        uint8_t* target = in_header ? stream->header + stream->header_have
+                                    : stream->reply + stream->reply_have;
+        size_t wanted = in_header ? BRIDGE_MESSAGE_HEADER_SIZE - stream->header_have
+                                  : stream->reply_length - stream->reply_have;
+    
+        if (wanted > 0) {
+            ssize_t received = recv(fd, target, wanted, 0);
+            if (received < 0) {
+                if (errno == EINTR) continue;
+                return errno == EAGAIN || errno == EWOULDBLOCK;
+            }
+            if (received == 0) return false;
+            if (in_header) {
+                stream->header_have += (size_t)received;
+            } else {
+                stream->reply_have += (size_t)received;
+            }
+        }
+    
+        if (in_header) {
+            if (stream->header_have < BRIDGE_MESSAGE_HEADER_SIZE) continue;
+            if (!bridge_message_parse_header(stream->header, &stream->reply_type,
+                                             &stream->reply_length)) {
+                return false;
+            }
+            if (stream->reply_length > stream->reply_capacity) {
+                uint8_t* grown = (uint8_t*)realloc(stream->reply, stream->reply_length);
+                if (!grown) return false;
+                stream->reply = grown;
+                stream->reply_capacity = stream->reply_length;
+            }
+            stream->reply_have = 0;
+        }
+        if (stream->reply_have < stream->reply_length) continue;
+    
+        // A reply for a request never sent means the stream is out of sync
+        if (stream->n_done >= stream->n_sent) return false;
+        worker->latencies[stream->n_done] =
+            now_seconds() - stream->sent_at[stream->n_done % worker->depth];
+        worker->bytes_received += BRIDGE_MESSAGE_HEADER_SIZE + stream->reply_length;
+        if (stream->reply_type == BRIDGE_MESSAGE_ERROR) worker->n_errors++;
+        stream->n_done++;
+        stream->header_have = 0;
+        stream->reply_length = 0;
+        stream->reply_have = 0;
+        if (stream->n_done == worker->n_requests) return true;
+    }
+}
+
+static int connect_to(const char* path) {
+    struct sockaddr_un address;
+    if (strlen(path) >= sizeof(address.sun_path)) return -1;
+    
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+    
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strcpy(address.sun_path, path);
+    if (connect(fd, (struct sockaddr*)&address, sizeof(address)) < 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static void* client_worker_main(void* arg) {
+    client_worker_t* worker = (client_worker_t*)arg;
+    
+    client_stream_t stream;
+    memset(&stream, 0, sizeof(stream));
+    stream.sent_at = (double*)malloc(worker->depth * sizeof(double));
+    stream.reply_capacity = 4096;
+    stream.reply = (uint8_t*)malloc(stream.reply_capacity);
+    
+    int fd = connect_to(worker->path);
+    if (fd < 0 || !stream.sent_at || !stream.reply ||
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK) < 0) {
+        worker->failed = true;
+        if (fd >= 0) close(fd);
+        free(stream.sent_at);
+        free(stream.reply);
+        return NULL;
+    }
+    
+    // Interleave writes and reads so neither side blocks on a full socket buffer
+    while (stream.n_done < worker->n_requests) {
+        struct pollfd entry = {fd, POLLIN, 0};
+        if (stream.n_sent < worker->n_requests &&
+            stream.n_sent - stream.n_done < worker->depth) {
+            entry.events |= POLLOUT;
+        }
+        if (poll(&entry, 1, -1) < 0) {
+            if (errno == EINTR) continue;
+            worker->failed = true;
+            break;
+        }
+        if ((entry.revents & POLLOUT) && !worker_send(worker, fd, &stream)) {
+            worker->failed = true;
+            break;
+        }
+        if ((entry.revents & (POLLIN | POLLHUP | POLLERR)) &&
+            !worker_receive(worker, fd, &stream)) {
+            worker->failed = true;
+            break;
+        }
+    }
+    
+    close(fd);
+    free(stream.sent_at);
+    free(stream.reply);
+    return NULL;
+}
+
+// ============================================================================
+// REQUESTS
+// ============================================================================
+
+static neural_tensor_t* operand_tensor(size_t size, float scale) {
+    size_t shape[1] = {size};
+    neural_tensor_t* tensor = neural_tensor_create(shape, 1);
+    if (!tensor) return NULL;
+    for (size_t i = 0; i < size; i++) {
+        tensor->data[i] = scale * (float)(i % 97) / 97.0f;
+    }
+    return tensor;
+}
+
+/**
+ * Text request: one command batch that adds two inline tensors
+ */
+static uint8_t* build_text_request(const neural_tensor_t* a, const neural_tensor_t* b,
+                                   size_t* size) {
+    char* text_a = tensor_to_scheme_list(a);
+    char* text_b = tensor_to_scheme_list(b);
+    uint8_t* message = NULL;
+    
+    if (text_a && text_b) {
+        const char* format = "(neural-compute add %s %s) (decode (ref 0)) (release (ref 0))";
+        size_t length = strlen(format) + strlen(text_a) + strlen(text_b);
+        message = (uint8_t*)malloc(BRIDGE_MESSAGE_HEADER_SIZE + length + 1);
+        if (message) {
+            int written = snprintf((char*)message + BRIDGE_MESSAGE_HEADER_SIZE, length + 1,
+                                   format, text_a, text_b);
+            bridge_message_header(message, BRIDGE_MESSAGE_COMMANDS, (size_t)written);
+            *size = BRIDGE_MESSAGE_HEADER_SIZE + (size_t)written;
+        }
+    }
+    
+    free(text_a);
+    free(text_b);
+    return message;
+}
+
+/**
+ * Binary request: COMPUTE "add" over two tensor frames
+ */
+static uint8_t* build_binary_request(const neural_tensor_t* a, const neural_tensor_t* b,
+                                     size_t* size) {
+    const char* operation = "add";
+    size_t name_size = (1 + strlen(operation) + 7) & ~(size_t)7;
+    size_t payload = name_size + scheme_frame_size(a) + scheme_frame_size(b);
+    
+    uint8_t* message = (uint8_t*)calloc(1, BRIDGE_MESSAGE_HEADER_SIZE + payload);
+    if (!message) return NULL;
+    
+    uint8_t* out = message + BRIDGE_MESSAGE_HEADER_SIZE;
+    out[0] = (uint8_t)strlen(operation);
+    memcpy(out + 1, operation, strlen(operation));
+    out += name_size;
+    out += scheme_encode_tensor(a, out, scheme_frame_size(a));
+    scheme_encode_tensor(b, out, scheme_frame_size(b));
+    
+    bridge_message_header(message, BRIDGE_MESSAGE_COMPUTE, payload);
+    *size = BRIDGE_MESSAGE_HEADER_SIZE + payload;
+    return message;
+}
+
+static int compare_doubles(const void* a, const void* b) {
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+static void print_usage(FILE* stream, const char* program) {
+    fprintf(stream, "Usage: %s [socket-path] [connections] [requests] [depth] "
+            "[text|binary] [size]\n", program);
+    fprintf(stream, "  socket-path  Unix socket of bridge_server (default %s)\n",
+            DEFAULT_SOCKET_PATH);
+    fprintf(stream, "  connections  Concurrent connections (default 4)\n");
+    fprintf(stream, "  requests     Requests per connection (default 10000)\n");
+    fprintf(stream, "  depth        Requests in flight per connection (default 16)\n");
+    fprintf(stream, "  text|binary  Command batches or COMPUTE messages (default text)\n");
+    fprintf(stream, "  size         Floats per operand tensor (default 64)\n");
+}
+
+/**
+ * Parse a positive decimal count argument; false unless the whole text is a number
+ */
+static bool parse_count(const char* text, size_t* out) {
+    if (text[0] < '0' || text[0] > '9') return false;
+    
+    char* end = NULL;
+    errno = 0;
+    unsigned long long value = strtoull(text, &end, 10);
+    if (errno != 0 || *end != '\0' || value == 0 || value > SIZE_MAX) return false;
+    *out = (size_t)value;
+    return true;
+}
+
+int main(int argc, char** argv) {
+    const char* path = DEFAULT_SOCKET_PATH;
+    size_t n_connections = 4;
+    size_t n_requests = 10000;
+    size_t depth = 16;
+    bool binary = false;
+    size_t tensor_size = 64;
+    
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+            print_usage(stdout, argv[0]);
+            return 0;
+        }
+    }
+    if (argc > 7 || (argc > 1 && argv[1][0] == '-') ||
+        (argc > 2 && !parse_count(argv[2], &n_connections)) ||
+        (argc > 3 && !parse_count(argv[3], &n_requests)) ||
+        (argc > 4 && !parse_count(argv[4], &depth)) ||
+        (argc > 5 && strcmp(argv[5], "text") != 0 && strcmp(argv[5], "binary") != 0) ||
+        (argc > 6 && !parse_count(argv[6], &tensor_size))) {
+        print_usage(stderr, argv[0]);
+        return 2;
+    }
+    if (argc > 1) path = argv[1];
+    if (argc > 5) binary = strcmp(argv[5], "binary") == 0;
+    
+    // Every latency sample is kept for the percentiles
+    if (n_requests > SIZE_MAX / sizeof(double) / n_connections) {
+        fprintf(stderr, "connections x requests is too large\n");
+        return 2;
+    }
+    
+    neural_tensor_t* a = operand_tensor(tensor_size, 1.0f);
+    neural_tensor_t* b = operand_tensor(tensor_size, -0.5f);
+    size_t request_size = 0;
+    uint8_t* request = (a && b) ? (binary ? build_binary_request(a, b, &request_size)
+                                          : build_text_request(a, b, &request_size))
+                                : NULL;
+    neural_tensor_free(a);
+    neural_tensor_free(b);
+    
+    client_worker_t* workers = (client_worker_t*)calloc(n_connections, sizeof(client_worker_t));
+    pthread_t* threads = (pthread_t*)calloc(n_connections, sizeof(pthread_t));
+    double* latencies = (double*)malloc(n_connections * n_requests * sizeof(double));
+    if (!request || !workers || !threads || !latencies) {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+    
+    printf("Bridge load: %zu connections x %zu %s requests, depth %zu, %zu floats per operand\n",
+           n_connections, n_requests, binary ? "binary" : "text", depth, tensor_size);
+    printf("  Request size: %zu bytes\n", request_size);
+    
+    double start = now_seconds();
+    for (size_t i = 0; i < n_connections; i++) {
+        workers[i].path = path;
+        workers[i].request = request;
+        workers[i].request_size = request_size;
+        workers[i].n_requests = n_requests;
+        workers[i].depth = depth;
+        workers[i].latencies = latencies + i * n_requests;
+        workers[i].started = (pthread_create(&threads[i], NULL, client_worker_main,
+                                             &workers[i]) == 0);
+        workers[i].failed = !workers[i].started;
+    }
+    for (size_t i = 0; i < n_connections; i++) {
+        if (workers[i].started) pthread_join(threads[i], NULL);
+    }
+    double elapsed = now_seconds() - start;
+    
+    size_t n_errors = 0;
+    size_t bytes_received = 0;
+    for (size_t i = 0; i < n_connections; i++) {
+        if (workers[i].failed) {
+            fprintf(stderr, "Connection %zu failed (is bridge_server running on %s?)\n", i, path);
+            return 1;
+        }
+        n_errors += workers[i].n_errors;
+        bytes_received += workers[i].bytes_received;
+    }
+    
+    size_t total = n_connections * n_requests;
+    qsort(latencies, total, sizeof(double), compare_doubles);
+    
+    printf("  Requests:   %zu in %.3f s (%zu errors)\n", total, elapsed, n_errors);
+    printf("  Throughput: %.0f requests/s, %.1f MB/s in, %.1f MB/s out\n",
+           (double)total / elapsed,
+           (double)total * (double)request_size / elapsed / 1e6,
+           (double)bytes_received / elapsed / 1e6);
+    printf("  Latency:    p50 %.1f us, p99 %.1f us, max %.1f us\n",
+           latencies[total / 2] * 1e6,
+           latencies[(size_t)((double)(total - 1) * 0.99)] * 1e6,
+           latencies[total - 1] * 1e6);
+    
+    free(request);
+    free(workers);
+    free(threads);
+    free(latencies);
+    return n_errors == 0 ? 0 : 1;
+}
@@ -0,0 +1,404 @@
+/**
+ * bridge_server.c
+ *
+ * Neural-Symbolic Bridge Server
+ * Serves the bridge over a Unix domain socket so the Scheme mind layer can
+ * run in its own process. One epoll loop handles every connection; each
+ * connection owns a bridge session (cognitive context + resident tensors).
+ * Requests are length-prefixed bridge messages and may be pipelined.
+ *
+ * Usage: bridge_server [socket-path] [n-nodes] [memory-capacity]
+ *        bridge_server --help
+ */
+
+#define _GNU_SOURCE
+#include "scheme_neural_bridge.h"
+#include <errno.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#define DEFAULT_SOCKET_PATH "/tmp/neural_bridge.sock"
+#define MAX_EVENTS 64
+#define READ_CHUNK 65536
+
+// Stop reading from a client whose unsent replies exceed this
+#define OUTPUT_HIGH_WATER (64u << 20)
+
+/**
+ * Growable byte buffer; [start, length) is pending
+ */
+typedef struct {
+    uint8_t* data;
+    size_t start;
+    size_t length;
+    size_t capacity;
+} byte_buffer_t;
+
+/**
+ * One client connection (linked into the server's list of open connections)
+ */
+typedef struct connection {
+    struct connection* prev;
+    struct connection* next;
+    int fd;
+    bridge_session_t* session;
+    byte_buffer_t input;
+    byte_buffer_t output;
+    bool read_closed;           // Peer finished sending; close once replies drain
+    uint32_t events;            // Currently registered epoll events
+} connection_t;
+
+static volatile sig_atomic_t stopping = 0;
+
+// Open connections, closed on shutdown
+static connection_t* connections = NULL;
+
+static void on_signal(int sig) {
+    (void)sig;
+    stopping = 1;
+}
+
+// ============================================================================
+// BUFFERS
+// ============================================================================
+
+/**
+ * Make room for extra bytes after the pending data (consumed bytes are dropped)
+ */
+static bool buffer_reserve(byte_buffer_t* buffer, size_t extra) {
+    if (buffer->start > 0) {
+        // Compact so the next payload starts at the (malloc-aligned) front
+        memmove(buffer->data, buffer->data + buffer->start, buffer->length - buffer->start);
+        buffer->length -= buffer->start;
+        buffer->start = 0;
+    }
+    if (buffer->length + extra <= buffer->capacity) return true;
+    
+    size_t capacity = buffer->capacity ? buffer->capacity : READ_CHUNK;
+    while (capacity < buffer->length + extra) capacity *= 2;
+    uint8_t* data = (uint8_t*)realloc(buffer->data, capacity);
+    if (!data) return false;
+    buffer->data = data;
+    buffer->capacity = capacity;
+    return true;
+}
+
+static bool buffer_append(byte_buffer_t* buffer, const uint8_t* bytes, size_t length) {
+    if (buffer->length + length > buffer->capacity && !buffer_reserve(buffer, length)) {
+        return false;
+    }
+    memcpy(buffer->data + buffer->length, bytes, length);
+    buffer->length += length;
+    return true;
+}
+
+// ============================================================================
+// CONNECTIONS
+// ============================================================================
+
+static connection_t* connection_create(int fd, size_t n_nodes, size_t memory_capacity) {
+    connection_t* connection = (connection_t*)calloc(1, sizeof(connection_t));
+    if (!connection) return NULL;
+    
+    connection->fd = fd;
+    connection->session = bridge_session_create(n_nodes, memory_capacity);
+    if (!connection->session) {
+        free(connection);
+        return NULL;
+    }
+    
+    connection->next = connections;
+    if (connections) connections->prev = connection;
+    connections = connection;
+    return connection;
+}
+
+static void connection_close(int epoll_fd, connection_t* connection) {
+    if (connection->prev) {
+        connection->prev->next = connection->next;
+    } else {
+        connections = connection->next;
+    }
+    if (connection->next) connection->next->prev = connection->prev;
+    
+    epoll_ctl(epoll_fd, EPOLL_CTL_DEL, connection->fd, NULL);
+    close(connection->fd);
+    bridge_session_free(connection->session);
+    free(connection->input.data);
+    free(connection->output.data);
+    free(connection);
+}
+
+/**
+ * Answer every complete request in the input buffer, in order
+ */
+static bool connection_process(connection_t* connection) {
+    byte_buffer_t* input = &connection->input;
+    
+    while (input->length - input->start >= BRIDGE_MESSAGE_HEADER_SIZE) {
+        const uint8_t* header = input->data + input->start;
+        uint8_t type;
+        size_t length;
+        if (!bridge_message_parse_header(header, &type, &length)) return false;
+        if (input->length - input->start < BRIDGE_MESSAGE_HEADER_SIZE + length) break;
+    
+        uint8_t reply_type;
+        size_t reply_length = 0;
+        uint8_t* reply = bridge_session_message(connection->session, type,
+                                                header + BRIDGE_MESSAGE_HEADER_SIZE, length,
+                                                &reply_type, &reply_length);
+        if (!reply) return false;
+    
+        uint8_t reply_header[BRIDGE_MESSAGE_HEADER_SIZE];
+        bridge_message_header(reply_header, reply_type, reply_length);
+        bool ok = buffer_append(&connection->output, reply_header, sizeof(reply_header)) &&
+                  buffer_append(&connection->output, reply, reply_length);
+        free(reply);
+        if (!ok) return false;
+    
+        input->start += BRIDGE_MESSAGE_HEADER_SIZE + length;
+    }
+    
+    if (input->start == input->length) {
+        input->start = 0;
+        input->length = 0;
+    }
+    return true;
+}
+
+/**
+ * Send as much pending output as the socket takes
+ */
+static bool connection_flush(connection_t* connection) {
+    byte_buffer_t* output = &connection->output;
+    
+    while (output->start < output->length) {
+        ssize_t sent = send(connection->fd, output->data + output->start,
+                            output->length - output->start, MSG_NOSIGNAL);
+        if (sent < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) return true;
+            return false;
+        }
+        output->start += (size_t)sent;
+    }
+    
+    output->start = 0;
+    output->length = 0;
+    return true;
+}
+
+static size_t pending_output(const connection_t* connection) {
+    return connection->output.length - connection->output.start;
+}
+
+/**
+ * Read everything available; false when the connection has failed
+ */
+static bool connection_read(connection_t* connection) {
+    while (!connection->read_closed && pending_output(connection) <= OUTPUT_HIGH_WATER) {
+        if (!buffer_reserve(&connection->input, READ_CHUNK)) return false;
+    
+        byte_buffer_t* input = &connection->input;
+        ssize_t received = recv(connection->fd, input->data + input->length,
+                                input->capacity - input->length, 0);
+        if (received == 0) {
+            connection->read_closed = true;
+            break;
+        }
+        if (received < 0) {
+            if (errno == EINTR) continue;
+            return errno == EAGAIN || errno == EWOULDBLOCK;
+        }
+        input->length += (size_t)received;
+    
+        if (!connection_process(connection)) return false;
+    }
+    return true;
+}
+
+/**
+ * Register interest in reads (unless the peer is done or too far behind)
+ * and in writes (while replies are pending)
+ */
+static void connection_update_events(int epoll_fd, connection_t* connection) {
+    uint32_t events = 0;
+    if (!connection->read_closed && pending_output(connection) <= OUTPUT_HIGH_WATER) {
+        events |= EPOLLIN;
+    }
+    if (pending_output(connection) > 0) events |= EPOLLOUT;
+    if (events == connection->events) return;
+    
+    struct epoll_event event;
+    event.events = events;
+    event.data.ptr = connection;
+    epoll_ctl(epoll_fd, EPOLL_CTL_MOD, connection->fd, &event);
+    connection->events = events;
+}
+
+// ============================================================================
+// SERVER LOOP
+// ============================================================================
+
+static int listen_on(const char* path) {
+    struct sockaddr_un address;
+    if (strlen(path) >= sizeof(address.sun_path)) {
+        fprintf(stderr, "Socket path too long: %s\n", path);
+        return -1;
+    }
+    
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        perror("socket");
+        return -1;
+    }
+    
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strcpy(address.sun_path, path);
+    unlink(path);
+    
+    if (bind(fd, (struct sockaddr*)&address, sizeof(address)) < 0 || listen(fd, SOMAXCONN) < 0) {
+        perror("bind/listen");
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static void print_usage(FILE* stream, const char* program) {
+    fprintf(stream, "Usage: %s [socket-path] [n-nodes] [memory-capacity]\n", program);
+    fprintf(stream, "  socket-path      Unix socket to listen on (default %s)\n",
+            DEFAULT_SOCKET_PATH);
+    fprintf(stream, "  n-nodes          Landscape nodes per connection (default %d)\n",
+            BRIDGE_DEFAULT_NODES);
+    fprintf(stream, "  memory-capacity  Working memory slots per connection (default %d)\n",
+            BRIDGE_DEFAULT_MEMORY);
+}
+
+/**
+ * Parse a decimal count argument; false unless the whole text is a number
+ */
+static bool parse_count(const char* text, size_t* out) {
+    if (text[0] < '0' || text[0] > '9') return false;
+    
+    char* end = NULL;
+    errno = 0;
+    unsigned long long value = strtoull(text, &end, 10);
+    if (errno != 0 || *end != '\0' || value > SIZE_MAX) return false;
+    *out = (size_t)value;
+    return true;
+}
+
+int main(int argc, char** argv) {
+    const char* path = DEFAULT_SOCKET_PATH;
+    size_t n_nodes = BRIDGE_DEFAULT_NODES;
+    size_t memory_capacity = BRIDGE_DEFAULT_MEMORY;
+    
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+            print_usage(stdout, argv[0]);
+            return 0;
+        }
+    }
+    if (argc > 4 || (argc > 1 && argv[1][0] == '-') ||
+        (argc > 2 && (!parse_count(argv[2], &n_nodes) || n_nodes == 0)) ||
+        (argc > 3 && !parse_count(argv[3], &memory_capacity))) {
+        print_usage(stderr, argv[0]);
+        return 2;
+    }
+    if (argc > 1) path = argv[1];
+    
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = on_signal;
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+    
+    int listen_fd = listen_on(path);
+    if (listen_fd < 0) return 1;
+    
+    int epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (epoll_fd < 0) {
+        perror("epoll_create1");
+        close(listen_fd);
+        unlink(path);
+        return 1;
+    }
+    
+    // The listening socket is tagged with a NULL pointer
+    struct epoll_event event;
+    event.events = EPOLLIN;
+    event.data.ptr = NULL;
+    epoll_ctl(epoll_fd, EPOLL_CTL_ADD, listen_fd, &event);
+    
+    printf("Neural-Symbolic Bridge server listening on %s\n", path);
+    printf("  %zu nodes, memory capacity %zu per connection\n", n_nodes, memory_capacity);
+    fflush(stdout);
+    
+    size_t n_connections = 0;
+    struct epoll_event events[MAX_EVENTS];
+    while (!stopping) {
+        int n_events = epoll_wait(epoll_fd, events, MAX_EVENTS, -1);
+        if (n_events < 0) {
+            if (errno == EINTR) continue;
+            perror("epoll_wait");
+            break;
+        }
+    
+        for (int i = 0; i < n_events; i++) {
+            connection_t* connection = (connection_t*)events[i].data.ptr;
+    
+            if (!connection) {
+                int client_fd;
+                while ((client_fd = accept4(listen_fd, NULL, NULL,
+                                            SOCK_NONBLOCK | SOCK_CLOEXEC)) >= 0) {
+                    connection_t* accepted = connection_create(client_fd, n_nodes, memory_capacity);
+                    if (!accepted) {
+                        close(client_fd);
+                        continue;
+                    }
+                    struct epoll_event client_event;
+                    client_event.events = EPOLLIN;
+                    client_event.data.ptr = accepted;
+                    accepted->events = EPOLLIN;
+                    epoll_ctl(epoll_fd, EPOLL_CTL_ADD, client_fd, &client_event);
+                    n_connections++;
+                }
+                continue;
+            }
+    
+            bool alive = !(events[i].events & EPOLLERR);
+            if (alive && (events[i].events & EPOLLOUT)) alive = connection_flush(connection);
+            if (alive && (events[i].events & (EPOLLIN | EPOLLHUP))) {
+                alive = connection_read(connection);
+            }
+            if (alive) alive = connection_flush(connection);
+            if (alive && connection->read_closed && pending_output(connection) == 0) {
+                alive = false;
+            }
+    
+            if (!alive) {
+                connection_close(epoll_fd, connection);
+                n_connections--;
+            } else {
+                connection_update_events(epoll_fd, connection);
+            }
+        }
+    }
+    
+    printf("Shutting down (%zu open connections)\n", n_connections);
+    while (connections) {
+        connection_close(epoll_fd, connections);
+    }
+    close(epoll_fd);
+    close(listen_fd);
+    unlink(path);
+    return 0;
+}
@@ -0,0 +1,44 @@
+;;; neural-pipeline.scm
+;;;
+;;; Symbolic pipeline over native tensors, for the embedded evaluator:
+;;;   ./build/neural_scheme examples/neural-pipeline.scm
+;;; Every neural call below passes tensor values directly; nothing is
+;;; serialized between the Scheme and C layers.
+
+(define (show label value)
+  (display label)
+  (display ": ")
+  (write value)
+  (newline))
+
+;; Tensors are first-class values
+(define weights (make-tensor '(2 2) '(0.5 -1 2 0.25)))
+(define input (make-tensor '(2 2) '(1 2 3 4)))
+
+(show "weights" weights)
+(show "matmul" (neural-compute 'matmul weights input))
+(show "relu(matmul)" (neural-compute 'relu (neural-compute 'matmul weights input)))
+
+;; Compose operations as ordinary procedures
+(define (layer w x) (neural-compute 'tanh (neural-compute 'matmul w x)))
+(define (stack n x)
+  (if (= n 0) x (stack (- n 1) (layer weights x))))
+
+(show "three layers" (tensor->list (stack 3 input)))
+
+;; Concepts round-trip through the encoder
+(define concepts '(cat dog mammal animal))
+(show "decoded" (map (lambda (c) (decode (encode c))) concepts))
+
+;; Spreading activation on the interpreter's cognitive context
+(define seed (make-tensor '(64) 0))
+(define active (spread-activation seed))
+(show "active after a quiet seed" (length active))
+(show "active after a strong seed" (length (spread-activation (make-tensor '(64) 0.9) 0.5)))
+(show "memory slot" (remember))
+(show "state shape" (tensor-shape (cognitive-state)))
+
+;; Text form compatibility with the bridge
+(define datum (tensor->datum weights))
+(show "datum" datum)
+(show "round trip" (equal? (datum->tensor datum) weights))
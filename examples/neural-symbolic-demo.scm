@@ -74,10 +74,12 @@
 (display "=== Demo 6: Attention Mechanism ===\n")
 (define concepts '(cat dog mammal))
 (define weights '(0.5 0.3 0.2))
-(define attention (attention-focus concepts weights))
+(define registration (register-concepts 0 'cat 'dog 'mammal))
+(define focus (attention-focus concepts weights))
 
+(display "Concept registration: ") (display registration) (newline)
 (display "Attention focus:\n")
-(display "  ") (display attention) (newline)
+(display "  ") (display focus) (newline)
 (newline)
 
 ;; Demo 7: Working memory
@@ -99,9 +101,10 @@
 (display "Symbolic form: ") (display symbolic-form) (newline)
 (display "Encoded for neural processing: ") (display encoded) (newline)
 
-;; Simulate neural computation
-(define neural-op (neural-compute 'matmul '(tensor1 tensor2)))
-(display "Neural computation request: ") (display neural-op) (newline)
+;; Neural computation on the encoded form
+(define neural-op (neural-compute 'add (list encoded encoded)))
+(display "Neural computation: ") (display neural-op) (newline)
+(display "Decoded back: ") (display (decode-neural-to-symbolic encoded)) (newline)
 (newline)
 
 ;; Demo 9: Complex reasoning
@@ -147,6 +150,15 @@
 (display "Spread pattern: ") (display spread) (newline)
 (newline)
 
+;; Under neural_scheme the interface runs on the native primitives; make sure
+;; it really produced tensors rather than command lists
+(cond-expand
+  (neural-scheme
+   (if (not (and (tensor? encoded) (tensor? neural-op) (tensor? focus)
+                 (string? (decode-neural-to-symbolic encoded))))
+       (error "neural-symbolic-demo: the neural interface did not produce tensors")))
+  (else #f))
+
 (display "╔═══════════════════════════════════════════════════════════════╗\n")
 (display "║                    Cognitive Layer Demo Complete              ║\n")
 (display "║                                                               ║\n")
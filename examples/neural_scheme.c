@@ -0,0 +1,75 @@
+/**
+ * neural_scheme.c
+ *
+ * In-process Scheme runner
+ * Evaluates Scheme files with the embedded evaluator against one cognitive
+ * context, so neural-compute, attention and spread-activation act on live
+ * tensors instead of going through the bridge's text or binary protocol.
+ *
+ * Usage: neural_scheme [file.scm ...]   (no files: read the program from stdin)
+ */
+
+#include "scheme_eval.h"
+#include "scheme_neural_bridge.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * Read all of stdin into a NUL-terminated buffer
+ */
+static char* read_stdin(size_t* length) {
+    size_t capacity = 4096;
+    char* text = (char*)malloc(capacity);
+    if (!text) return NULL;
+    
+    *length = 0;
+    size_t n;
+    while ((n = fread(text + *length, 1, capacity - *length - 1, stdin)) > 0) {
+        *length += n;
+        if (capacity - *length - 1 == 0) {
+            char* grown = (char*)realloc(text, capacity * 2);
+            if (!grown) {
+                free(text);
+                return NULL;
+            }
+            text = grown;
+            capacity *= 2;
+        }
+    }
+    text[*length] = '\0';
+    return text;
+}
+
+int main(int argc, char** argv) {
+    cognitive_context_t* context = cognitive_context_create(BRIDGE_DEFAULT_NODES,
+                                                            BRIDGE_DEFAULT_MEMORY);
+    scheme_interp_t* interp = context ? scheme_interp_create(context) : NULL;
+    if (!interp) {
+        fprintf(stderr, "Failed to create the interpreter\n");
+        cognitive_context_free(context);
+        return 1;
+    }
+    
+    int status = 0;
+    if (argc > 1) {
+        for (int i = 1; i < argc && status == 0; i++) {
+            if (!scheme_eval_file(interp, argv[i])) {
+                fprintf(stderr, "%s: %s\n", argv[i], scheme_interp_error(interp));
+                status = 1;
+            }
+        }
+    } else {
+        size_t length;
+        char* text = read_stdin(&length);
+        if (!text || !scheme_eval_source(interp, text, length)) {
+            fprintf(stderr, "stdin: %s\n", text ? scheme_interp_error(interp) : "out of memory");
+            status = 1;
+        }
+        free(text);
+    }
+    
+    scheme_interp_free(interp);
+    cognitive_context_free(context);
+    return status;
+}
@@ -6,11 +6,10 @@
  */
 
 #include "neural_physics.h"
+#include "scheme_neural_bridge.h"
 #include <stdio.h>
 #include <stdlib.h>
-
-// Forward declaration from bridge
-void demonstrate_symbiosis();
+#include <string.h>
 
 int main(int argc, char** argv) {
     printf("╔═══════════════════════════════════════════════════════════════╗\n");
@@ -148,6 +147,31 @@ int main(int argc, char** argv) {
         cognitive_context_free(context);
     }
     
+    // Example 5: The forms cognitive-grammar.scm builds, written out as an
+    // external Scheme would send them; every one must get a non-error reply
+    printf("\n\nExample 5: Cognitive Grammar Forms Through the Bridge\n");
+    int status = 1;
+    if (bridge_init() == 0) {
+        const char* grammar_forms =
+            "(register-concepts 0 cat dog mammal) "
+            "(encode (concept cat)) "
+            "(encode cat) "
+            "(encode \"dog\") "
+            "(neural-compute add ((ref 2) (ref 3))) "
+            "(decode (ref 4)) "
+            "(attention (cat dog mammal) (0.5 0.3 0.2)) "
+            "(spread (activation cat 0.8) 0.5)";
+        char* replies = bridge_process(grammar_forms);
+        printf("%s\n", replies ? replies : "(no reply)");
+        if (replies && !strstr(replies, "(error")) {
+            status = 0;
+        } else {
+            fprintf(stderr, "The bridge rejected a cognitive-grammar form\n");
+        }
+        free(replies);
+        bridge_shutdown();
+    }
+    
     printf("\n╔═══════════════════════════════════════════════════════════════╗\n");
     printf("║                    Demonstration Complete                     ║\n");
     printf("║                                                               ║\n");
@@ -158,5 +182,5 @@ int main(int argc, char** argv) {
     printf("║  • Unified mind-brain architecture                           ║\n");
     printf("╚═══════════════════════════════════════════════════════════════╝\n");
     
-    return 0;
+    return status;
 }
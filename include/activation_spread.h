@@ -0,0 +1,160 @@
+/**
+ * activation_spread.h
+ *
+ * Activation Spreading - batched and structured propagation
+ * Spreads many independent activation vectors over a shared connectivity
+ * in one pass, amortizing the connectivity traffic across queries.
+ */
+
+#ifndef ACTIVATION_SPREAD_H
+#define ACTIVATION_SPREAD_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include "neural_physics.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ============================================================================
+// BATCHED ACTIVATION SPREADING
+// ============================================================================
+
+/**
+ * Batch of independent activation queries over the same node set
+ * Row q of activations is the activation vector of query q.
+ */
+typedef struct {
+    neural_tensor_t* activations;   // [n_queries, n_nodes]
+    neural_tensor_t* spread_buffer; // [n_queries, n_nodes] GEMM output
+    float* decay;                   // Per-query decay factor
+    float* thresholds;              // Per-query activation threshold
+    size_t n_queries;
+    size_t n_nodes;
+} activation_batch_t;
+
+/**
+ * Create a batch of n_queries activation vectors over n_nodes nodes
+ */
+activation_batch_t* activation_batch_create(size_t n_queries, size_t n_nodes);
+
+/**
+ * Free an activation batch
+ */
+void activation_batch_free(activation_batch_t* batch);
+
+/**
+ * Seed query q with an activation vector and its decay/threshold
+ * A NULL seed clears the row.
+ */
+void activation_batch_set_query(activation_batch_t* batch, size_t query,
+                                const float* seed, float decay, float threshold);
+
+/**
+ * Spread all queries through a [n_nodes, n_nodes] connectivity matrix
+ * Computes activations = (activations * connectivity) scaled per query,
+ * as a single GEMM. Returns false on shape mismatch.
+ */
+bool activation_batch_spread(activation_batch_t* batch,
+                             const neural_tensor_t* connectivity);
+
+/**
+ * Get the nodes of query q above that query's threshold
+ * Returns a caller-owned array (NULL if none are active).
+ */
+size_t* activation_batch_get_active_nodes(const activation_batch_t* batch,
+                                          size_t query, size_t* n_active);
+
+// ============================================================================
+// STRUCTURED CONNECTIVITY OPERATORS
+// ============================================================================
+
+/**
+ * Kinds of implicit connectivity (never materialized as n x n)
+ */
+typedef enum {
+    CONNECTIVITY_IDENTITY_UNIFORM,  // diagonal on i == j, off_diagonal elsewhere
+    CONNECTIVITY_BANDED,            // non-zero only for |i - j| <= bandwidth
+    CONNECTIVITY_LOW_RANK,          // diag(d) + sum_t u_t v_t^T
+    CONNECTIVITY_BLOCK_DIAGONAL     // dense blocks of block_size on the diagonal
+} connectivity_kind_t;
+
+/**
+ * Implicit connectivity operator
+ * Applied like a connectivity matrix C in activation_landscape_spread:
+ * new_activations = activations * C.
+ */
+typedef struct {
+    connectivity_kind_t kind;
+    size_t n_nodes;
+
+    // CONNECTIVITY_IDENTITY_UNIFORM
+    float diagonal;
+    float off_diagonal;
+
+    // CONNECTIVITY_BANDED: band[i * (2 * bandwidth + 1) + bandwidth + (j - i)] = C[i, j]
+    size_t bandwidth;
+    float* band;
+
+    // CONNECTIVITY_LOW_RANK: diag [n_nodes], factors_u/factors_v [rank, n_nodes]
+    size_t rank;
+    float* diag;
+    float* factors_u;
+    float* factors_v;
+
+    // CONNECTIVITY_BLOCK_DIAGONAL: n_blocks dense [block_size, block_size] blocks,
+    // the last block covers the remaining nodes
+    size_t block_size;
+    size_t n_blocks;
+    float* blocks;
+} connectivity_op_t;
+
+/**
+ * Create an identity-plus-uniform operator (O(n) to apply)
+ */
+connectivity_op_t* connectivity_identity_uniform(size_t n_nodes, float diagonal,
+                                                 float off_diagonal);
+
+/**
+ * Create a zeroed banded operator (O(n * bandwidth) to apply)
+ */
+connectivity_op_t* connectivity_banded(size_t n_nodes, size_t bandwidth);
+
+/**
+ * Create a zeroed low-rank plus diagonal operator (O(n * rank) to apply)
+ */
+connectivity_op_t* connectivity_low_rank(size_t n_nodes, size_t rank);
+
+/**
+ * Create a zeroed block-diagonal operator (O(n * block_size) to apply)
+ */
+connectivity_op_t* connectivity_block_diagonal(size_t n_nodes, size_t block_size);
+
+/**
+ * Free a connectivity operator
+ */
+void connectivity_free(connectivity_op_t* op);
+
+/**
+ * Apply the operator: output = input * C (output must not alias input)
+ */
+void connectivity_apply(const connectivity_op_t* op, const float* input, float* output);
+
+/**
+ * Materialize the operator as a dense [n_nodes, n_nodes] tensor (for inspection)
+ */
+neural_tensor_t* connectivity_to_dense(const connectivity_op_t* op);
+
+/**
+ * Spread activation through an implicit connectivity operator
+ */
+void activation_landscape_spread_op(activation_landscape_t* landscape,
+                                    const connectivity_op_t* op,
+                                    float decay_factor);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ACTIVATION_SPREAD_H
@@ -0,0 +1,99 @@
+/**
+ * cognitive_batch.h
+ *
+ * Batched Cognitive Sessions
+ * Many independent sessions stored structure-of-arrays: every session's
+ * landscape and thresholds live in one contiguous row of shared arrays, so
+ * a step is one pass (or one GEMM) over all sessions instead of one call per
+ * context. Sessions are addressed by index.
+ */
+
+#ifndef COGNITIVE_BATCH_H
+#define COGNITIVE_BATCH_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include "neural_physics.h"
+#include "cognitive_pipeline.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Sessions x nodes state, row s belongs to session s
+ */
+typedef struct {
+    size_t n_sessions;
+    size_t n_nodes;
+    neural_tensor_t* activations;   // [n_sessions, n_nodes]
+    neural_tensor_t* stage;         // [n_sessions, n_nodes] input stage / GEMM input
+    float* thresholds;              // [n_sessions, n_nodes]
+    bool* is_active;                // [n_sessions, n_nodes]
+    size_t* n_active;               // [n_sessions]
+    cognitive_pipeline_config_t config;
+} cognitive_batch_t;
+
+/**
+ * Create n_sessions zeroed sessions of n_nodes (thresholds 0.5, default config)
+ */
+cognitive_batch_t* cognitive_batch_create(size_t n_sessions, size_t n_nodes);
+
+/**
+ * Free a session batch
+ */
+void cognitive_batch_free(cognitive_batch_t* batch);
+
+/**
+ * Set the step configuration shared by all sessions
+ * Attention is per context and not available here (attention_mix must be 0).
+ */
+bool cognitive_batch_configure(cognitive_batch_t* batch,
+                               const cognitive_pipeline_config_t* config);
+
+/**
+ * Activations of one session ([n_nodes], writable; call cognitive_batch_sync after writes)
+ */
+float* cognitive_batch_session(cognitive_batch_t* batch, size_t session);
+
+/**
+ * Thresholds of one session ([n_nodes], writable; call cognitive_batch_sync after writes)
+ */
+float* cognitive_batch_thresholds(cognitive_batch_t* batch, size_t session);
+
+/**
+ * Recompute every session's active set after direct writes
+ */
+void cognitive_batch_sync(cognitive_batch_t* batch);
+
+/**
+ * Step all sessions: input -> spread -> decay -> threshold
+ * inputs is [n_sessions, n_nodes] (NULL = no input). Sessions run in parallel;
+ * dense connectivity is one GEMM split by rows across the same chunks.
+ */
+bool cognitive_batch_step(cognitive_batch_t* batch, const float* inputs);
+
+/**
+ * Write up to max_nodes active node indices of a session into nodes
+ * Returns the session's total number of active nodes.
+ */
+size_t cognitive_batch_active_nodes(const cognitive_batch_t* batch, size_t session,
+                                    size_t* nodes, size_t max_nodes);
+
+/**
+ * Copy a context's landscape and thresholds into a session
+ */
+bool cognitive_batch_load(cognitive_batch_t* batch, size_t session,
+                          const cognitive_context_t* context);
+
+/**
+ * Copy a session back into a context's landscape and thresholds
+ */
+bool cognitive_batch_store(const cognitive_batch_t* batch, size_t session,
+                           cognitive_context_t* context);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // COGNITIVE_BATCH_H
@@ -0,0 +1,76 @@
+/**
+ * cognitive_pipeline.h
+ *
+ * Fused Cognitive Step
+ * Runs input -> spread -> attention -> threshold/active-set for a cognitive
+ * context in one call over buffers allocated once, so stepping in a tight
+ * event loop never touches the allocator.
+ */
+
+#ifndef COGNITIVE_PIPELINE_H
+#define COGNITIVE_PIPELINE_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include "neural_physics.h"
+#include "activation_spread.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Stages of the fused step
+ * The connectivity and operator are borrowed and must outlive the pipeline.
+ */
+typedef struct {
+    float input_gain;                       // Scale applied to the incoming input
+    float retention;                        // Share of the previous state kept (0 = replace)
+    const connectivity_op_t* connectivity_op;   // Structured spreading (preferred), or NULL
+    const neural_tensor_t* connectivity;    // Dense [n_nodes, n_nodes] spreading, or NULL
+    float decay_factor;                     // Applied after spreading
+    float attention_mix;                    // 0 = no attention stage, 1 = attention output only
+} cognitive_pipeline_config_t;
+
+/**
+ * Preallocated per-context buffers for the fused step
+ */
+typedef struct cognitive_pipeline {
+    cognitive_pipeline_config_t config;
+    neural_tensor_t* stage;             // [1, n_nodes] state after the input stage
+    neural_tensor_t* spread;            // [1, n_nodes] state after spreading
+    float* attended;                    // [n_nodes] attention output
+} cognitive_pipeline_t;
+
+/**
+ * Default configuration: replace the state with the input, no spreading,
+ * no attention (equivalent to cognitive_context_step)
+ */
+cognitive_pipeline_config_t cognitive_pipeline_default_config(void);
+
+/**
+ * Free pipeline buffers
+ */
+void cognitive_pipeline_free(cognitive_pipeline_t* pipeline);
+
+/**
+ * Configure the context's fused step, allocating its buffers once
+ * Reconfiguring reuses the buffers. Fails if the connectivity does not match
+ * n_nodes, or if attention is requested from a dense context without memory.
+ */
+bool cognitive_context_configure_pipeline(cognitive_context_t* context,
+                                          const cognitive_pipeline_config_t* config);
+
+/**
+ * Run the configured step for input [n_input] (n_input <= n_nodes)
+ * Missing input entries count as zero. The landscape, its active set and its
+ * threshold crossings are updated in place; nothing is allocated.
+ */
+bool cognitive_context_step_fused(cognitive_context_t* context,
+                                  const float* input, size_t n_input);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // COGNITIVE_PIPELINE_H
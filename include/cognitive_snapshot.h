@@ -0,0 +1,89 @@
+/**
+ * cognitive_snapshot.h
+ *
+ * Cognitive Context Snapshots
+ * Versioned binary snapshots of a cognitive context. Every array sits at an
+ * aligned offset in native float layout, so a restore maps the file and uses
+ * the landscape, attention weights and working memory in place.
+ */
+
+#ifndef COGNITIVE_SNAPSHOT_H
+#define COGNITIVE_SNAPSHOT_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "neural_physics.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define COGNITIVE_SNAPSHOT_MAGIC "NPCTXSNP"
+#define COGNITIVE_SNAPSHOT_VERSION 1
+#define COGNITIVE_SNAPSHOT_ALIGN 64
+#define COGNITIVE_SNAPSHOT_BYTE_ORDER 0x01020304u
+
+/**
+ * Arrays stored in a snapshot, in file order
+ */
+typedef enum {
+    SNAPSHOT_ACTIVATIONS,       // float [n_nodes]
+    SNAPSHOT_THRESHOLDS,        // float [n_nodes]
+    SNAPSHOT_ATTENTION_OUTPUT,  // float [dim_key, n_nodes] (DENSE)
+    SNAPSHOT_ATTENTION_QUERY,   // float [n_nodes, dim_key] (DENSE)
+    SNAPSHOT_ATTENTION_KEY,     // float [n_nodes, dim_key] (DENSE)
+    SNAPSHOT_ATTENTION_VALUE,   // float [n_nodes, dim_key] (DENSE)
+    SNAPSHOT_MEMORY_TIMESTAMPS, // uint64 [capacity]
+    SNAPSHOT_MEMORY_EMBEDDINGS, // float [capacity, n_nodes] (exact working memory)
+    SNAPSHOT_MEMORY_INV_NORMS,  // float [capacity] (exact working memory)
+    SNAPSHOT_MEMORY_CODES,      // uint8 [capacity, n_subspaces] (quantized working memory)
+    SNAPSHOT_MEMORY_CODEBOOKS,  // float [CENTROIDS * n_nodes] (quantized working memory)
+    SNAPSHOT_SECTION_COUNT
+} cognitive_snapshot_section_t;
+
+/**
+ * File header (offset 0); absent sections have size 0
+ */
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;        // COGNITIVE_SNAPSHOT_BYTE_ORDER as written by the host
+    uint64_t file_size;
+    uint64_t n_nodes;
+    uint64_t memory_capacity;
+    uint32_t attention_mode;
+    uint32_t n_heads;
+    uint64_t dim_key;
+    uint64_t n_features;        // LINEAR feature count
+    uint64_t generation;
+    uint64_t memory_length;
+    uint64_t memory_head;
+    uint64_t memory_clock;
+    uint64_t memory_subspaces;  // 0 = exact working memory
+    uint64_t memory_centroids;
+    struct {
+        uint64_t offset;
+        uint64_t size;          // Bytes
+    } sections[SNAPSHOT_SECTION_COUNT];
+} cognitive_snapshot_header_t;
+
+/**
+ * Write a snapshot of the context to path
+ * Attention history (KV cache / linear sums) and pipeline settings are not saved.
+ */
+bool cognitive_snapshot_save(const cognitive_context_t* context, const char* path);
+
+/**
+ * Restore a context from a snapshot by mapping it
+ * The mapping is private: later writes to the context never reach the file.
+ * The file is unmapped by cognitive_context_free. Returns NULL if the file is
+ * missing, truncated, from another version or written with another byte order.
+ */
+cognitive_context_t* cognitive_snapshot_load(const char* path);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // COGNITIVE_SNAPSHOT_H
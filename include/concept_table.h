@@ -0,0 +1,96 @@
+/**
+ * concept_table.h
+ *
+ * Concept Symbol Table
+ * Two-way mapping between concept names ('cat, 'animal) and activation
+ * landscape node indices. Names are interned once into stable storage and
+ * found through an open-addressing index, so name -> node is one hash probe
+ * and node -> name is an array load. Active-set queries hand back the
+ * interned names without scanning the table or allocating per entry.
+ */
+
+#ifndef CONCEPT_TABLE_H
+#define CONCEPT_TABLE_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "neural_physics.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct concept_arena concept_arena_t;
+
+/**
+ * Concept names for the nodes of one landscape
+ * Each node has at most one name and each name at most one node.
+ */
+typedef struct concept_table {
+    size_t n_nodes;
+    size_t n_concepts;          // Named nodes
+    const char** names;         // [n_nodes] interned name, NULL while unnamed
+    uint64_t* name_hashes;      // [n_nodes]
+    size_t* name_lengths;       // [n_nodes]
+    size_t* index;              // [index_capacity] node + 1, 0 = empty
+    size_t index_capacity;      // Power of two, at least twice n_nodes
+    concept_arena_t* arena;     // Name storage; interned names never move
+} concept_table_t;
+
+/**
+ * Create an empty table for n_nodes nodes
+ */
+concept_table_t* concept_table_create(size_t n_nodes);
+
+/**
+ * Free a table and its interned names
+ */
+void concept_table_free(concept_table_t* table);
+
+/**
+ * Name a node
+ * Re-registering an existing (name, node) pair succeeds; a name already on
+ * another node or a node already named differently fails.
+ */
+bool concept_table_register(concept_table_t* table, const char* name, size_t node);
+
+/**
+ * Name consecutive nodes: names[i] -> first_node + i
+ * All or nothing: every pair is checked as concept_table_register would
+ * (duplicates within names included) before any is registered.
+ */
+bool concept_table_register_all(concept_table_t* table, const char* const* names,
+                                size_t n_names, size_t first_node);
+
+/**
+ * Node of a name [length], or SIZE_MAX if unregistered
+ */
+size_t concept_table_find(const concept_table_t* table, const char* name, size_t length);
+
+/**
+ * Node of a NUL-terminated name, or SIZE_MAX if unregistered
+ */
+size_t concept_table_node(const concept_table_t* table, const char* name);
+
+/**
+ * Interned name of a node, or NULL if unnamed (valid until the table is freed)
+ */
+const char* concept_table_name(const concept_table_t* table, size_t node);
+
+/**
+ * Names of the landscape's active nodes, in active-set order
+ * names[i] is the interned name of the i-th active node, or NULL when that
+ * node is unnamed. Uses the incrementally maintained active set, so the cost
+ * is proportional to the number of active nodes. Returns the number written
+ * (at most capacity).
+ */
+size_t concept_table_active_names(const concept_table_t* table,
+                                  const activation_landscape_t* landscape,
+                                  const char** names, size_t capacity);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CONCEPT_TABLE_H
@@ -0,0 +1,366 @@
+/**
+ * neural_attention.h
+ *
+ * Attention Kernels
+ * Tiled (flash-style) scaled dot-product attention that streams key/value
+ * blocks with running softmax statistics, so the score matrix is never
+ * materialized.
+ */
+
+#ifndef NEURAL_ATTENTION_H
+#define NEURAL_ATTENTION_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "neural_physics.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ============================================================================
+// STRIDED VIEWS
+// ============================================================================
+
+/**
+ * Read-only strided matrix view
+ * Element (r, c) is data[r * row_stride + c * col_stride], so column slices
+ * (attention heads) and transposed layouts need no copies.
+ */
+typedef struct {
+    const float* data;
+    size_t rows;
+    size_t cols;
+    size_t row_stride;
+    size_t col_stride;
+} attention_view_t;
+
+/**
+ * View of a row-major 2-D tensor
+ */
+attention_view_t attention_view_of(const neural_tensor_t* tensor);
+
+/**
+ * View of columns [col_begin, col_begin + n_cols) of a row-major matrix
+ */
+attention_view_t attention_view_columns(const float* data, size_t rows, size_t ld,
+                                        size_t col_begin, size_t n_cols);
+
+// ============================================================================
+// TILED ATTENTION
+// ============================================================================
+
+/**
+ * Workspace (in floats) needed by attention_flash_kernel
+ */
+size_t attention_flash_workspace_size(size_t dim_key, size_t dim_value);
+
+/**
+ * Tiled attention on views: out = softmax(Q K^T / sqrt(d)) V, softmax per row
+ * Q is [n_q, d], K is [n_kv, d], V is [n_kv, d_v]; row i of the output is
+ * written to out + i * ld_out. Peak extra memory is the workspace, which is
+ * independent of the sequence length. A NULL workspace is allocated internally.
+ * Returns false on shape mismatch or allocation failure.
+ */
+bool attention_flash_kernel(const attention_view_t* query,
+                            const attention_view_t* key,
+                            const attention_view_t* value,
+                            float* out, size_t ld_out,
+                            float* workspace);
+
+/**
+ * Tiled attention on tensors: query [n, d], key [m, d], value [m, d_v]
+ * Returns a new [n, d_v] tensor. Query blocks run in parallel.
+ */
+neural_tensor_t* attention_flash(const neural_tensor_t* query,
+                                 const neural_tensor_t* key,
+                                 const neural_tensor_t* value);
+
+// ============================================================================
+// MASKED AND BLOCK-SPARSE ATTENTION
+// ============================================================================
+
+/**
+ * Which (query, key) pairs may attend
+ */
+typedef enum {
+    ATTENTION_MASK_NONE,            // Dense all-to-all
+    ATTENTION_MASK_CAUSAL,          // Query i attends to keys j <= i
+    ATTENTION_MASK_BOOLEAN,         // mask[i * n_kv + j] != 0
+    ATTENTION_MASK_BLOCK_SPARSE,    // mask[(i / block) * n_kv_blocks + j / block] != 0
+    ATTENTION_MASK_SLIDING_WINDOW   // |i - j| <= window, or i / j is one of n_global tokens
+} attention_mask_kind_t;
+
+/**
+ * Attention mask (rows are indexed by key count n_kv of the call)
+ * Query indices are offset by row_offset before the mask is consulted, so a
+ * chunk of queries (or a new query against a cached prefix) uses the same mask.
+ * Tiles without any allowed pair are skipped entirely; rows with no allowed
+ * key produce zeros.
+ */
+typedef struct {
+    attention_mask_kind_t kind;
+    const uint8_t* mask;            // BOOLEAN: [n_q, n_kv], BLOCK_SPARSE: block grid
+    size_t block_size;              // BLOCK_SPARSE block edge
+    size_t window;                  // SLIDING_WINDOW half-width
+    size_t n_global;                // SLIDING_WINDOW: positions [0, n_global) attend everywhere
+    size_t row_offset;
+    const uint8_t* tile_summary;    // BOOLEAN: attention_mask_summarize() result, or NULL
+} attention_mask_t;
+
+/**
+ * Per-tile summary of a boolean mask [n_q, n_kv]
+ * Classifies every query row against every key tile once, so the kernels
+ * decide which tiles to skip and which rows need per-entry checks without
+ * rescanning the mask. Store the result in tile_summary to reuse it across
+ * calls (attention_masked builds one per call otherwise). Caller frees.
+ */
+uint8_t* attention_mask_summarize(const uint8_t* mask, size_t n_q, size_t n_kv);
+
+/**
+ * Tiled attention restricted by a mask (NULL mask = dense)
+ */
+bool attention_flash_kernel_masked(const attention_view_t* query,
+                                   const attention_view_t* key,
+                                   const attention_view_t* value,
+                                   const attention_mask_t* mask,
+                                   float* out, size_t ld_out,
+                                   float* workspace);
+
+/**
+ * Masked attention on tensors: query [n, d], key [m, d], value [m, d_v]
+ */
+neural_tensor_t* attention_masked(const neural_tensor_t* query,
+                                  const neural_tensor_t* key,
+                                  const neural_tensor_t* value,
+                                  const attention_mask_t* mask);
+
+/**
+ * Sliding-window attention: query i attends keys within window positions of i
+ * The first n_global positions are global tokens: they attend to every key and
+ * every query attends to them. Tiles outside the band are skipped, so the cost
+ * is O(n * (window + n_global) * d) instead of O(n^2 * d).
+ */
+neural_tensor_t* attention_windowed(const neural_tensor_t* query,
+                                    const neural_tensor_t* key,
+                                    const neural_tensor_t* value,
+                                    size_t window, size_t n_global);
+
+// ============================================================================
+// KEY/VALUE CACHE
+// ============================================================================
+
+/**
+ * What an append does once the cache is full
+ */
+typedef enum {
+    ATTENTION_KV_REJECT,                // Append fails
+    ATTENTION_KV_EVICT_OLDEST,          // Overwrite the oldest entry (sliding window)
+    ATTENTION_KV_EVICT_LEAST_ATTENDED   // Overwrite the entry with the lowest mean attention
+                                        // (round-robin while nothing has been queried)
+} attention_kv_policy_t;
+
+/**
+ * Append-only key/value cache with preallocated capacity
+ * Slots are unordered; attention over the cache is order independent.
+ */
+typedef struct attention_kv_cache {
+    float* keys;                // [capacity, dim_key]
+    float* values;              // [capacity, dim_value]
+    float* attention_mass;      // Attention received per slot since insertion
+    size_t* inserted_at;        // Query count when the slot was written
+    size_t capacity;
+    size_t dim_key;
+    size_t dim_value;
+    size_t length;              // Occupied slots
+    size_t oldest;              // Next slot to overwrite in insertion order
+    size_t n_queries;           // Queries answered so far
+    attention_kv_policy_t policy;
+
+    // Scratch for incremental attention (no per-step allocation)
+    float* scores;              // [capacity]
+    float* query_row;           // [dim_key]
+    float* heads_row;           // [dim_value]
+} attention_kv_cache_t;
+
+/**
+ * Create a cache holding up to capacity key/value rows
+ */
+attention_kv_cache_t* attention_kv_cache_create(size_t capacity, size_t dim_key,
+                                                size_t dim_value,
+                                                attention_kv_policy_t policy);
+
+/**
+ * Free a key/value cache
+ */
+void attention_kv_cache_free(attention_kv_cache_t* cache);
+
+/**
+ * Drop all cached entries (capacity is kept)
+ */
+void attention_kv_cache_reset(attention_kv_cache_t* cache);
+
+/**
+ * Append one key/value row, evicting according to the policy when full
+ */
+bool attention_kv_cache_append(attention_kv_cache_t* cache,
+                               const float* key, const float* value);
+
+/**
+ * Attend one query row [dim_key] over the cached entries, writing [dim_value]
+ * Key and value columns are split evenly into n_heads heads. O(length * d).
+ */
+bool attention_kv_cache_attend(attention_kv_cache_t* cache, const float* query,
+                               size_t n_heads, float* out);
+
+/**
+ * Incremental multi-head attention for the newest input row
+ * Projects input [dim_model] with the state's Q/K/V, appends the new key and
+ * value, attends the new query over the cache and writes the output projection
+ * [dim_model] to output. The cache dimensions must match the state's dim_key.
+ */
+bool attention_incremental(const attention_state_t* state,
+                           attention_kv_cache_t* cache,
+                           const float* input, float* output);
+
+// ============================================================================
+// LINEAR (KERNELIZED) ATTENTION
+// ============================================================================
+
+/**
+ * Positive random feature map approximating the softmax kernel
+ * phi(x) = exp(W x' - |x'|^2 / 2) / sqrt(n_features), x' = x / dim^(1/4),
+ * so exp(q . k / sqrt(dim)) ~= phi(q) . phi(k).
+ */
+typedef struct attention_feature_map {
+    float* projection;          // [n_features, dim], standard normal
+    size_t n_features;
+    size_t dim;
+} attention_feature_map_t;
+
+/**
+ * Create a feature map with a deterministic seed
+ */
+attention_feature_map_t* attention_feature_map_create(size_t dim, size_t n_features,
+                                                      unsigned int seed);
+
+/**
+ * Free a feature map
+ */
+void attention_feature_map_free(attention_feature_map_t* map);
+
+/**
+ * Linear attention: query [n, dim], key [m, dim], value [m, d_v] -> [n, d_v]
+ * O((n + m) * n_features * (dim + d_v)) time, no n x m intermediate.
+ */
+neural_tensor_t* attention_linear(const attention_feature_map_t* map,
+                                  const neural_tensor_t* query,
+                                  const neural_tensor_t* key,
+                                  const neural_tensor_t* value);
+
+/**
+ * Relative Frobenius error of attention_linear against exact attention,
+ * measured on n_samples evenly spaced query rows (0 samples = all rows).
+ * Returns a negative value on error.
+ */
+float attention_linear_error(const attention_feature_map_t* map,
+                             const neural_tensor_t* query,
+                             const neural_tensor_t* key,
+                             const neural_tensor_t* value,
+                             size_t n_samples);
+
+/**
+ * Streaming linear attention state: running sum_j phi(k_j) v_j^T and sum_j phi(k_j)
+ * Each append/attend costs O(n_features * (dim + d_v)) regardless of history.
+ */
+typedef struct attention_linear_state {
+    const attention_feature_map_t* map;
+    float* kv_sum;              // [n_features, dim_value]
+    float* k_sum;               // [n_features]
+    float* features;            // Scratch [n_features]
+    float reference;            // Stabilizer shared by every accumulated key
+    size_t dim_value;
+    size_t length;
+} attention_linear_state_t;
+
+/**
+ * Create a streaming state over a feature map (the map must outlive it)
+ */
+attention_linear_state_t* attention_linear_state_create(const attention_feature_map_t* map,
+                                                        size_t dim_value);
+
+/**
+ * Free a streaming state
+ */
+void attention_linear_state_free(attention_linear_state_t* state);
+
+/**
+ * Accumulate one key [dim] / value [dim_value] pair
+ */
+bool attention_linear_state_append(attention_linear_state_t* state,
+                                   const float* key, const float* value);
+
+/**
+ * Attend one query [dim] over everything accumulated, writing [dim_value]
+ */
+bool attention_linear_state_attend(attention_linear_state_t* state,
+                                   const float* query, float* out);
+
+// ============================================================================
+// ATTENTION PLANS
+// ============================================================================
+
+/**
+ * Reusable attention plan keyed by (n_heads, dim_model, dim_key)
+ * Keeps the projection weights and scratch buffers alive between calls.
+ * Idle plans live in a small process-wide LRU cache.
+ */
+typedef struct attention_plan {
+    attention_state_t* state;   // Default weights for the key
+    size_t n_heads;
+    size_t dim_model;
+    size_t dim_key;
+    float* scratch;             // attention_multihead_into scratch
+    size_t scratch_rows;        // Rows the scratch is sized for
+    unsigned long last_used;    // LRU tick while idle in the cache
+} attention_plan_t;
+
+/**
+ * Take a plan for the key from the cache (or create one)
+ * The plan is exclusively the caller's until released.
+ */
+attention_plan_t* attention_plan_acquire(size_t n_heads, size_t dim_model, size_t dim_key);
+
+/**
+ * Return a plan to the cache (the least recently used idle plan may be freed)
+ */
+void attention_plan_release(attention_plan_t* plan);
+
+/**
+ * Run multi-head attention on input [n, dim_model] into a preallocated output
+ * A NULL state uses the plan's own weights; otherwise the state's weights are
+ * used and must have the plan's dimensions.
+ */
+bool attention_plan_execute_into(attention_plan_t* plan,
+                                 const attention_state_t* state,
+                                 const neural_tensor_t* input,
+                                 neural_tensor_t* output);
+
+/**
+ * Run multi-head attention and return a new [n, dim_model] tensor
+ */
+neural_tensor_t* attention_plan_execute(attention_plan_t* plan,
+                                        const attention_state_t* state,
+                                        const neural_tensor_t* input);
+
+/**
+ * Free every idle plan in the cache
+ */
+void attention_plan_cache_clear(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // NEURAL_ATTENTION_H
@@ -0,0 +1,50 @@
+/**
+ * neural_parallel.h
+ *
+ * Thread pool for the neural physics layer
+ * Runs independent tasks (attention heads, sessions, batch rows) across a
+ * persistent set of worker threads.
+ */
+
+#ifndef NEURAL_PARALLEL_H
+#define NEURAL_PARALLEL_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Task body: called once per task index in [0, n_tasks)
+ */
+typedef void (*neural_task_fn)(void* ctx, size_t task);
+
+/**
+ * Set the number of threads used by neural_parallel_for (including the caller)
+ * 0 selects the number of online processors. Takes effect on the next call.
+ */
+void neural_parallel_set_threads(size_t n_threads);
+
+/**
+ * Get the number of threads neural_parallel_for will use
+ */
+size_t neural_parallel_get_threads(void);
+
+/**
+ * Run fn(ctx, task) for every task in [0, n_tasks) and wait for completion
+ * Runs serially when the pool has one thread, when called from a worker,
+ * or while another caller is using the pool.
+ */
+void neural_parallel_for(size_t n_tasks, neural_task_fn fn, void* ctx);
+
+/**
+ * Stop and join the worker threads (the pool restarts lazily on next use)
+ */
+void neural_parallel_shutdown(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // NEURAL_PARALLEL_H
@@ -11,6 +11,7 @@
 
 #include <stddef.h>
 #include <stdbool.h>
+#include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -28,36 +29,98 @@ typedef struct {
     size_t* shape;
     size_t n_dims;
     size_t total_size;
+    bool owns_data;             // false: data is borrowed (e.g. a mapped snapshot)
 } neural_tensor_t;
 
+/**
+ * Threshold crossing event - a node that moved across its threshold
+ */
+typedef struct {
+    size_t node;
+    float activation;
+    bool rising;                // true: became active, false: became inactive
+} activation_crossing_t;
+
 /**
  * Activation landscape - represents the state of neural activation
+ *
+ * The active set (nodes above threshold) is maintained incrementally by every
+ * landscape write, and the crossings produced by the most recent write are
+ * kept in a compact list. Code that writes activations->data or thresholds
+ * directly must call activation_landscape_sync() afterwards.
+ * generation increases whenever a write changes an activation or threshold.
  */
 typedef struct {
     neural_tensor_t* activations;
     float* thresholds;
     size_t n_nodes;
+
+    bool* is_active;                    // Per-node membership in the active set
+    size_t* active_nodes;               // Active node indices, ascending
+    size_t n_active;
+    size_t* active_scratch;             // Rebuild buffer for partial writes
+    activation_crossing_t* crossings;   // Crossings from the most recent write
+    size_t n_crossings;
+    float* spread_buffer;               // Scratch output for spreading
+    uint64_t generation;                // Change counter
 } activation_landscape_t;
 
 /**
  * Attention mechanism state
+ * query/key/value project [n, dim_model] inputs to [n, dim_key]; the dim_key
+ * columns are split evenly across heads, and attention_weights projects the
+ * concatenated heads back to dim_model.
  */
 typedef struct {
-    neural_tensor_t* attention_weights;
-    neural_tensor_t* query;
-    neural_tensor_t* key;
-    neural_tensor_t* value;
+    neural_tensor_t* attention_weights; // Output projection [dim_key, dim_model]
+    neural_tensor_t* query;             // [dim_model, dim_key]
+    neural_tensor_t* key;               // [dim_model, dim_key]
+    neural_tensor_t* value;             // [dim_model, dim_key]
     size_t n_heads;
 } attention_state_t;
 
+struct attention_kv_cache;
+struct attention_feature_map;
+struct attention_linear_state;
+struct cognitive_pipeline;
+struct working_memory;
+
+/**
+ * How a cognitive context attends
+ */
+typedef enum {
+    COGNITIVE_ATTENTION_DENSE,      // Exact multi-head attention, O(n_nodes^2) weights
+    COGNITIVE_ATTENTION_LINEAR      // Random-feature linear attention, O(n_nodes * n_features)
+} cognitive_attention_mode_t;
+
+/**
+ * Borrowed read-only view of a context's state
+ * Points into the context; valid until the next write to its landscape.
+ */
+typedef struct {
+    const float* activations;           // [n_nodes]
+    const float* thresholds;            // [n_nodes]
+    const size_t* active_nodes;         // [n_active], ascending
+    size_t n_nodes;
+    size_t n_active;
+    uint64_t generation;                // Landscape change counter when viewed
+} cognitive_state_view_t;
+
 /**
  * Cognitive context - holds the complete neural state
  */
 typedef struct {
     activation_landscape_t* landscape;
-    attention_state_t* attention;
-    neural_tensor_t* working_memory;
+    cognitive_attention_mode_t attention_mode;
+    attention_state_t* attention;                       // DENSE only
+    struct attention_kv_cache* kv_cache;                // DENSE: keys/values of past steps (capacity entries)
+    struct attention_feature_map* feature_map;          // LINEAR only
+    struct attention_linear_state* linear_state;        // LINEAR: running sums over past steps
+    struct cognitive_pipeline* pipeline;                // Fused step buffers (see cognitive_pipeline.h)
+    struct working_memory* working_memory;              // capacity slots of n_nodes (see working_memory.h)
     size_t capacity;
+    void* mapping;                                      // Snapshot file backing the tensors, or NULL
+    size_t mapping_size;
 } cognitive_context_t;
 
 // ============================================================================
@@ -69,6 +132,12 @@ typedef struct {
  */
 neural_tensor_t* neural_tensor_create(const size_t* shape, size_t n_dims);
 
+/**
+ * Wrap existing data as a tensor without copying
+ * The data is borrowed: neural_tensor_free releases only the tensor itself.
+ */
+neural_tensor_t* neural_tensor_wrap(float* data, const size_t* shape, size_t n_dims);
+
 /**
  * Free tensor memory
  */
@@ -79,6 +148,13 @@ void neural_tensor_free(neural_tensor_t* tensor);
  */
 neural_tensor_t* neural_matmul(const neural_tensor_t* A, const neural_tensor_t* B);
 
+/**
+ * Matrix multiplication into a preallocated result: C = A * B
+ * Returns false if the shapes do not agree.
+ */
+bool neural_matmul_into(const neural_tensor_t* A, const neural_tensor_t* B,
+                        neural_tensor_t* C);
+
 /**
  * Element-wise operations
  */
@@ -121,16 +197,43 @@ void activation_landscape_spread(activation_landscape_t* landscape,
 
 /**
  * Get nodes above threshold
+ * Returns a caller-owned copy of the maintained active set.
  */
 size_t* activation_landscape_get_active_nodes(const activation_landscape_t* landscape,
                                               size_t* n_active);
 
+/**
+ * Borrow the maintained active set (ascending node indices)
+ * Valid until the next write to the landscape.
+ */
+const size_t* activation_landscape_active_set(const activation_landscape_t* landscape,
+                                              size_t* n_active);
+
+/**
+ * Borrow the threshold crossings produced by the most recent write
+ * Valid until the next write to the landscape.
+ */
+const activation_crossing_t* activation_landscape_crossings(const activation_landscape_t* landscape,
+                                                            size_t* n_crossings);
+
+/**
+ * Set the threshold of a single node, updating the active set
+ */
+void activation_landscape_set_threshold(activation_landscape_t* landscape,
+                                        size_t node, float threshold);
+
+/**
+ * Resynchronize the active set after direct writes to activations or thresholds
+ */
+void activation_landscape_sync(activation_landscape_t* landscape);
+
 // ============================================================================
 // ATTENTION MECHANISMS
 // ============================================================================
 
 /**
  * Create attention state
+ * Projections start as (truncated) identities.
  */
 attention_state_t* attention_create(size_t n_heads, size_t dim_model, size_t dim_key);
 
@@ -141,6 +244,8 @@ void attention_free(attention_state_t* attention);
 
 /**
  * Compute scaled dot-product attention
+ * query [n, d_k], key given as K^T [d_k, n_kv], value [n_kv, d_v]; the
+ * softmax is taken per query row and the score matrix is never materialized.
  */
 neural_tensor_t* attention_compute(const attention_state_t* state,
                                   const neural_tensor_t* query,
@@ -148,13 +253,30 @@ neural_tensor_t* attention_compute(const attention_state_t* state,
                                   const neural_tensor_t* value);
 
 /**
- * Multi-head attention
+ * Multi-head attention over input [n, dim_model]
+ * Projects with Q/K/V, runs each head on its column slice in parallel and
+ * concatenates the heads through the output projection.
  */
 neural_tensor_t* attention_multihead(const attention_state_t* state,
                                     const neural_tensor_t* input);
 
+/**
+ * Scratch (in floats) needed by attention_multihead_into for n_rows inputs
+ */
+size_t attention_multihead_scratch_size(const attention_state_t* state, size_t n_rows);
+
+/**
+ * Multi-head attention into a preallocated [n, dim_model] output
+ * Allocation free given attention_multihead_scratch_size() floats of scratch.
+ */
+bool attention_multihead_into(const attention_state_t* state,
+                              const neural_tensor_t* input,
+                              float* scratch,
+                              neural_tensor_t* output);
+
 /**
  * Self-attention mechanism
+ * Uses a cached attention plan for (n_heads, dim, dim).
  */
 neural_tensor_t* attention_self(const neural_tensor_t* input, size_t n_heads);
 
@@ -167,6 +289,17 @@ neural_tensor_t* attention_self(const neural_tensor_t* input, size_t n_heads);
  */
 cognitive_context_t* cognitive_context_create(size_t n_nodes, size_t memory_capacity);
 
+/**
+ * Create a cognitive context with an explicit attention mode
+ * COGNITIVE_ATTENTION_LINEAR never allocates n_nodes x n_nodes weights, so it
+ * scales to very large landscapes; n_features (0 = 64) trades memory and time
+ * for accuracy. cognitive_context_create is the DENSE mode.
+ */
+cognitive_context_t* cognitive_context_create_with_attention(size_t n_nodes,
+                                                             size_t memory_capacity,
+                                                             cognitive_attention_mode_t mode,
+                                                             size_t n_features);
+
 /**
  * Free cognitive context
  */
@@ -178,11 +311,64 @@ void cognitive_context_free(cognitive_context_t* context);
 void cognitive_context_step(cognitive_context_t* context,
                            const neural_tensor_t* input);
 
+/**
+ * Attend the current state against the keys/values of previous steps
+ * Appends the current state to the context KV cache (evicting the oldest
+ * entry when full) and writes the [n_nodes] attention output. O(capacity)
+ * per call instead of recomputing attention over the whole history.
+ */
+bool cognitive_context_attend(cognitive_context_t* context, float* output);
+
+/**
+ * Like cognitive_context_attend, for an explicit [n_nodes] state vector
+ */
+bool cognitive_context_attend_state(cognitive_context_t* context, const float* state,
+                                    float* output);
+
+/**
+ * Self-attention of input [n, n_nodes] under the context's attention mode
+ * Returns a new [n, n_nodes] tensor in either mode.
+ */
+neural_tensor_t* cognitive_context_attention(const cognitive_context_t* context,
+                                             const neural_tensor_t* input);
+
+/**
+ * Relative error of the context's attention against exact softmax attention
+ * on input, estimated from n_samples rows (0 for DENSE, negative on error)
+ */
+float cognitive_context_attention_error(const cognitive_context_t* context,
+                                        const neural_tensor_t* input,
+                                        size_t n_samples);
+
+/**
+ * Store the current state in working memory (overwriting the oldest slot)
+ * Returns the slot written, or SIZE_MAX without working memory.
+ */
+size_t cognitive_context_remember(cognitive_context_t* context);
+
 /**
  * Get the current state vector
+ * Allocates a copy; see cognitive_context_view_state / cognitive_context_copy_state.
  */
 neural_tensor_t* cognitive_context_get_state(const cognitive_context_t* context);
 
+/**
+ * Borrow the current state without copying (all fields zero for NULL)
+ */
+cognitive_state_view_t cognitive_context_view_state(const cognitive_context_t* context);
+
+/**
+ * Copy the current activations into out [capacity]
+ * Returns the number of floats written (n_nodes), or 0 if capacity is too small.
+ */
+size_t cognitive_context_copy_state(const cognitive_context_t* context, float* out,
+                                    size_t capacity);
+
+/**
+ * Change counter of the context state; unchanged means nothing to re-read
+ */
+uint64_t cognitive_context_generation(const cognitive_context_t* context);
+
 // ============================================================================
 // NEURAL-SYMBOLIC BRIDGE
 // ============================================================================
@@ -0,0 +1,256 @@
+/**
+ * scheme_eval.h
+ *
+ * Embedded Scheme Evaluator
+ * A small R7RS-subset interpreter that runs the Scheme cognitive layer inside
+ * the library. Tensors are first-class values and the neural operations are
+ * native primitives, so a symbolic pipeline drives the physics layer without
+ * serializing anything.
+ *
+ * Supported: lists, numbers (doubles), booleans, symbols, strings, lambda
+ * with rest parameters, define, set!, if, cond (with =>), let, let*, letrec,
+ * named let, begin, and, or, when, unless, quote, cond-expand (feature
+ * neural-scheme), proper tail calls and a non-moving mark-sweep collector
+ * over fixed-size cells.
+ * Not supported: quasiquote, macros, continuations, characters, vectors.
+ */
+
+#ifndef SCHEME_EVAL_H
+#define SCHEME_EVAL_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "neural_physics.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Deepest nesting of non-tail evaluations (and of the reader)
+#define SCHEME_MAX_DEPTH 2048
+
+// Longest error message kept by the interpreter
+#define SCHEME_ERROR_MAX 256
+
+// max_args of a primitive taking any number of arguments
+#define SCHEME_VARIADIC SIZE_MAX
+
+// ============================================================================
+// VALUES
+// ============================================================================
+
+/**
+ * Value types
+ */
+typedef enum {
+    SCHEME_NIL,
+    SCHEME_BOOLEAN,
+    SCHEME_NUMBER,
+    SCHEME_SYMBOL,
+    SCHEME_STRING,
+    SCHEME_PAIR,
+    SCHEME_CLOSURE,
+    SCHEME_PRIMITIVE,
+    SCHEME_TENSOR,
+    SCHEME_UNSPECIFIED,
+    SCHEME_FREE                 // Heap cell on the free list (never seen by callers)
+} scheme_type_t;
+
+typedef struct scheme_value scheme_value_t;
+typedef struct scheme_interp scheme_interp_t;
+
+/**
+ * Native procedure: args is the list of evaluated arguments, already checked
+ * against the arity. Returns the result, or NULL after scheme_fail().
+ */
+typedef scheme_value_t* (*scheme_primitive_fn)(scheme_interp_t* interp, scheme_value_t* args);
+
+/**
+ * Native procedure descriptor
+ */
+typedef struct {
+    const char* name;
+    scheme_primitive_fn fn;
+    size_t min_args;
+    size_t max_args;            // SCHEME_VARIADIC for no upper bound
+} scheme_primitive_t;
+
+/**
+ * Heap cell (32 bytes on LP64)
+ * Values are owned by the interpreter's collector. A value is kept alive by
+ * being reachable from a global binding, from the last result, or from a slot
+ * registered with scheme_protect().
+ */
+struct scheme_value {
+    uint8_t type;               // scheme_type_t
+    uint8_t marked;
+    uint8_t form;               // Symbols: special form id, 0 for ordinary symbols
+    union {
+        bool boolean;
+        double number;
+        struct {
+            scheme_value_t* car;
+            scheme_value_t* cdr;
+        } pair;
+        struct {
+            char* name;
+            scheme_value_t* global;     // Global binding, NULL while unbound
+        } symbol;
+        struct {
+            char* chars;                // NUL-terminated
+            size_t length;
+        } string;
+        struct {
+            scheme_value_t* params;
+            scheme_value_t* body;
+            scheme_value_t* env;
+        } closure;
+        const scheme_primitive_t* primitive;
+        neural_tensor_t* tensor;        // Owned; freed when the value is collected
+    } as;
+};
+
+/**
+ * Shared immutable values
+ */
+scheme_value_t* scheme_nil(void);
+scheme_value_t* scheme_boolean(bool value);
+scheme_value_t* scheme_unspecified(void);
+
+/**
+ * Allocate values; NULL (with the error set) when out of memory
+ * Allocation may run the collector, so values held in C variables across an
+ * allocation must be protected.
+ */
+scheme_value_t* scheme_make_number(scheme_interp_t* interp, double value);
+scheme_value_t* scheme_make_string(scheme_interp_t* interp, const char* chars, size_t length);
+scheme_value_t* scheme_cons(scheme_interp_t* interp, scheme_value_t* car, scheme_value_t* cdr);
+scheme_value_t* scheme_intern(scheme_interp_t* interp, const char* name);
+
+/**
+ * Wrap a tensor; the value takes ownership (the tensor is freed on failure)
+ */
+scheme_value_t* scheme_make_tensor(scheme_interp_t* interp, neural_tensor_t* tensor);
+
+/**
+ * Tensor held by a value, or NULL for any other type
+ */
+neural_tensor_t* scheme_value_tensor(const scheme_value_t* value);
+
+/**
+ * Everything except #f is true
+ */
+bool scheme_is_true(const scheme_value_t* value);
+
+/**
+ * Printed form: display (strings raw) or write (strings quoted)
+ * Tensors print as (tensor (shape ...) (data ...)). Caller frees. NULL when
+ * out of memory or the value is nested past SCHEME_MAX_DEPTH or circular.
+ */
+char* scheme_value_to_string(const scheme_value_t* value, bool display);
+
+// ============================================================================
+// INTERPRETER
+// ============================================================================
+
+/**
+ * Create an interpreter with every built-in and neural primitive defined
+ * The context is borrowed (it must outlive the interpreter) and is what
+ * attention, spread-activation, active-concepts, remember and
+ * cognitive-state operate on; NULL leaves those primitives failing.
+ */
+scheme_interp_t* scheme_interp_create(cognitive_context_t* context);
+
+/**
+ * Free an interpreter and every value it owns
+ */
+void scheme_interp_free(scheme_interp_t* interp);
+
+/**
+ * Where display, write and newline print (stdout by default)
+ */
+void scheme_interp_set_output(scheme_interp_t* interp, FILE* output);
+
+/**
+ * Evaluate every form of source text [length] at top level
+ * Returns the value of the last form; it stays valid until the next
+ * evaluation. NULL on error, see scheme_interp_error().
+ */
+scheme_value_t* scheme_eval_source(scheme_interp_t* interp, const char* text, size_t length);
+
+/**
+ * Evaluate every form of a file (what (load "path") does)
+ */
+scheme_value_t* scheme_eval_file(scheme_interp_t* interp, const char* path);
+
+/**
+ * Message describing the most recent failure ("" if none)
+ */
+const char* scheme_interp_error(const scheme_interp_t* interp);
+
+/**
+ * Record an error (printf-style) and return NULL, for use in primitives
+ * The first error of an evaluation wins.
+ */
+scheme_value_t* scheme_fail(scheme_interp_t* interp, const char* format, ...);
+
+/**
+ * Bind a global variable
+ */
+bool scheme_define(scheme_interp_t* interp, const char* name, scheme_value_t* value);
+
+/**
+ * Global binding of a name, or NULL if unbound
+ */
+scheme_value_t* scheme_lookup(scheme_interp_t* interp, const char* name);
+
+/**
+ * Register a native procedure (the descriptor must outlive the interpreter)
+ */
+bool scheme_define_primitive(scheme_interp_t* interp, const scheme_primitive_t* primitive);
+
+/**
+ * Call a procedure value on a list of arguments from C
+ */
+scheme_value_t* scheme_apply(scheme_interp_t* interp, scheme_value_t* procedure,
+                             scheme_value_t* args);
+
+// ============================================================================
+// GARBAGE COLLECTION
+// ============================================================================
+
+/**
+ * Keep the value in *slot alive (and track later stores to it) until
+ * unprotected. Slots are released in LIFO order.
+ */
+bool scheme_protect(scheme_interp_t* interp, scheme_value_t** slot);
+
+/**
+ * Release the count most recently protected slots
+ */
+void scheme_unprotect(scheme_interp_t* interp, size_t count);
+
+/**
+ * Run a full collection now
+ */
+void scheme_collect(scheme_interp_t* interp);
+
+/**
+ * Heap statistics
+ */
+typedef struct {
+    size_t n_cells;             // Cells in the heap
+    size_t n_free;              // Cells on the free list
+    size_t n_collections;
+    size_t tensor_bytes;        // Tensor data owned by values (as of the last collection + new)
+} scheme_heap_stats_t;
+
+scheme_heap_stats_t scheme_interp_stats(const scheme_interp_t* interp);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SCHEME_EVAL_H
@@ -0,0 +1,400 @@
+/**
+ * scheme_neural_bridge.h
+ *
+ * Scheme-Neural Bridge
+ * Moves tensors and commands between the Scheme cognitive layer (mind) and
+ * the C neural physics layer (brain).
+ *
+ * Text tensor format (debugging, interactive use):
+ *   (tensor (shape d1 d2 ...) (data v1 v2 ...))
+ * Binary tensor frames carry the same tensor as raw little-endian floats.
+ */
+
+#ifndef SCHEME_NEURAL_BRIDGE_H
+#define SCHEME_NEURAL_BRIDGE_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "neural_physics.h"
+#include "tensor_handles.h"
+#include "concept_table.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Largest tensor rank accepted by the text parser
+#define SCHEME_TENSOR_MAX_RANK 16
+
+// Longest text scheme_format_float produces
+#define SCHEME_FLOAT_MAX_CHARS 16
+
+// Binary tensor frames
+#define SCHEME_FRAME_MAGIC "NPTF"
+#define SCHEME_FRAME_VERSION 1
+#define SCHEME_FRAME_PREFIX_SIZE 8
+#define SCHEME_FRAME_HEADER_MAX (SCHEME_FRAME_PREFIX_SIZE + 8 * SCHEME_TENSOR_MAX_RANK)
+
+// ============================================================================
+// SYMBOLIC-NEURAL CONVERSION
+// ============================================================================
+
+/**
+ * Parse failure: byte offset into the input and a static description
+ */
+typedef struct {
+    size_t offset;
+    const char* message;
+} scheme_parse_error_t;
+
+/**
+ * Parse one (tensor (shape ...) (data ...)) expression from text [length]
+ * Leading whitespace and ; comments are skipped. The tensor is allocated once
+ * from the shape and filled in a single pass; the number of data values must
+ * equal the shape product. consumed (optional) receives the bytes read up to
+ * the closing parenthesis. On failure returns NULL and fills error (optional).
+ */
+neural_tensor_t* scheme_parse_tensor(const char* text, size_t length, size_t* consumed,
+                                     scheme_parse_error_t* error);
+
+/**
+ * Convert a Scheme tensor expression to a neural tensor (NULL on any error)
+ */
+neural_tensor_t* scheme_list_to_tensor(const char* scheme_list);
+
+/**
+ * Output sink for streaming serialization: returns false to abort
+ */
+typedef bool (*scheme_write_fn)(void* ctx, const char* bytes, size_t length);
+
+/**
+ * Format a float in its shortest form that reads back to the same value
+ * Finite values always carry a '.' or exponent (inexact in Scheme);
+ * non-finite values are written as +inf.0, -inf.0 and +nan.0. Writes at most
+ * SCHEME_FLOAT_MAX_CHARS bytes (no terminator) and returns the length.
+ */
+size_t scheme_format_float(float value, char* out);
+
+/**
+ * Stream the full tensor through a write callback in fixed-size chunks
+ * Returns false if the callback fails.
+ */
+bool scheme_write_tensor(const neural_tensor_t* tensor, scheme_write_fn write, void* ctx);
+
+/**
+ * Stream the full tensor to a FILE*
+ */
+bool scheme_write_tensor_file(const neural_tensor_t* tensor, FILE* stream);
+
+/**
+ * Write the full tensor into a caller buffer, snprintf style
+ * Returns the length of the complete text (excluding the terminator), which
+ * exceeds capacity - 1 when the output was cut short; SIZE_MAX on bad input.
+ */
+size_t scheme_format_tensor(const neural_tensor_t* tensor, char* buffer, size_t capacity);
+
+/**
+ * Convert neural tensor to Scheme list representation
+ * Returns the full, untruncated text in a caller-owned string.
+ */
+char* tensor_to_scheme_list(const neural_tensor_t* tensor);
+
+// ============================================================================
+// BINARY TENSOR FRAMES
+// ============================================================================
+
+/**
+ * Element types a frame can carry
+ */
+typedef enum {
+    SCHEME_DTYPE_FLOAT32 = 1
+} scheme_dtype_t;
+
+/*
+ * Frame layout (all integers little-endian):
+ *   0   magic "NPTF"
+ *   4   uint8  version
+ *   5   uint8  dtype
+ *   6   uint16 rank
+ *   8   uint64 shape[rank]
+ *   8 + 8 * rank   data, IEEE-754 little-endian, row-major
+ * The header is a multiple of 8 bytes, so data in an aligned buffer is aligned.
+ */
+
+/**
+ * Header bytes for a tensor of the given rank
+ */
+size_t scheme_frame_header_size(size_t n_dims);
+
+/**
+ * Total frame bytes for a tensor (0 if it cannot be framed)
+ */
+size_t scheme_frame_size(const neural_tensor_t* tensor);
+
+/**
+ * Write only the header (at most SCHEME_FRAME_HEADER_MAX bytes)
+ * On little-endian hosts tensor->data is the frame payload as-is, so a frame
+ * can be sent as header + data (e.g. with writev) without copying the values.
+ * Returns the header size, 0 on error.
+ */
+size_t scheme_encode_header(const neural_tensor_t* tensor, uint8_t* header);
+
+/**
+ * Write a complete frame into buffer [capacity]
+ * Returns the frame size, 0 if the buffer is too small or the tensor invalid.
+ */
+size_t scheme_encode_tensor(const neural_tensor_t* tensor, uint8_t* buffer, size_t capacity);
+
+/**
+ * Decode a frame into a new tensor (one copy of the data)
+ * consumed (optional) receives the frame size. NULL if the frame is invalid
+ * or truncated.
+ */
+neural_tensor_t* scheme_decode_tensor(const uint8_t* frame, size_t length, size_t* consumed);
+
+/**
+ * Zero-copy decode: a tensor whose data points into the frame
+ * The frame must outlive the tensor and must not be written through it.
+ * Returns NULL on big-endian hosts or when the data is not float aligned;
+ * use scheme_decode_tensor then.
+ */
+neural_tensor_t* scheme_view_tensor(const uint8_t* frame, size_t length, size_t* consumed);
+
+// ============================================================================
+// SCHEME CALLABLE FUNCTIONS
+// ============================================================================
+
+/**
+ * Create a cognitive context from Scheme
+ */
+cognitive_context_t* scheme_create_context(size_t n_nodes, size_t memory_capacity);
+
+/**
+ * Execute neural operation from Scheme command
+ */
+char* scheme_neural_compute(const char* operation, const char** symbolic_inputs, size_t n_inputs);
+
+/**
+ * Execute neural operation on binary frames, returning a new frame
+ * Inputs are used in place where possible. The caller frees the result;
+ * its size is written to out_size.
+ */
+uint8_t* scheme_neural_compute_binary(const char* operation, const uint8_t* const* frames,
+                                      const size_t* frame_sizes, size_t n_inputs,
+                                      size_t* out_size);
+
+/**
+ * Parse a text tensor and keep it resident; returns its handle
+ */
+tensor_handle_t scheme_tensor_load(tensor_handle_table_t* table, const char* scheme_list);
+
+/**
+ * Decode a binary frame and keep it resident; returns its handle
+ */
+tensor_handle_t scheme_tensor_load_frame(tensor_handle_table_t* table,
+                                         const uint8_t* frame, size_t length);
+
+/**
+ * Text form of a resident tensor (caller frees; NULL if the handle is stale)
+ */
+char* scheme_tensor_show(const tensor_handle_table_t* table, tensor_handle_t handle);
+
+/**
+ * Binary frame of a resident tensor (caller frees; NULL if the handle is stale)
+ */
+uint8_t* scheme_tensor_frame(const tensor_handle_table_t* table, tensor_handle_t handle,
+                             size_t* size);
+
+/**
+ * Execute neural operation on resident tensors, keeping the result resident
+ * Nothing is serialized; chained ops pass handles. Returns the result's
+ * handle, TENSOR_HANDLE_NULL if an input is stale or the op fails.
+ */
+tensor_handle_t scheme_neural_compute_handles(tensor_handle_table_t* table,
+                                              const char* operation,
+                                              const tensor_handle_t* inputs,
+                                              size_t n_inputs);
+
+/**
+ * Spread activation from Scheme
+ */
+void scheme_spread_activation(cognitive_context_t* context, float decay_factor);
+
+/**
+ * Spread from an activation pattern: set node to strength, spread with
+ * BRIDGE_DEFAULT_DECAY, then write the nodes whose activation exceeds
+ * threshold into above [n_nodes]
+ * Returns how many were written; SIZE_MAX if node is out of range or on
+ * allocation failure.
+ */
+size_t scheme_spread_pattern(cognitive_context_t* context, size_t node, float strength,
+                             float threshold, size_t* above);
+
+/**
+ * Attention focused on concepts: a [1, n_nodes] query holding weights[i] at
+ * nodes[i] (repeated nodes add up) through the context's attention
+ * Returns NULL if a node is out of range or on allocation failure.
+ */
+neural_tensor_t* scheme_attend_concepts(cognitive_context_t* context, const size_t* nodes,
+                                        const float* weights, size_t n);
+
+/**
+ * Get active concepts from activation landscape
+ */
+char* scheme_get_active_concepts(cognitive_context_t* context);
+
+/**
+ * Active concepts by name: (active-concepts cat animal 17 ...)
+ * Named nodes print their interned name, unnamed ones their index. One
+ * output allocation, no per-entry strings.
+ */
+char* scheme_get_active_concept_names(cognitive_context_t* context,
+                                      const concept_table_t* concepts);
+
+/**
+ * Apply attention mechanism from Scheme
+ */
+char* scheme_apply_attention(cognitive_context_t* context, const char* input_repr);
+
+// ============================================================================
+// MAIN BRIDGE INTERFACE
+// ============================================================================
+
+// Node count and memory capacity of the session behind bridge_process
+#define BRIDGE_DEFAULT_NODES 64
+#define BRIDGE_DEFAULT_MEMORY 16
+
+// Decay used by spread-activation when none is given
+#define BRIDGE_DEFAULT_DECAY 0.8f
+
+// Longest concept name accepted by register-concepts
+#define BRIDGE_CONCEPT_MAX 128
+
+/**
+ * Shared state for a stream of commands: one cognitive context, the
+ * resident tensors commands create and the names of the context's nodes
+ */
+typedef struct bridge_session {
+    cognitive_context_t* context;
+    tensor_handle_table_t* tensors;
+    concept_table_t* concepts;
+} bridge_session_t;
+
+/**
+ * Create a session over a fresh cognitive context
+ */
+bridge_session_t* bridge_session_create(size_t n_nodes, size_t memory_capacity);
+
+/**
+ * Free a session, its context and every resident tensor
+ */
+void bridge_session_free(bridge_session_t* session);
+
+/**
+ * Execute a batch of commands [length] in order against the session
+ *
+ * Commands (the cognitive-grammar.scm vocabulary):
+ *   (neural-compute op operand ...)    -> (handle N)
+ *   (encode operand)                   -> (handle N)
+ *   (encode form)                      -> (handle N)
+ *   (decode operand)                   -> (tensor (shape ...) (data ...))
+ *   (attention operand)                -> (handle N)
+ *   (attention (name ...) (weight ...)) -> (handle N)
+ *   (spread-activation [seed] [decay]) -> (active-concepts i ...)
+ *   (spread (activation name strength) threshold) -> (active-concepts i ...)
+ *   (active-concepts)                  -> (active-concepts i ...)
+ *   (register-concepts node name ...)  -> (registered n)
+ *   (release operand)                  -> (released)
+ * neural-compute also takes its operands as one list, (op (operand ...)).
+ * encode of a symbol, string or any other non-operand datum encodes its text
+ * (encode_symbolic). attention with two lists focuses on registered concepts
+ * (scheme_attend_concepts); spread seeds one and reports the nodes above
+ * threshold (scheme_spread_pattern).
+ * register-concepts names consecutive nodes from node on; active nodes with
+ * a name are then reported by name instead of index.
+ * An operand is an inline (tensor ...), a resident (handle N), or (ref K),
+ * the tensor produced by command K (0-based) earlier in the same batch.
+ * Results stay resident until released. The reply is
+ * (results r0 r1 ...), one per command; a failed command replies
+ * (error "message" offset) and the batch continues with the next command.
+ * Returns a caller-owned string, NULL on allocation failure.
+ */
+char* bridge_session_process(bridge_session_t* session, const char* commands, size_t length);
+
+/**
+ * Initialize the neural-symbolic bridge (creates the default session)
+ */
+int bridge_init(void);
+
+/**
+ * Shutdown the bridge (frees the default session)
+ */
+void bridge_shutdown(void);
+
+/**
+ * Process Scheme commands against the default session
+ * NULL until bridge_init has been called.
+ */
+char* bridge_process(const char* scheme_command);
+
+// ============================================================================
+// BRIDGE MESSAGES
+// ============================================================================
+
+/*
+ * Length-prefixed messages for carrying the bridge over a byte stream.
+ * Header (8 bytes): uint32 LE payload length, uint8 type, uint8 version,
+ * two zero bytes. Frames in a payload that starts 8-byte aligned are float
+ * aligned and are used in place. Each request gets exactly one reply, in
+ * request order, so requests can be pipelined.
+ */
+#define BRIDGE_MESSAGE_HEADER_SIZE 8
+#define BRIDGE_MESSAGE_VERSION 1
+#define BRIDGE_MESSAGE_MAX (256u << 20)
+
+/**
+ * Message types (a reply carries the request's type, or ERROR)
+ */
+typedef enum {
+    BRIDGE_MESSAGE_COMMANDS = 1,    // Command batch text -> (results ...) text
+    BRIDGE_MESSAGE_PUT_TENSOR = 2,  // Tensor frame -> uint64 LE handle
+    BRIDGE_MESSAGE_GET_TENSOR = 3,  // uint64 LE handle -> tensor frame
+    BRIDGE_MESSAGE_COMPUTE = 4,     // u8 name length, name, pad to 8, frames -> frame
+    BRIDGE_MESSAGE_ERROR = 127      // Reply only: error text
+} bridge_message_type_t;
+
+/**
+ * Write a message header for a payload of length bytes
+ */
+void bridge_message_header(uint8_t* header, uint8_t type, size_t length);
+
+/**
+ * Read a message header; false on a version mismatch or oversized payload
+ */
+bool bridge_message_parse_header(const uint8_t* header, uint8_t* type, size_t* length);
+
+/**
+ * Handle one message against the session
+ * Returns the reply payload (caller frees) with its type and length;
+ * NULL only on allocation failure.
+ */
+uint8_t* bridge_session_message(bridge_session_t* session, uint8_t type,
+                                const uint8_t* payload, size_t length,
+                                uint8_t* reply_type, size_t* reply_length);
+
+// ============================================================================
+// DEMONSTRATION FUNCTION
+// ============================================================================
+
+/**
+ * Walk through the bridge end to end (prints to stdout)
+ */
+void demonstrate_symbiosis(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SCHEME_NEURAL_BRIDGE_H
@@ -0,0 +1,167 @@
+/**
+ * symbol_embedding.h
+ *
+ * Symbol Embeddings
+ * Fixed-dimension hashed n-gram encoder for symbolic strings. Every token and
+ * every character n-gram of a token selects signed rows of a seeded random
+ * codebook; the rows are summed and unit-normalized. Encodings therefore have
+ * the same width whatever the string length, and strings sharing fragments
+ * ("mammal", "mammals") have high cosine similarity. An LRU cache keyed by
+ * the string makes repeated concepts O(1).
+ *
+ * encode_symbolic stays the reversible one-float-per-character codec used by
+ * decode_neural; this encoder is one-way.
+ */
+
+#ifndef SYMBOL_EMBEDDING_H
+#define SYMBOL_EMBEDDING_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "neural_physics.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Longest character n-gram an encoder may use
+#define SYMBOL_EMBEDDING_MAX_GRAM 8
+
+// ============================================================================
+// ENCODER
+// ============================================================================
+
+/**
+ * Encoder parameters
+ * Tokens are maximal runs of letters and digits, compared case-insensitively.
+ * N-grams are taken over the token wrapped in '<' '>' boundary markers.
+ */
+typedef struct {
+    size_t dim;                 // Embedding width
+    size_t min_gram;            // Shortest character n-gram
+    size_t max_gram;            // Longest character n-gram (<= SYMBOL_EMBEDDING_MAX_GRAM)
+    float token_weight;         // Weight of a whole-token feature (n-grams weigh 1)
+    size_t n_buckets;           // Codebook rows that features hash into
+    size_t cache_capacity;      // Encodings kept in the LRU cache (0 = no cache)
+    uint64_t seed;              // Codebook seed
+} symbol_encoder_config_t;
+
+/**
+ * Hashed n-gram encoder with an LRU cache of finished encodings
+ * The cache is a fixed pool of entries indexed by an open-addressing table,
+ * so a hit costs one hash and one probe sequence and never allocates.
+ */
+typedef struct symbol_encoder {
+    symbol_encoder_config_t config;
+    float* codebook;            // [n_buckets, dim], entries +-1/sqrt(dim)
+    float* scratch;             // [dim] result buffer when the cache is disabled
+
+    // LRU cache
+    char** keys;                // [cache_capacity] owned copies, NULL while unused
+    uint64_t* key_hashes;       // [cache_capacity]
+    float* rows;                // [cache_capacity, dim]
+    size_t* newer;              // [cache_capacity] recency links, SIZE_MAX ends a chain
+    size_t* older;              // [cache_capacity]
+    size_t* index;              // [index_capacity] entry + 1, 0 = empty
+    size_t index_capacity;      // Power of two, at least twice cache_capacity
+    size_t n_cached;
+    size_t most_recent;
+    size_t least_recent;
+    size_t hits;
+    size_t misses;
+} symbol_encoder_t;
+
+/**
+ * Default parameters for a dim-wide encoder: 3- to 5-grams, token weight 2,
+ * 4096 buckets, 1024 cached encodings
+ */
+symbol_encoder_config_t symbol_encoder_default_config(size_t dim);
+
+/**
+ * Create an encoder (NULL config = defaults for 64 dimensions)
+ */
+symbol_encoder_t* symbol_encoder_create(const symbol_encoder_config_t* config);
+
+/**
+ * Free an encoder and its cache
+ */
+void symbol_encoder_free(symbol_encoder_t* encoder);
+
+/**
+ * Encode text [length] into out [dim] without touching the cache
+ * Only reads the encoder, so any number of threads may call it at once.
+ * Text without letters or digits encodes as the zero vector.
+ */
+bool symbol_embedding_compute(const symbol_encoder_t* encoder,
+                              const char* text, size_t length, float* out);
+
+/**
+ * Encoding of a NUL-terminated string through the cache
+ * The returned row belongs to the encoder and stays valid until the next
+ * lookup or encode call. NULL on error.
+ */
+const float* symbol_encoder_lookup(symbol_encoder_t* encoder, const char* text);
+
+/**
+ * Write the encoding of text into out [dim] (a landscape or memory slot)
+ */
+bool symbol_encoder_encode_into(symbol_encoder_t* encoder, const char* text, float* out);
+
+/**
+ * Encoding of text as a new [dim] tensor
+ */
+neural_tensor_t* symbol_encoder_encode(symbol_encoder_t* encoder, const char* text);
+
+/**
+ * Drop every cached encoding (hit/miss counters are kept)
+ */
+void symbol_encoder_clear_cache(symbol_encoder_t* encoder);
+
+/**
+ * Cosine similarity of two embeddings [dim] (0 if either is zero)
+ */
+float symbol_embedding_cosine(const float* a, const float* b, size_t dim);
+
+// ============================================================================
+// BATCH ENCODING
+// ============================================================================
+
+/**
+ * Encode n_texts strings into the rows of a preallocated [n_texts, dim] tensor
+ * Cache hits are copied; misses are computed in parallel across the thread
+ * pool and then cached. The rows are ready for attention_compute or
+ * cognitive_context_attention as they are. NULL entries encode as "".
+ */
+bool symbol_encoder_encode_batch_into(symbol_encoder_t* encoder, const char* const* texts,
+                                      size_t n_texts, neural_tensor_t* out);
+
+/**
+ * Encode n_texts strings into a new [n_texts, dim] tensor
+ */
+neural_tensor_t* symbol_encoder_encode_batch(symbol_encoder_t* encoder,
+                                             const char* const* texts, size_t n_texts);
+
+/**
+ * Which part of an over-long string the character encoding keeps
+ */
+typedef enum {
+    SYMBOL_TRUNCATE_END,        // Keep the first width characters
+    SYMBOL_TRUNCATE_START       // Keep the last width characters
+} symbol_truncation_t;
+
+/**
+ * Character codes of n_texts strings (encode_symbolic's c / 255, so
+ * decode_neural reads a row back) into a preallocated [n_texts, width]
+ * tensor, rows in parallel. Shorter strings are padded with pad_value and
+ * longer ones truncated. NULL entries are all padding.
+ */
+bool symbol_encode_characters_batch_into(const char* const* texts, size_t n_texts,
+                                         float pad_value, symbol_truncation_t truncation,
+                                         neural_tensor_t* out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SYMBOL_EMBEDDING_H
@@ -0,0 +1,97 @@
+/**
+ * tensor_handles.h
+ *
+ * Tensor Handle Table
+ * Generation-checked slot map that keeps tensors resident on the C side and
+ * hands out small integer handles, so Scheme can chain operations without
+ * serializing intermediates. A released slot bumps its generation, which
+ * makes every outstanding handle to it stale rather than dangling.
+ */
+
+#ifndef TENSOR_HANDLES_H
+#define TENSOR_HANDLES_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "neural_physics.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Handle = generation << 32 | slot; generations stay below 2^28 so handles
+// fit a 62-bit Scheme fixnum
+#define TENSOR_HANDLE_GENERATION_BITS 28
+
+/**
+ * Tensor handle (0 is never a valid handle)
+ */
+typedef uint64_t tensor_handle_t;
+
+#define TENSOR_HANDLE_NULL ((tensor_handle_t)0)
+
+/**
+ * One slot of the table
+ */
+typedef struct {
+    neural_tensor_t* tensor;    // NULL while the slot is free
+    uint32_t generation;        // Bumped on every release
+    uint32_t next_free;         // Free-list link (valid while free)
+} tensor_handle_slot_t;
+
+/**
+ * Slot map of owned tensors
+ * Slots are reused through a free list; the slot array grows by doubling and
+ * handles stay valid across growth.
+ */
+typedef struct tensor_handle_table {
+    tensor_handle_slot_t* slots;
+    size_t capacity;
+    size_t length;              // Slots ever used (free or live)
+    size_t count;               // Live tensors
+    uint32_t free_head;         // First free slot, UINT32_MAX if none
+} tensor_handle_table_t;
+
+/**
+ * Create a table with room for initial_capacity tensors before growing
+ */
+tensor_handle_table_t* tensor_handle_table_create(size_t initial_capacity);
+
+/**
+ * Free the table and every tensor it still holds
+ */
+void tensor_handle_table_free(tensor_handle_table_t* table);
+
+/**
+ * Release every tensor (outstanding handles become stale)
+ */
+void tensor_handle_table_clear(tensor_handle_table_t* table);
+
+/**
+ * Take ownership of a tensor and return its handle
+ * Returns TENSOR_HANDLE_NULL on failure, in which case the caller keeps the tensor.
+ */
+tensor_handle_t tensor_handle_insert(tensor_handle_table_t* table, neural_tensor_t* tensor);
+
+/**
+ * Look up a handle (NULL if it is stale or was never issued)
+ * The tensor stays owned by the table.
+ */
+neural_tensor_t* tensor_handle_get(const tensor_handle_table_t* table, tensor_handle_t handle);
+
+/**
+ * Remove a tensor from the table without freeing it (NULL if stale)
+ */
+neural_tensor_t* tensor_handle_take(tensor_handle_table_t* table, tensor_handle_t handle);
+
+/**
+ * Release and free the tensor behind a handle; false if the handle is stale
+ */
+bool tensor_handle_release(tensor_handle_table_t* table, tensor_handle_t handle);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TENSOR_HANDLES_H
@@ -0,0 +1,110 @@
+/**
+ * working_memory.h
+ *
+ * Working Memory
+ * Fixed-capacity ring of embedding slots with recency timestamps and top-k
+ * cosine retrieval. Large memories can be product-quantized: each slot is
+ * stored as one byte per subspace and scored through per-query lookup tables.
+ */
+
+#ifndef WORKING_MEMORY_H
+#define WORKING_MEMORY_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Centroids per product-quantization subspace (one byte per code)
+#define WORKING_MEMORY_PQ_CENTROIDS 256
+
+/**
+ * Ring of embedding slots
+ * Once full, each store overwrites the oldest slot.
+ */
+typedef struct working_memory {
+    size_t capacity;
+    size_t dim;
+    size_t length;              // Occupied slots
+    size_t head;                // Next slot to write
+    uint64_t clock;             // Stores so far; slot timestamps come from it
+    uint64_t* timestamps;       // [capacity]
+
+    // Exact mode
+    float* embeddings;          // [capacity, dim] (NULL once quantized)
+    bool owns_embeddings;       // false: embeddings are borrowed (mapped snapshot)
+    float* inv_norms;           // [capacity] 1 / |embedding| (0 for zero vectors)
+
+    // Product-quantized mode (embeddings are unit-normalized before encoding)
+    bool quantized;
+    size_t n_subspaces;
+    size_t n_centroids;         // Trained centroids per subspace (<= CENTROIDS)
+    uint8_t* codes;             // [capacity, n_subspaces]
+    float* codebooks;           // Subspace m at codebooks + CENTROIDS * begin_m
+
+    // Retrieval scratch
+    float* scores;              // [capacity]
+    float* query_unit;          // [dim]
+    float* lut;                 // [n_subspaces, CENTROIDS]
+} working_memory_t;
+
+/**
+ * One retrieval result
+ */
+typedef struct {
+    size_t slot;
+    float similarity;           // Cosine (approximate when quantized)
+    uint64_t timestamp;         // Store count when the slot was written
+} working_memory_match_t;
+
+/**
+ * Create an empty working memory of capacity slots of dim floats
+ */
+working_memory_t* working_memory_create(size_t capacity, size_t dim);
+
+/**
+ * Free a working memory
+ */
+void working_memory_free(working_memory_t* memory);
+
+/**
+ * Forget every slot (capacity and quantizer are kept)
+ */
+void working_memory_clear(working_memory_t* memory);
+
+/**
+ * Store an embedding [dim], overwriting the oldest slot when full
+ * Returns the slot written, or SIZE_MAX on error.
+ */
+size_t working_memory_store(working_memory_t* memory, const float* embedding);
+
+/**
+ * Read slot back into out [dim] (decoded and unit-length when quantized)
+ */
+bool working_memory_get(const working_memory_t* memory, size_t slot, float* out);
+
+/**
+ * Top-k slots by cosine similarity to query [dim], best first
+ * Ties prefer the more recent slot. Returns the number of matches written
+ * (min(k, length)).
+ */
+size_t working_memory_retrieve(working_memory_t* memory, const float* query, size_t k,
+                               working_memory_match_t* matches);
+
+/**
+ * Switch to product-quantized storage with n_subspaces byte codes per slot
+ * Codebooks are trained by k-means on samples [n_samples, dim], or on the
+ * stored slots when samples is NULL; stored slots are re-encoded and the
+ * exact embeddings are released. n_subspaces must not exceed dim.
+ */
+bool working_memory_quantize(working_memory_t* memory, size_t n_subspaces,
+                             const float* samples, size_t n_samples);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // WORKING_MEMORY_H
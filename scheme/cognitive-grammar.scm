@@ -67,15 +67,24 @@
   "Create an activation pattern for a concept with given strength"
   (list 'activation concept strength))
 
-;; Attention mechanism - symbolic representation
-(define (attention-focus concepts weights)
-  "Define attention focus over concepts with weights"
-  (list 'attention concepts weights))
+;; Attention and spreading activation. Under neural_scheme they run on the
+;; native attention and spread-activation primitives, which accept these
+;; forms; elsewhere they build the bridge's attention and spread commands.
+(cond-expand
+  (neural-scheme
+   (define (attention-focus concepts weights)
+     "Attend over registered concepts with given weights"
+     (attention concepts weights)))
+  (else
+   ;; Attention mechanism - symbolic representation
+   (define (attention-focus concepts weights)
+     "Define attention focus over concepts with weights"
+     (list 'attention concepts weights))
 
-;; Spreading activation
-(define (spread-activation pattern threshold)
-  "Spread activation from a pattern to related concepts"
-  (list 'spread pattern threshold))
+   ;; Spreading activation
+   (define (spread-activation pattern threshold)
+     "Spread activation from a pattern to related concepts"
+     (list 'spread pattern threshold))))
 
 ;; ============================================================================
 ;; WORKING MEMORY
@@ -123,20 +132,112 @@
 ;; NEURAL-SYMBOLIC INTERFACE
 ;; ============================================================================
 
-;; Bridge to tensor operations (implemented in ggml)
-(define (neural-compute operation tensors)
-  "Interface to neural computation layer (ggml)"
-  (list 'neural-compute operation tensors))
+;; Under neural_scheme (the embedded evaluator) neural-compute, encode, decode
+;; and register-concepts are native primitives over live tensors and the
+;; evaluator's cognitive context. Any other Scheme gets procedures that build
+;; the same calls as bridge commands, for bridge_process or bridge_server.
+;; Feature selection uses cond-expand (R7RS, SRFI 0).
+(cond-expand
+  (neural-scheme
+   (define encode-symbolic-to-neural encode)
+   (define decode-neural-to-symbolic decode))
+  (else
+   ;; Bridge to tensor operations (implemented in ggml)
+   (define (neural-compute operation tensors)
+     "Interface to neural computation layer (ggml)"
+     (list 'neural-compute operation tensors))
 
-;; Symbolic encoding for neural processing
-(define (encode-symbolic-to-neural symbolic-form)
-  "Encode symbolic representation for neural processing"
-  (list 'encode symbolic-form))
+   ;; Symbolic encoding for neural processing
+   (define (encode-symbolic-to-neural symbolic-form)
+     "Encode symbolic representation for neural processing"
+     (list 'encode symbolic-form))
 
-;; Neural decoding to symbolic form
-(define (decode-neural-to-symbolic neural-output)
-  "Decode neural output to symbolic representation"
-  (list 'decode neural-output))
+   ;; Neural decoding to symbolic form
+   (define (decode-neural-to-symbolic neural-output)
+     "Decode neural output to symbolic representation"
+     (list 'decode neural-output))
+
+   ;; Concept names for consecutive nodes, so replies name them
+   (define (register-concepts node . names)
+     "Name nodes node, node + 1, ... after the given concepts"
+     (cons 'register-concepts (cons node names)))))
+
+;; Binary tensor frames, byte for byte the C bridge's wire format:
+;;   "NPTF", u8 version, u8 dtype, u16 rank, u64 shape[rank], f32 data
+;; All little-endian. Tensors on the Scheme side keep the text form
+;; (tensor (shape d ...) (data v ...)), which stays the debugging view.
+;; Needs the R6RS bytevector procedures (Guile, Chez Scheme).
+(define tensor-frame-magic '(78 80 84 70))
+(define tensor-frame-version 1)
+(define tensor-frame-float32 1)
+
+(define (tensor->bytevector tensor)
+  "Encode (tensor (shape d ...) (data v ...)) as a binary tensor frame"
+  (let* ((shape (cdr (cadr tensor)))
+         (data (cdr (caddr tensor)))
+         (rank (length shape))
+         (header-size (+ 8 (* 8 rank)))
+         (frame (make-bytevector (+ header-size (* 4 (length data))) 0)))
+    (let loop ((bytes tensor-frame-magic) (offset 0))
+      (if (pair? bytes)
+          (begin
+            (bytevector-u8-set! frame offset (car bytes))
+            (loop (cdr bytes) (+ offset 1)))))
+    (bytevector-u8-set! frame 4 tensor-frame-version)
+    (bytevector-u8-set! frame 5 tensor-frame-float32)
+    (bytevector-u16-set! frame 6 rank (endianness little))
+    (let loop ((dims shape) (offset 8))
+      (if (pair? dims)
+          (begin
+            (bytevector-u64-set! frame offset (car dims) (endianness little))
+            (loop (cdr dims) (+ offset 8)))))
+    (let loop ((values data) (offset header-size))
+      (if (pair? values)
+          (begin
+            (bytevector-ieee-single-set! frame offset (exact->inexact (car values))
+                                         (endianness little))
+            (loop (cdr values) (+ offset 4)))))
+    frame))
+
+(define (tensor-frame-header? frame)
+  "Check magic, version, dtype and that the shape fits in the frame"
+  (and (>= (bytevector-length frame) 8)
+       (equal? (list (bytevector-u8-ref frame 0) (bytevector-u8-ref frame 1)
+                     (bytevector-u8-ref frame 2) (bytevector-u8-ref frame 3))
+               tensor-frame-magic)
+       (= (bytevector-u8-ref frame 4) tensor-frame-version)
+       (= (bytevector-u8-ref frame 5) tensor-frame-float32)
+       (let ((rank (bytevector-u16-ref frame 6 (endianness little))))
+         (and (> rank 0)
+              (>= (bytevector-length frame) (+ 8 (* 8 rank)))))))
+
+(define (bytevector->tensor frame)
+  "Decode a binary tensor frame into (tensor (shape d ...) (data v ...)), or #f"
+  (if (not (tensor-frame-header? frame))
+      #f
+      (let* ((rank (bytevector-u16-ref frame 6 (endianness little)))
+             (header-size (+ 8 (* 8 rank)))
+             (shape (let loop ((i (- rank 1)) (dims '()))
+                      (if (< i 0)
+                          dims
+                          (loop (- i 1)
+                                (cons (bytevector-u64-ref frame (+ 8 (* 8 i))
+                                                          (endianness little))
+                                      dims)))))
+             (count (apply * shape)))
+        (if (< (bytevector-length frame) (+ header-size (* 4 count)))
+            #f
+            (list 'tensor
+                  (cons 'shape shape)
+                  (cons 'data
+                        (let loop ((i (- count 1)) (values '()))
+                          (if (< i 0)
+                              values
+                              (loop (- i 1)
+                                    (cons (bytevector-ieee-single-ref
+                                           frame (+ header-size (* 4 i))
+                                           (endianness little))
+                                          values))))))))))
 
 ;; ============================================================================
 ;; EXAMPLE USAGE
@@ -0,0 +1,314 @@
+/**
+ * activation_spread.c
+ *
+ * Implementation of batched and structured activation spreading
+ */
+
+#include "activation_spread.h"
+#include <stdlib.h>
+#include <string.h>
+
+// ============================================================================
+// BATCHED ACTIVATION SPREADING IMPLEMENTATION
+// ============================================================================
+
+activation_batch_t* activation_batch_create(size_t n_queries, size_t n_nodes) {
+    activation_batch_t* batch = (activation_batch_t*)calloc(1, sizeof(activation_batch_t));
+    if (!batch) return NULL;
+    
+    batch->n_queries = n_queries;
+    batch->n_nodes = n_nodes;
+    
+    size_t shape[2] = {n_queries, n_nodes};
+    batch->activations = neural_tensor_create(shape, 2);
+    batch->spread_buffer = neural_tensor_create(shape, 2);
+    batch->decay = (float*)malloc(n_queries * sizeof(float));
+    batch->thresholds = (float*)malloc(n_queries * sizeof(float));
+    
+    if (!batch->activations || !batch->spread_buffer ||
+        !batch->decay || !batch->thresholds) {
+        activation_batch_free(batch);
+        return NULL;
+    }
+    
+    // Same defaults as a single landscape
+    for (size_t q = 0; q < n_queries; q++) {
+        batch->decay[q] = 1.0f;
+        batch->thresholds[q] = 0.5f;
+    }
+    
+    return batch;
+}
+
+void activation_batch_free(activation_batch_t* batch) {
+    if (batch) {
+        if (batch->activations) neural_tensor_free(batch->activations);
+        if (batch->spread_buffer) neural_tensor_free(batch->spread_buffer);
+        free(batch->decay);
+        free(batch->thresholds);
+        free(batch);
+    }
+}
+
+void activation_batch_set_query(activation_batch_t* batch, size_t query,
+                                const float* seed, float decay, float threshold) {
+    if (!batch || query >= batch->n_queries) return;
+    
+    float* row = batch->activations->data + query * batch->n_nodes;
+    if (seed) {
+        memcpy(row, seed, batch->n_nodes * sizeof(float));
+    } else {
+        memset(row, 0, batch->n_nodes * sizeof(float));
+    }
+    
+    batch->decay[query] = decay;
+    batch->thresholds[query] = threshold;
+}
+
+bool activation_batch_spread(activation_batch_t* batch,
+                             const neural_tensor_t* connectivity) {
+    if (!batch || !connectivity || connectivity->n_dims != 2) return false;
+    if (connectivity->shape[0] != batch->n_nodes ||
+        connectivity->shape[1] != batch->n_nodes) return false;
+    
+    // One GEMM for every query: [B, n] x [n, n]
+    if (!neural_matmul_into(batch->activations, connectivity, batch->spread_buffer)) {
+        return false;
+    }
+    
+    // The GEMM output becomes the new activations; the old ones are the next buffer
+    neural_tensor_t* spread = batch->spread_buffer;
+    batch->spread_buffer = batch->activations;
+    batch->activations = spread;
+    
+    size_t n = batch->n_nodes;
+    for (size_t q = 0; q < batch->n_queries; q++) {
+        float* row = spread->data + q * n;
+        float decay = batch->decay[q];
+        for (size_t i = 0; i < n; i++) {
+            row[i] *= decay;
+        }
+    }
+    
+    return true;
+}
+
+size_t* activation_batch_get_active_nodes(const activation_batch_t* batch,
+                                          size_t query, size_t* n_active) {
+    if (!n_active) return NULL;
+    *n_active = 0;
+    if (!batch || query >= batch->n_queries) return NULL;
+    
+    const float* row = batch->activations->data + query * batch->n_nodes;
+    float threshold = batch->thresholds[query];
+    
+    // Count active nodes
+    for (size_t i = 0; i < batch->n_nodes; i++) {
+        if (row[i] > threshold) (*n_active)++;
+    }
+    
+    if (*n_active == 0) return NULL;
+    
+    // Collect active node indices
+    size_t* active_nodes = (size_t*)malloc(*n_active * sizeof(size_t));
+    if (!active_nodes) {
+        *n_active = 0;
+        return NULL;
+    }
+    size_t idx = 0;
+    for (size_t i = 0; i < batch->n_nodes; i++) {
+        if (row[i] > threshold) active_nodes[idx++] = i;
+    }
+    
+    return active_nodes;
+}
+
+// ============================================================================
+// STRUCTURED CONNECTIVITY OPERATORS IMPLEMENTATION
+// ============================================================================
+
+static connectivity_op_t* connectivity_alloc(connectivity_kind_t kind, size_t n_nodes) {
+    connectivity_op_t* op = (connectivity_op_t*)calloc(1, sizeof(connectivity_op_t));
+    if (!op) return NULL;
+    
+    op->kind = kind;
+    op->n_nodes = n_nodes;
+    return op;
+}
+
+connectivity_op_t* connectivity_identity_uniform(size_t n_nodes, float diagonal,
+                                                 float off_diagonal) {
+    connectivity_op_t* op = connectivity_alloc(CONNECTIVITY_IDENTITY_UNIFORM, n_nodes);
+    if (!op) return NULL;
+    
+    op->diagonal = diagonal;
+    op->off_diagonal = off_diagonal;
+    return op;
+}
+
+connectivity_op_t* connectivity_banded(size_t n_nodes, size_t bandwidth) {
+    connectivity_op_t* op = connectivity_alloc(CONNECTIVITY_BANDED, n_nodes);
+    if (!op) return NULL;
+    
+    op->bandwidth = bandwidth;
+    op->band = (float*)calloc(n_nodes * (2 * bandwidth + 1), sizeof(float));
+    if (!op->band) {
+        connectivity_free(op);
+        return NULL;
+    }
+    return op;
+}
+
+connectivity_op_t* connectivity_low_rank(size_t n_nodes, size_t rank) {
+    connectivity_op_t* op = connectivity_alloc(CONNECTIVITY_LOW_RANK, n_nodes);
+    if (!op) return NULL;
+    
+    op->rank = rank;
+    op->diag = (float*)calloc(n_nodes, sizeof(float));
+    op->factors_u = (float*)calloc(rank * n_nodes, sizeof(float));
+    op->factors_v = (float*)calloc(rank * n_nodes, sizeof(float));
+    if (!op->diag || (rank > 0 && (!op->factors_u || !op->factors_v))) {
+        connectivity_free(op);
+        return NULL;
+    }
+    return op;
+}
+
+connectivity_op_t* connectivity_block_diagonal(size_t n_nodes, size_t block_size) {
+    if (block_size == 0) return NULL;
+    
+    connectivity_op_t* op = connectivity_alloc(CONNECTIVITY_BLOCK_DIAGONAL, n_nodes);
+    if (!op) return NULL;
+    
+    op->block_size = block_size;
+    op->n_blocks = (n_nodes + block_size - 1) / block_size;
+    op->blocks = (float*)calloc(op->n_blocks * block_size * block_size, sizeof(float));
+    if (!op->blocks) {
+        connectivity_free(op);
+        return NULL;
+    }
+    return op;
+}
+
+void connectivity_free(connectivity_op_t* op) {
+    if (op) {
+        free(op->band);
+        free(op->diag);
+        free(op->factors_u);
+        free(op->factors_v);
+        free(op->blocks);
+        free(op);
+    }
+}
+
+void connectivity_apply(const connectivity_op_t* op, const float* input, float* output) {
+    if (!op || !input || !output) return;
+    
+    size_t n = op->n_nodes;
+    
+    switch (op->kind) {
+    case CONNECTIVITY_IDENTITY_UNIFORM: {
+        // x * (a I + b 1 1^T) with a = diagonal - off_diagonal, b = off_diagonal
+        float total = 0.0f;
+        for (size_t i = 0; i < n; i++) {
+            total += input[i];
+        }
+        float self_weight = op->diagonal - op->off_diagonal;
+        float shared = op->off_diagonal * total;
+        for (size_t j = 0; j < n; j++) {
+            output[j] = self_weight * input[j] + shared;
+        }
+        break;
+    }
+    case CONNECTIVITY_BANDED: {
+        size_t w = op->bandwidth;
+        size_t width = 2 * w + 1;
+        memset(output, 0, n * sizeof(float));
+        for (size_t i = 0; i < n; i++) {
+            float x = input[i];
+            size_t j0 = (i > w) ? i - w : 0;
+            size_t j1 = (i + w + 1 < n) ? i + w + 1 : n;
+            const float* row = op->band + i * width + w - i;
+            for (size_t j = j0; j < j1; j++) {
+                output[j] += x * row[j];
+            }
+        }
+        break;
+    }
+    case CONNECTIVITY_LOW_RANK: {
+        for (size_t j = 0; j < n; j++) {
+            output[j] = op->diag[j] * input[j];
+        }
+        for (size_t t = 0; t < op->rank; t++) {
+            const float* u = op->factors_u + t * n;
+            const float* v = op->factors_v + t * n;
+            float projection = 0.0f;
+            for (size_t i = 0; i < n; i++) {
+                projection += input[i] * u[i];
+            }
+            for (size_t j = 0; j < n; j++) {
+                output[j] += projection * v[j];
+            }
+        }
+        break;
+    }
+    case CONNECTIVITY_BLOCK_DIAGONAL: {
+        size_t s = op->block_size;
+        memset(output, 0, n * sizeof(float));
+        for (size_t b = 0; b < op->n_blocks; b++) {
+            size_t offset = b * s;
+            size_t size = (offset + s < n) ? s : n - offset;
+            const float* block = op->blocks + b * s * s;
+            for (size_t i = 0; i < size; i++) {
+                float x = input[offset + i];
+                const float* row = block + i * s;
+                float* out = output + offset;
+                for (size_t j = 0; j < size; j++) {
+                    out[j] += x * row[j];
+                }
+            }
+        }
+        break;
+    }
+    }
+}
+
+neural_tensor_t* connectivity_to_dense(const connectivity_op_t* op) {
+    if (!op) return NULL;
+    
+    size_t n = op->n_nodes;
+    size_t shape[2] = {n, n};
+    neural_tensor_t* dense = neural_tensor_create(shape, 2);
+    if (!dense) return NULL;
+    
+    // Row i of C is e_i * C
+    float* basis = (float*)calloc(n, sizeof(float));
+    if (!basis) {
+        neural_tensor_free(dense);
+        return NULL;
+    }
+    for (size_t i = 0; i < n; i++) {
+        basis[i] = 1.0f;
+        connectivity_apply(op, basis, dense->data + i * n);
+        basis[i] = 0.0f;
+    }
+    free(basis);
+    
+    return dense;
+}
+
+void activation_landscape_spread_op(activation_landscape_t* landscape,
+                                    const connectivity_op_t* op,
+                                    float decay_factor) {
+    if (!landscape || !op || op->n_nodes != landscape->n_nodes) return;
+    
+    float* spread = landscape->spread_buffer;
+    connectivity_apply(op, landscape->activations->data, spread);
+    
+    for (size_t i = 0; i < landscape->n_nodes; i++) {
+        spread[i] *= decay_factor;
+    }
+    
+    // Commit through the landscape so the active set stays current
+    activation_landscape_update(landscape, spread);
+}
@@ -0,0 +1,257 @@
+/**
+ * cognitive_batch.c
+ *
+ * Implementation of batched cognitive sessions
+ */
+
+#include "cognitive_batch.h"
+#include "neural_parallel.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Sessions handled by one parallel task
+#define COGNITIVE_BATCH_CHUNK 16
+
+// ============================================================================
+// LIFECYCLE
+// ============================================================================
+
+cognitive_batch_t* cognitive_batch_create(size_t n_sessions, size_t n_nodes) {
+    if (n_sessions == 0 || n_nodes == 0) return NULL;
+    
+    cognitive_batch_t* batch = (cognitive_batch_t*)calloc(1, sizeof(cognitive_batch_t));
+    if (!batch) return NULL;
+    
+    batch->n_sessions = n_sessions;
+    batch->n_nodes = n_nodes;
+    batch->config = cognitive_pipeline_default_config();
+    
+    size_t shape[2] = {n_sessions, n_nodes};
+    batch->activations = neural_tensor_create(shape, 2);
+    batch->stage = neural_tensor_create(shape, 2);
+    batch->thresholds = (float*)malloc(n_sessions * n_nodes * sizeof(float));
+    batch->is_active = (bool*)calloc(n_sessions * n_nodes, sizeof(bool));
+    batch->n_active = (size_t*)calloc(n_sessions, sizeof(size_t));
+    
+    if (!batch->activations || !batch->stage || !batch->thresholds ||
+        !batch->is_active || !batch->n_active) {
+        cognitive_batch_free(batch);
+        return NULL;
+    }
+    
+    // Same default as a single landscape
+    for (size_t i = 0; i < n_sessions * n_nodes; i++) {
+        batch->thresholds[i] = 0.5f;
+    }
+    
+    return batch;
+}
+
+void cognitive_batch_free(cognitive_batch_t* batch) {
+    if (batch) {
+        if (batch->activations) neural_tensor_free(batch->activations);
+        if (batch->stage) neural_tensor_free(batch->stage);
+        free(batch->thresholds);
+        free(batch->is_active);
+        free(batch->n_active);
+        free(batch);
+    }
+}
+
+bool cognitive_batch_configure(cognitive_batch_t* batch,
+                               const cognitive_pipeline_config_t* config) {
+    if (!batch || !config || config->attention_mix != 0.0f) return false;
+    
+    size_t n = batch->n_nodes;
+    if (config->connectivity_op && config->connectivity_op->n_nodes != n) return false;
+    if (config->connectivity) {
+        const neural_tensor_t* c = config->connectivity;
+        if (c->n_dims != 2 || c->shape[0] != n || c->shape[1] != n) return false;
+    }
+    
+    batch->config = *config;
+    return true;
+}
+
+float* cognitive_batch_session(cognitive_batch_t* batch, size_t session) {
+    if (!batch || session >= batch->n_sessions) return NULL;
+    return batch->activations->data + session * batch->n_nodes;
+}
+
+float* cognitive_batch_thresholds(cognitive_batch_t* batch, size_t session) {
+    if (!batch || session >= batch->n_sessions) return NULL;
+    return batch->thresholds + session * batch->n_nodes;
+}
+
+// ============================================================================
+// STEPPING
+// ============================================================================
+
+typedef enum {
+    BATCH_PASS_INPUT,       // stage = retention * state + gain * input
+    BATCH_PASS_SPREAD,      // state = decay * (stage * op), then threshold
+    BATCH_PASS_COMMIT,      // state = decay * (stage * connectivity) or stage, then threshold
+    BATCH_PASS_THRESHOLD    // threshold only
+} batch_pass_t;
+
+typedef struct {
+    cognitive_batch_t* batch;
+    const float* inputs;
+    batch_pass_t pass;
+    size_t n_chunks;
+} batch_job_t;
+
+/**
+ * Threshold one session row: refresh is_active and the active count
+ */
+static void batch_threshold_row(cognitive_batch_t* batch, size_t session) {
+    size_t n = batch->n_nodes;
+    const float* row = batch->activations->data + session * n;
+    const float* thresholds = batch->thresholds + session * n;
+    bool* is_active = batch->is_active + session * n;
+    
+    size_t count = 0;
+    for (size_t i = 0; i < n; i++) {
+        is_active[i] = row[i] > thresholds[i];
+        count += is_active[i];
+    }
+    batch->n_active[session] = count;
+}
+
+static void batch_chunk_task(void* ctx, size_t chunk) {
+    batch_job_t* job = (batch_job_t*)ctx;
+    cognitive_batch_t* batch = job->batch;
+    const cognitive_pipeline_config_t* config = &batch->config;
+    size_t n = batch->n_nodes;
+    
+    size_t s0 = chunk * COGNITIVE_BATCH_CHUNK;
+    size_t s1 = s0 + COGNITIVE_BATCH_CHUNK;
+    if (s1 > batch->n_sessions) s1 = batch->n_sessions;
+    
+    if (job->pass == BATCH_PASS_COMMIT && config->connectivity) {
+        // This chunk's rows of the dense product; shapes were checked when configured
+        size_t rows_shape[2] = {s1 - s0, n};
+        neural_tensor_t stage_rows = {batch->stage->data + s0 * n, rows_shape, 2,
+                                      (s1 - s0) * n, false};
+        neural_tensor_t state_rows = {batch->activations->data + s0 * n, rows_shape, 2,
+                                      (s1 - s0) * n, false};
+        neural_matmul_into(&stage_rows, config->connectivity, &state_rows);
+    }
+    
+    for (size_t s = s0; s < s1; s++) {
+        float* state = batch->activations->data + s * n;
+        float* stage = batch->stage->data + s * n;
+    
+        switch (job->pass) {
+        case BATCH_PASS_INPUT: {
+            float retention = config->retention;
+            float gain = config->input_gain;
+            if (job->inputs) {
+                const float* input = job->inputs + s * n;
+                for (size_t i = 0; i < n; i++) {
+                    stage[i] = retention * state[i] + gain * input[i];
+                }
+            } else {
+                for (size_t i = 0; i < n; i++) {
+                    stage[i] = retention * state[i];
+                }
+            }
+            break;
+        }
+        case BATCH_PASS_SPREAD: {
+            connectivity_apply(config->connectivity_op, stage, state);
+            float decay = config->decay_factor;
+            for (size_t i = 0; i < n; i++) {
+                state[i] *= decay;
+            }
+            batch_threshold_row(batch, s);
+            break;
+        }
+        case BATCH_PASS_COMMIT: {
+            if (config->connectivity) {
+                float decay = config->decay_factor;
+                for (size_t i = 0; i < n; i++) {
+                    state[i] *= decay;
+                }
+            } else {
+                memcpy(state, stage, n * sizeof(float));
+            }
+            batch_threshold_row(batch, s);
+            break;
+        }
+        case BATCH_PASS_THRESHOLD:
+            batch_threshold_row(batch, s);
+            break;
+        }
+    }
+}
+
+static void batch_run(cognitive_batch_t* batch, const float* inputs, batch_pass_t pass) {
+    size_t n_chunks = (batch->n_sessions + COGNITIVE_BATCH_CHUNK - 1) / COGNITIVE_BATCH_CHUNK;
+    batch_job_t job = {batch, inputs, pass, n_chunks};
+    neural_parallel_for(n_chunks, batch_chunk_task, &job);
+}
+
+void cognitive_batch_sync(cognitive_batch_t* batch) {
+    if (!batch) return;
+    batch_run(batch, NULL, BATCH_PASS_THRESHOLD);
+}
+
+bool cognitive_batch_step(cognitive_batch_t* batch, const float* inputs) {
+    if (!batch) return false;
+    
+    batch_run(batch, inputs, BATCH_PASS_INPUT);
+    
+    if (batch->config.connectivity_op) {
+        batch_run(batch, NULL, BATCH_PASS_SPREAD);
+        return true;
+    }
+    
+    // Dense spreading: each chunk multiplies its own rows of the [sessions, n] stage
+    batch_run(batch, NULL, BATCH_PASS_COMMIT);
+    return true;
+}
+
+// ============================================================================
+// SESSION ACCESS
+// ============================================================================
+
+size_t cognitive_batch_active_nodes(const cognitive_batch_t* batch, size_t session,
+                                    size_t* nodes, size_t max_nodes) {
+    if (!batch || session >= batch->n_sessions) return 0;
+    
+    const bool* is_active = batch->is_active + session * batch->n_nodes;
+    size_t written = 0;
+    for (size_t i = 0; i < batch->n_nodes && written < max_nodes && nodes; i++) {
+        if (is_active[i]) nodes[written++] = i;
+    }
+    return batch->n_active[session];
+}
+
+bool cognitive_batch_load(cognitive_batch_t* batch, size_t session,
+                          const cognitive_context_t* context) {
+    if (!batch || !context || session >= batch->n_sessions) return false;
+    
+    const activation_landscape_t* landscape = context->landscape;
+    size_t n = batch->n_nodes;
+    if (landscape->n_nodes != n) return false;
+    
+    memcpy(batch->activations->data + session * n, landscape->activations->data,
+           n * sizeof(float));
+    memcpy(batch->thresholds + session * n, landscape->thresholds, n * sizeof(float));
+    batch_threshold_row(batch, session);
+    return true;
+}
+
+bool cognitive_batch_store(const cognitive_batch_t* batch, size_t session,
+                           cognitive_context_t* context) {
+    if (!batch || !context || session >= batch->n_sessions) return false;
+    
+    activation_landscape_t* landscape = context->landscape;
+    size_t n = batch->n_nodes;
+    if (landscape->n_nodes != n) return false;
+    
+    memcpy(landscape->thresholds, batch->thresholds + session * n, n * sizeof(float));
+    activation_landscape_update(landscape, batch->activations->data + session * n);
+    return true;
+}
@@ -0,0 +1,129 @@
+/**
+ * cognitive_pipeline.c
+ *
+ * Implementation of the fused cognitive step
+ */
+
+#include "cognitive_pipeline.h"
+#include <stdlib.h>
+#include <string.h>
+
+// ============================================================================
+// PIPELINE LIFECYCLE
+// ============================================================================
+
+cognitive_pipeline_config_t cognitive_pipeline_default_config(void) {
+    cognitive_pipeline_config_t config;
+    config.input_gain = 1.0f;
+    config.retention = 0.0f;
+    config.connectivity_op = NULL;
+    config.connectivity = NULL;
+    config.decay_factor = 1.0f;
+    config.attention_mix = 0.0f;
+    return config;
+}
+
+void cognitive_pipeline_free(cognitive_pipeline_t* pipeline) {
+    if (pipeline) {
+        if (pipeline->stage) neural_tensor_free(pipeline->stage);
+        if (pipeline->spread) neural_tensor_free(pipeline->spread);
+        free(pipeline->attended);
+        free(pipeline);
+    }
+}
+
+static cognitive_pipeline_t* cognitive_pipeline_create(size_t n_nodes) {
+    cognitive_pipeline_t* pipeline = (cognitive_pipeline_t*)calloc(1, sizeof(cognitive_pipeline_t));
+    if (!pipeline) return NULL;
+    
+    size_t shape[2] = {1, n_nodes};
+    pipeline->stage = neural_tensor_create(shape, 2);
+    pipeline->spread = neural_tensor_create(shape, 2);
+    pipeline->attended = (float*)malloc(n_nodes * sizeof(float));
+    
+    if (!pipeline->stage || !pipeline->spread || !pipeline->attended) {
+        cognitive_pipeline_free(pipeline);
+        return NULL;
+    }
+    
+    return pipeline;
+}
+
+bool cognitive_context_configure_pipeline(cognitive_context_t* context,
+                                          const cognitive_pipeline_config_t* config) {
+    if (!context || !config) return false;
+    
+    size_t n = context->landscape->n_nodes;
+    if (config->connectivity_op && config->connectivity_op->n_nodes != n) return false;
+    if (config->connectivity) {
+        const neural_tensor_t* c = config->connectivity;
+        if (c->n_dims != 2 || c->shape[0] != n || c->shape[1] != n) return false;
+    }
+    if (config->attention_mix > 0.0f &&
+        context->attention_mode == COGNITIVE_ATTENTION_DENSE && !context->kv_cache) {
+        return false;
+    }
+    
+    if (!context->pipeline) {
+        context->pipeline = cognitive_pipeline_create(n);
+        if (!context->pipeline) return false;
+    }
+    context->pipeline->config = *config;
+    return true;
+}
+
+// ============================================================================
+// FUSED STEP
+// ============================================================================
+
+bool cognitive_context_step_fused(cognitive_context_t* context,
+                                  const float* input, size_t n_input) {
+    if (!context || !context->pipeline) return false;
+    
+    cognitive_pipeline_t* pipeline = context->pipeline;
+    const cognitive_pipeline_config_t* config = &pipeline->config;
+    activation_landscape_t* landscape = context->landscape;
+    size_t n = landscape->n_nodes;
+    if (n_input > n || (n_input > 0 && !input)) return false;
+    
+    // Input: blend the event into the previous state
+    const float* current = landscape->activations->data;
+    float* stage = pipeline->stage->data;
+    float gain = config->input_gain;
+    float retention = config->retention;
+    for (size_t i = 0; i < n_input; i++) {
+        stage[i] = retention * current[i] + gain * input[i];
+    }
+    for (size_t i = n_input; i < n; i++) {
+        stage[i] = retention * current[i];
+    }
+    
+    // Spread: state * C, then decay
+    float* state = stage;
+    if (config->connectivity_op || config->connectivity) {
+        state = pipeline->spread->data;
+        if (config->connectivity_op) {
+            connectivity_apply(config->connectivity_op, stage, state);
+        } else if (!neural_matmul_into(pipeline->stage, config->connectivity, pipeline->spread)) {
+            return false;
+        }
+        float decay = config->decay_factor;
+        for (size_t i = 0; i < n; i++) {
+            state[i] *= decay;
+        }
+    }
+    
+    // Attention over previous steps, mixed back into the state
+    float mix = config->attention_mix;
+    if (mix > 0.0f) {
+        if (!cognitive_context_attend_state(context, state, pipeline->attended)) return false;
+        const float* attended = pipeline->attended;
+        for (size_t i = 0; i < n; i++) {
+            state[i] += mix * (attended[i] - state[i]);
+        }
+    }
+    
+    // Threshold: commit, maintaining the active set and crossings
+    activation_landscape_update(landscape, state);
+    return true;
+}
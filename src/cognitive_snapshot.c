@@ -0,0 +1,365 @@
+/**
+ * cognitive_snapshot.c
+ *
+ * Implementation of cognitive context snapshots
+ */
+
+#include "cognitive_snapshot.h"
+#include "neural_attention.h"
+#include "working_memory.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/**
+ * *out = a * b * c, false if the product overflows 64 bits
+ */
+static bool snapshot_bytes(uint64_t a, uint64_t b, uint64_t c, uint64_t* out) {
+    if (b != 0 && a > UINT64_MAX / b) return false;
+    uint64_t ab = a * b;
+    if (c != 0 && ab > UINT64_MAX / c) return false;
+    *out = ab * c;
+    return true;
+}
+
+static uint64_t snapshot_align(uint64_t offset) {
+    return (offset + COGNITIVE_SNAPSHOT_ALIGN - 1) / COGNITIVE_SNAPSHOT_ALIGN
+           * COGNITIVE_SNAPSHOT_ALIGN;
+}
+
+// ============================================================================
+// SAVE
+// ============================================================================
+
+bool cognitive_snapshot_save(const cognitive_context_t* context, const char* path) {
+    if (!context || !path) return false;
+    
+    const activation_landscape_t* landscape = context->landscape;
+    const working_memory_t* memory = context->working_memory;
+    uint64_t n = landscape->n_nodes;
+    
+    cognitive_snapshot_header_t header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, COGNITIVE_SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = COGNITIVE_SNAPSHOT_VERSION;
+    header.byte_order = COGNITIVE_SNAPSHOT_BYTE_ORDER;
+    header.n_nodes = n;
+    header.memory_capacity = context->capacity;
+    header.attention_mode = (uint32_t)context->attention_mode;
+    header.generation = landscape->generation;
+    
+    const void* data[SNAPSHOT_SECTION_COUNT] = {NULL};
+    uint64_t size[SNAPSHOT_SECTION_COUNT] = {0};
+    
+    data[SNAPSHOT_ACTIVATIONS] = landscape->activations->data;
+    size[SNAPSHOT_ACTIVATIONS] = n * sizeof(float);
+    data[SNAPSHOT_THRESHOLDS] = landscape->thresholds;
+    size[SNAPSHOT_THRESHOLDS] = n * sizeof(float);
+    
+    if (context->attention) {
+        const attention_state_t* attention = context->attention;
+        header.n_heads = (uint32_t)attention->n_heads;
+        header.dim_key = attention->query->shape[1];
+        uint64_t bytes;
+        if (!snapshot_bytes(n, header.dim_key, sizeof(float), &bytes)) return false;
+        data[SNAPSHOT_ATTENTION_OUTPUT] = attention->attention_weights->data;
+        data[SNAPSHOT_ATTENTION_QUERY] = attention->query->data;
+        data[SNAPSHOT_ATTENTION_KEY] = attention->key->data;
+        data[SNAPSHOT_ATTENTION_VALUE] = attention->value->data;
+        size[SNAPSHOT_ATTENTION_OUTPUT] = bytes;
+        size[SNAPSHOT_ATTENTION_QUERY] = bytes;
+        size[SNAPSHOT_ATTENTION_KEY] = bytes;
+        size[SNAPSHOT_ATTENTION_VALUE] = bytes;
+    }
+    if (context->feature_map) {
+        header.n_features = context->feature_map->n_features;
+    }
+    
+    if (memory) {
+        uint64_t capacity = memory->capacity;
+        header.memory_length = memory->length;
+        header.memory_head = memory->head;
+        header.memory_clock = memory->clock;
+        data[SNAPSHOT_MEMORY_TIMESTAMPS] = memory->timestamps;
+        size[SNAPSHOT_MEMORY_TIMESTAMPS] = capacity * sizeof(uint64_t);
+        if (memory->quantized) {
+            header.memory_subspaces = memory->n_subspaces;
+            header.memory_centroids = memory->n_centroids;
+            data[SNAPSHOT_MEMORY_CODES] = memory->codes;
+            size[SNAPSHOT_MEMORY_CODES] = capacity * memory->n_subspaces;
+            data[SNAPSHOT_MEMORY_CODEBOOKS] = memory->codebooks;
+            size[SNAPSHOT_MEMORY_CODEBOOKS] = WORKING_MEMORY_PQ_CENTROIDS * n * sizeof(float);
+        } else {
+            data[SNAPSHOT_MEMORY_EMBEDDINGS] = memory->embeddings;
+            if (!snapshot_bytes(capacity, n, sizeof(float), &size[SNAPSHOT_MEMORY_EMBEDDINGS])) {
+                return false;
+            }
+            data[SNAPSHOT_MEMORY_INV_NORMS] = memory->inv_norms;
+            size[SNAPSHOT_MEMORY_INV_NORMS] = capacity * sizeof(float);
+        }
+    }
+    
+    // Lay the sections out back to back at aligned offsets
+    uint64_t offset = snapshot_align(sizeof(header));
+    for (int s = 0; s < SNAPSHOT_SECTION_COUNT; s++) {
+        if (size[s] == 0) continue;
+        header.sections[s].offset = offset;
+        header.sections[s].size = size[s];
+        offset = snapshot_align(offset + size[s]);
+    }
+    header.file_size = offset;
+    
+    FILE* file = fopen(path, "wb");
+    if (!file) return false;
+    
+    static const char padding[COGNITIVE_SNAPSHOT_ALIGN] = {0};
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1;
+    uint64_t written = sizeof(header);
+    for (int s = 0; s < SNAPSHOT_SECTION_COUNT && ok; s++) {
+        if (size[s] == 0) continue;
+        uint64_t gap = header.sections[s].offset - written;
+        ok = fwrite(padding, 1, (size_t)gap, file) == gap &&
+             fwrite(data[s], 1, (size_t)size[s], file) == size[s];
+        written = header.sections[s].offset + size[s];
+    }
+    if (ok) {
+        uint64_t gap = header.file_size - written;
+        ok = fwrite(padding, 1, (size_t)gap, file) == gap;
+    }
+    
+    if (fclose(file) != 0) ok = false;
+    if (!ok) remove(path);
+    return ok;
+}
+
+// ============================================================================
+// LOAD
+// ============================================================================
+
+/**
+ * Check the header against the file and the sizes its dimensions imply
+ */
+static bool snapshot_validate(const cognitive_snapshot_header_t* header, uint64_t file_size) {
+    if (memcmp(header->magic, COGNITIVE_SNAPSHOT_MAGIC, sizeof(header->magic)) != 0) return false;
+    if (header->version != COGNITIVE_SNAPSHOT_VERSION) return false;
+    if (header->byte_order != COGNITIVE_SNAPSHOT_BYTE_ORDER) return false;
+    if (header->file_size != file_size || header->n_nodes == 0) return false;
+    
+    uint64_t n = header->n_nodes;
+    uint64_t capacity = header->memory_capacity;
+    bool dense = header->attention_mode == COGNITIVE_ATTENTION_DENSE;
+    bool linear = header->attention_mode == COGNITIVE_ATTENTION_LINEAR;
+    bool quantized = header->memory_subspaces > 0;
+    if (!dense && !linear) return false;
+    if (dense && header->dim_key == 0) return false;
+    if (linear && header->n_features == 0) return false;
+    if (quantized && (header->memory_subspaces > n || header->memory_centroids == 0 ||
+                      header->memory_centroids > WORKING_MEMORY_PQ_CENTROIDS)) {
+        return false;
+    }
+    if (capacity > 0 && (header->memory_length > capacity || header->memory_head >= capacity)) {
+        return false;
+    }
+    
+    // A crafted header must not wrap a product to a size the file can hold
+    uint64_t expected[SNAPSHOT_SECTION_COUNT] = {0};
+    bool fits = snapshot_bytes(n, 1, sizeof(float), &expected[SNAPSHOT_ACTIVATIONS]) &&
+                snapshot_bytes(n, 1, sizeof(float), &expected[SNAPSHOT_THRESHOLDS]);
+    if (fits && dense) {
+        uint64_t bytes = 0;
+        fits = snapshot_bytes(n, header->dim_key, sizeof(float), &bytes);
+        expected[SNAPSHOT_ATTENTION_OUTPUT] = bytes;
+        expected[SNAPSHOT_ATTENTION_QUERY] = bytes;
+        expected[SNAPSHOT_ATTENTION_KEY] = bytes;
+        expected[SNAPSHOT_ATTENTION_VALUE] = bytes;
+    }
+    if (fits && capacity > 0) {
+        fits = snapshot_bytes(capacity, 1, sizeof(uint64_t), &expected[SNAPSHOT_MEMORY_TIMESTAMPS]);
+        if (fits && quantized) {
+            fits = snapshot_bytes(capacity, header->memory_subspaces, 1,
+                                  &expected[SNAPSHOT_MEMORY_CODES]) &&
+                   snapshot_bytes(WORKING_MEMORY_PQ_CENTROIDS, n, sizeof(float),
+                                  &expected[SNAPSHOT_MEMORY_CODEBOOKS]);
+        } else if (fits) {
+            fits = snapshot_bytes(capacity, n, sizeof(float),
+                                  &expected[SNAPSHOT_MEMORY_EMBEDDINGS]) &&
+                   snapshot_bytes(capacity, 1, sizeof(float), &expected[SNAPSHOT_MEMORY_INV_NORMS]);
+        }
+    }
+    if (!fits) return false;
+    
+    for (int s = 0; s < SNAPSHOT_SECTION_COUNT; s++) {
+        uint64_t offset = header->sections[s].offset;
+        uint64_t size = header->sections[s].size;
+        if (size != expected[s]) return false;
+        if (size == 0) continue;
+        if (offset % COGNITIVE_SNAPSHOT_ALIGN != 0 || offset < sizeof(*header)) return false;
+        if (offset > file_size || size > file_size - offset) return false;
+    }
+    return true;
+}
+
+static void* snapshot_section(void* base, const cognitive_snapshot_header_t* header,
+                              cognitive_snapshot_section_t section) {
+    return (char*)base + header->sections[section].offset;
+}
+
+/**
+ * Dense attention whose weights point into the mapping
+ */
+static attention_state_t* snapshot_attention(void* base, const cognitive_snapshot_header_t* header) {
+    attention_state_t* attention = (attention_state_t*)calloc(1, sizeof(attention_state_t));
+    if (!attention) return NULL;
+    
+    size_t shape_weights[2] = {header->dim_key, header->n_nodes};
+    size_t shape_qkv[2] = {header->n_nodes, header->dim_key};
+    attention->n_heads = header->n_heads ? header->n_heads : 1;
+    attention->attention_weights = neural_tensor_wrap(
+        (float*)snapshot_section(base, header, SNAPSHOT_ATTENTION_OUTPUT), shape_weights, 2);
+    attention->query = neural_tensor_wrap(
+        (float*)snapshot_section(base, header, SNAPSHOT_ATTENTION_QUERY), shape_qkv, 2);
+    attention->key = neural_tensor_wrap(
+        (float*)snapshot_section(base, header, SNAPSHOT_ATTENTION_KEY), shape_qkv, 2);
+    attention->value = neural_tensor_wrap(
+        (float*)snapshot_section(base, header, SNAPSHOT_ATTENTION_VALUE), shape_qkv, 2);
+    
+    if (!attention->attention_weights || !attention->query || !attention->key ||
+        !attention->value) {
+        attention_free(attention);
+        return NULL;
+    }
+    return attention;
+}
+
+/**
+ * Working memory restored from the mapping (exact embeddings stay mapped)
+ */
+static working_memory_t* snapshot_memory(void* base, const cognitive_snapshot_header_t* header) {
+    size_t capacity = header->memory_capacity;
+    size_t n = header->n_nodes;
+    working_memory_t* memory = working_memory_create(capacity, n);
+    if (!memory) return NULL;
+    
+    memcpy(memory->timestamps, snapshot_section(base, header, SNAPSHOT_MEMORY_TIMESTAMPS),
+           capacity * sizeof(uint64_t));
+    memory->length = header->memory_length;
+    memory->head = header->memory_head;
+    memory->clock = header->memory_clock;
+    
+    free(memory->embeddings);
+    memory->embeddings = NULL;
+    memory->owns_embeddings = false;
+    
+    if (header->memory_subspaces == 0) {
+        memory->embeddings = (float*)snapshot_section(base, header, SNAPSHOT_MEMORY_EMBEDDINGS);
+        memcpy(memory->inv_norms, snapshot_section(base, header, SNAPSHOT_MEMORY_INV_NORMS),
+               capacity * sizeof(float));
+        return memory;
+    }
+    
+    // Codes and codebooks are small next to the embeddings they replace
+    size_t code_bytes = capacity * header->memory_subspaces;
+    size_t codebook_floats = WORKING_MEMORY_PQ_CENTROIDS * n;
+    free(memory->inv_norms);
+    memory->inv_norms = NULL;
+    memory->codes = (uint8_t*)malloc(code_bytes);
+    memory->codebooks = (float*)malloc(codebook_floats * sizeof(float));
+    memory->lut = (float*)malloc(header->memory_subspaces * WORKING_MEMORY_PQ_CENTROIDS *
+                                 sizeof(float));
+    if (!memory->codes || !memory->codebooks || !memory->lut) {
+        working_memory_free(memory);
+        return NULL;
+    }
+    memcpy(memory->codes, snapshot_section(base, header, SNAPSHOT_MEMORY_CODES), code_bytes);
+    memcpy(memory->codebooks, snapshot_section(base, header, SNAPSHOT_MEMORY_CODEBOOKS),
+           codebook_floats * sizeof(float));
+    memory->quantized = true;
+    memory->n_subspaces = header->memory_subspaces;
+    memory->n_centroids = header->memory_centroids;
+    return memory;
+}
+
+cognitive_context_t* cognitive_snapshot_load(const char* path) {
+    if (!path) return NULL;
+    
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return NULL;
+    
+    struct stat info;
+    if (fstat(fd, &info) != 0 || (uint64_t)info.st_size < sizeof(cognitive_snapshot_header_t)) {
+        close(fd);
+        return NULL;
+    }
+    
+    // Private mapping: pages are shared with the page cache until written
+    size_t file_size = (size_t)info.st_size;
+    void* base = mmap(NULL, file_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) return NULL;
+    
+    const cognitive_snapshot_header_t* header = (const cognitive_snapshot_header_t*)base;
+    cognitive_context_t* context = NULL;
+    if (snapshot_validate(header, file_size)) {
+        context = (cognitive_context_t*)calloc(1, sizeof(cognitive_context_t));
+    }
+    if (!context) {
+        munmap(base, file_size);
+        return NULL;
+    }
+    
+    // From here on cognitive_context_free releases the mapping
+    context->mapping = base;
+    context->mapping_size = file_size;
+    context->capacity = header->memory_capacity;
+    context->attention_mode = (cognitive_attention_mode_t)header->attention_mode;
+    
+    size_t n = header->n_nodes;
+    size_t shape[1] = {n};
+    context->landscape = activation_landscape_create(n);
+    neural_tensor_t* activations = neural_tensor_wrap(
+        (float*)snapshot_section(base, header, SNAPSHOT_ACTIVATIONS), shape, 1);
+    if (!context->landscape || !activations) {
+        if (activations) neural_tensor_free(activations);
+        cognitive_context_free(context);
+        return NULL;
+    }
+    activation_landscape_t* landscape = context->landscape;
+    neural_tensor_free(landscape->activations);
+    landscape->activations = activations;
+    memcpy(landscape->thresholds, snapshot_section(base, header, SNAPSHOT_THRESHOLDS),
+           n * sizeof(float));
+    activation_landscape_sync(landscape);
+    landscape->generation = header->generation;
+    
+    bool ok = true;
+    if (context->attention_mode == COGNITIVE_ATTENTION_LINEAR) {
+        // Same seed as cognitive_context_create_with_attention
+        context->feature_map = attention_feature_map_create(n, header->n_features,
+                                                            (unsigned int)n);
+        context->linear_state = attention_linear_state_create(context->feature_map, n);
+        ok = context->linear_state != NULL;
+    } else {
+        context->attention = snapshot_attention(base, header);
+        ok = context->attention != NULL;
+        if (ok && context->capacity > 0) {
+            context->kv_cache = attention_kv_cache_create(context->capacity, header->dim_key,
+                                                          header->dim_key,
+                                                          ATTENTION_KV_EVICT_OLDEST);
+            ok = context->kv_cache != NULL;
+        }
+    }
+    if (ok && context->capacity > 0) {
+        context->working_memory = snapshot_memory(base, header);
+        ok = context->working_memory != NULL;
+    }
+    
+    if (!ok) {
+        cognitive_context_free(context);
+        return NULL;
+    }
+    return context;
+}
@@ -0,0 +1,220 @@
+/**
+ * concept_table.c
+ *
+ * Implementation of the concept symbol table
+ */
+
+#include "concept_table.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Bytes per name storage block (longer names get a block of their own)
+#define CONCEPT_ARENA_BLOCK 4096
+
+/**
+ * Chain of append-only blocks; names are never moved once stored
+ */
+struct concept_arena {
+    concept_arena_t* next;
+    size_t used;
+    size_t capacity;
+    char data[];
+};
+
+static uint64_t hash_name(const char* name, size_t length) {
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < length; i++) {
+        hash = (hash ^ (uint8_t)name[i]) * 1099511628211ull;
+    }
+    return hash;
+}
+
+/**
+ * Make sure the current block has bytes free; false when out of memory
+ */
+static bool arena_reserve(concept_table_t* table, size_t bytes) {
+    concept_arena_t* block = table->arena;
+    if (block && block->capacity - block->used >= bytes) return true;
+    
+    size_t capacity = (bytes > CONCEPT_ARENA_BLOCK) ? bytes : CONCEPT_ARENA_BLOCK;
+    block = (concept_arena_t*)malloc(sizeof(concept_arena_t) + capacity);
+    if (!block) return false;
+    block->next = table->arena;
+    block->used = 0;
+    block->capacity = capacity;
+    table->arena = block;
+    return true;
+}
+
+/**
+ * Copy a name into the arena; NULL when out of memory
+ */
+static const char* arena_store(concept_table_t* table, const char* name, size_t length) {
+    if (!arena_reserve(table, length + 1)) return NULL;
+    
+    concept_arena_t* block = table->arena;
+    char* stored = block->data + block->used;
+    memcpy(stored, name, length);
+    stored[length] = '\0';
+    block->used += length + 1;
+    return stored;
+}
+
+// ============================================================================
+// LIFECYCLE
+// ============================================================================
+
+concept_table_t* concept_table_create(size_t n_nodes) {
+    if (n_nodes == 0) return NULL;
+    
+    concept_table_t* table = (concept_table_t*)calloc(1, sizeof(concept_table_t));
+    if (!table) return NULL;
+    
+    // At most n_nodes names, so the index never needs to grow
+    table->n_nodes = n_nodes;
+    table->index_capacity = 8;
+    while (table->index_capacity < 2 * n_nodes) table->index_capacity *= 2;
+    table->names = (const char**)calloc(n_nodes, sizeof(const char*));
+    table->name_hashes = (uint64_t*)calloc(n_nodes, sizeof(uint64_t));
+    table->name_lengths = (size_t*)calloc(n_nodes, sizeof(size_t));
+    table->index = (size_t*)calloc(table->index_capacity, sizeof(size_t));
+    
+    if (!table->names || !table->name_hashes || !table->name_lengths || !table->index) {
+        concept_table_free(table);
+        return NULL;
+    }
+    
+    return table;
+}
+
+void concept_table_free(concept_table_t* table) {
+    if (table) {
+        concept_arena_t* block = table->arena;
+        while (block) {
+            concept_arena_t* next = block->next;
+            free(block);
+            block = next;
+        }
+        free(table->names);
+        free(table->name_hashes);
+        free(table->name_lengths);
+        free(table->index);
+        free(table);
+    }
+}
+
+// ============================================================================
+// LOOKUP AND REGISTRATION
+// ============================================================================
+
+/**
+ * Probe for a name: its node, or SIZE_MAX with *slot set to the empty slot
+ * that ends the probe run
+ */
+static size_t probe_name(const concept_table_t* table, const char* name, size_t length,
+                         uint64_t hash, size_t* slot) {
+    size_t mask = table->index_capacity - 1;
+    size_t probe = (size_t)hash & mask;
+    
+    while (table->index[probe] != 0) {
+        // Lengths are compared first so memcmp never reads past a shorter name
+        size_t node = table->index[probe] - 1;
+        if (table->name_hashes[node] == hash && table->name_lengths[node] == length &&
+            memcmp(table->names[node], name, length) == 0) {
+            return node;
+        }
+        probe = (probe + 1) & mask;
+    }
+    *slot = probe;
+    return SIZE_MAX;
+}
+
+size_t concept_table_find(const concept_table_t* table, const char* name, size_t length) {
+    if (!table || !name) return SIZE_MAX;
+    
+    size_t slot;
+    return probe_name(table, name, length, hash_name(name, length), &slot);
+}
+
+size_t concept_table_node(const concept_table_t* table, const char* name) {
+    return name ? concept_table_find(table, name, strlen(name)) : SIZE_MAX;
+}
+
+const char* concept_table_name(const concept_table_t* table, size_t node) {
+    if (!table || node >= table->n_nodes) return NULL;
+    return table->names[node];
+}
+
+bool concept_table_register(concept_table_t* table, const char* name, size_t node) {
+    if (!table || !name || node >= table->n_nodes) return false;
+    
+    size_t length = strlen(name);
+    uint64_t hash = hash_name(name, length);
+    size_t slot;
+    size_t existing = probe_name(table, name, length, hash, &slot);
+    if (existing != SIZE_MAX) return existing == node;
+    if (table->names[node]) return false;
+    
+    const char* stored = arena_store(table, name, length);
+    if (!stored) return false;
+    
+    table->names[node] = stored;
+    table->name_hashes[node] = hash;
+    table->name_lengths[node] = length;
+    table->index[slot] = node + 1;
+    table->n_concepts++;
+    return true;
+}
+
+bool concept_table_register_all(concept_table_t* table, const char* const* names,
+                                size_t n_names, size_t first_node) {
+    if (!table || !names) return false;
+    if (first_node > table->n_nodes || n_names > table->n_nodes - first_node) return false;
+    if (n_names == 0) return true;
+    
+    uint64_t* hashes = (uint64_t*)malloc(n_names * sizeof(uint64_t));
+    if (!hashes) return false;
+    
+    // Check every pair (and reserve their storage) first so a failure
+    // registers nothing
+    bool ok = true;
+    size_t bytes = 0;
+    for (size_t i = 0; i < n_names && ok; i++) {
+        if (!names[i]) {
+            ok = false;
+            break;
+        }
+        size_t length = strlen(names[i]);
+        size_t node = first_node + i;
+        bytes += length + 1;
+        size_t slot;
+        hashes[i] = hash_name(names[i], length);
+        size_t existing = probe_name(table, names[i], length, hashes[i], &slot);
+        ok = (existing == SIZE_MAX) ? table->names[node] == NULL : existing == node;
+        for (size_t j = 0; j < i && ok; j++) {
+            ok = hashes[j] != hashes[i] || strcmp(names[j], names[i]) != 0;
+        }
+    }
+    free(hashes);
+    if (ok) ok = arena_reserve(table, bytes);
+    
+    for (size_t i = 0; i < n_names && ok; i++) {
+        ok = concept_table_register(table, names[i], first_node + i);
+    }
+    return ok;
+}
+
+size_t concept_table_active_names(const concept_table_t* table,
+                                  const activation_landscape_t* landscape,
+                                  const char** names, size_t capacity) {
+    if (!table || !landscape || !names) return 0;
+    
+    size_t n_active = 0;
+    const size_t* active = activation_landscape_active_set(landscape, &n_active);
+    if (n_active > capacity) n_active = capacity;
+    
+    for (size_t i = 0; i < n_active; i++) {
+        names[i] = (active[i] < table->n_nodes) ? table->names[active[i]] : NULL;
+    }
+    return n_active;
+}
@@ -0,0 +1,1148 @@
+/**
+ * neural_attention.c
+ *
+ * Implementation of the tiled attention kernels
+ */
+
+#include "neural_attention.h"
+#include "neural_parallel.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+// Query rows and key/value rows per tile; sized so the tiles of a 64-wide
+// head stay within a typical L1 data cache
+#define FLASH_BLOCK_Q 16
+#define FLASH_BLOCK_KV 32
+
+// ============================================================================
+// STRIDED VIEWS IMPLEMENTATION
+// ============================================================================
+
+attention_view_t attention_view_of(const neural_tensor_t* tensor) {
+    attention_view_t view = {NULL, 0, 0, 0, 1};
+    if (!tensor) return view;
+    
+    view.data = tensor->data;
+    if (tensor->n_dims == 1) {
+        view.rows = 1;
+        view.cols = tensor->shape[0];
+    } else if (tensor->n_dims == 2) {
+        view.rows = tensor->shape[0];
+        view.cols = tensor->shape[1];
+    }
+    view.row_stride = view.cols;
+    return view;
+}
+
+attention_view_t attention_view_columns(const float* data, size_t rows, size_t ld,
+                                        size_t col_begin, size_t n_cols) {
+    attention_view_t view = {data + col_begin, rows, n_cols, ld, 1};
+    return view;
+}
+
+/**
+ * Copy rows [row_begin, row_begin + n_rows) of a view into a dense tile
+ */
+static void view_load_rows(const attention_view_t* view, size_t row_begin,
+                           size_t n_rows, float* tile) {
+    size_t cols = view->cols;
+    for (size_t r = 0; r < n_rows; r++) {
+        const float* src = view->data + (row_begin + r) * view->row_stride;
+        float* dst = tile + r * cols;
+        if (view->col_stride == 1) {
+            memcpy(dst, src, cols * sizeof(float));
+        } else {
+            for (size_t c = 0; c < cols; c++) {
+                dst[c] = src[c * view->col_stride];
+            }
+        }
+    }
+}
+
+// ============================================================================
+// TILED ATTENTION IMPLEMENTATION
+// ============================================================================
+
+size_t attention_flash_workspace_size(size_t dim_key, size_t dim_value) {
+    return FLASH_BLOCK_Q * dim_key          // query tile
+         + FLASH_BLOCK_KV * dim_key         // key tile
+         + FLASH_BLOCK_KV * dim_value       // value tile
+         + FLASH_BLOCK_Q * FLASH_BLOCK_KV   // score tile
+         + FLASH_BLOCK_Q * dim_value        // output accumulators
+         + 2 * FLASH_BLOCK_Q;               // running max and sum
+}
+
+/**
+ * Coverage of a query/key tile by a mask
+ */
+typedef enum {
+    TILE_EMPTY,     // No pair may attend: skip the tile
+    TILE_FULL,      // Every pair may attend: no per-entry checks
+    TILE_PARTIAL
+} tile_coverage_t;
+
+static bool mask_allows(const attention_mask_t* mask, size_t n_kv, size_t i, size_t j) {
+    switch (mask->kind) {
+    case ATTENTION_MASK_CAUSAL:
+        return j <= i;
+    case ATTENTION_MASK_BOOLEAN:
+        return mask->mask[i * n_kv + j] != 0;
+    case ATTENTION_MASK_BLOCK_SPARSE: {
+        size_t n_kv_blocks = (n_kv + mask->block_size - 1) / mask->block_size;
+        return mask->mask[(i / mask->block_size) * n_kv_blocks + j / mask->block_size] != 0;
+    }
+    case ATTENTION_MASK_SLIDING_WINDOW:
+        return i < mask->n_global || j < mask->n_global ||
+               (j + mask->window >= i && j <= i + mask->window);
+    case ATTENTION_MASK_NONE:
+    default:
+        return true;
+    }
+}
+
+/**
+ * Summary entry of query row i for the key tile starting at j0
+ */
+static tile_coverage_t mask_row_tile(const attention_mask_t* mask, size_t n_kv,
+                                     size_t i, size_t j0) {
+    size_t n_tiles = (n_kv + FLASH_BLOCK_KV - 1) / FLASH_BLOCK_KV;
+    return (tile_coverage_t)mask->tile_summary[i * n_tiles + j0 / FLASH_BLOCK_KV];
+}
+
+uint8_t* attention_mask_summarize(const uint8_t* mask, size_t n_q, size_t n_kv) {
+    if (!mask || n_q == 0 || n_kv == 0) return NULL;
+    
+    size_t n_tiles = (n_kv + FLASH_BLOCK_KV - 1) / FLASH_BLOCK_KV;
+    uint8_t* summary = (uint8_t*)malloc(n_q * n_tiles);
+    if (!summary) return NULL;
+    
+    for (size_t i = 0; i < n_q; i++) {
+        const uint8_t* row = mask + i * n_kv;
+        for (size_t t = 0; t < n_tiles; t++) {
+            size_t j0 = t * FLASH_BLOCK_KV;
+            size_t j1 = (j0 + FLASH_BLOCK_KV < n_kv) ? j0 + FLASH_BLOCK_KV : n_kv;
+            size_t any = 0;
+            for (size_t j = j0; j < j1; j++) {
+                any += row[j] != 0;
+            }
+            summary[i * n_tiles + t] = (uint8_t)(any == 0 ? TILE_EMPTY
+                                                 : any == j1 - j0 ? TILE_FULL : TILE_PARTIAL);
+        }
+    }
+    return summary;
+}
+
+/**
+ * Allowed columns of query i within keys [j0, j0 + bk) as one interval [lo, hi)
+ * Returns false when the row's allowed set is not contiguous (check per entry).
+ */
+static bool mask_row_span(const attention_mask_t* mask, size_t n_kv, size_t i, size_t j0,
+                          size_t bk, size_t* lo, size_t* hi) {
+    size_t first = 0;
+    size_t last = SIZE_MAX;     // Inclusive absolute bounds of the allowed keys
+    
+    if (mask->kind == ATTENTION_MASK_BOOLEAN && mask->tile_summary) {
+        // Only rows the summary marks partial need per-entry checks
+        tile_coverage_t coverage = mask_row_tile(mask, n_kv, i, j0);
+        if (coverage == TILE_PARTIAL) return false;
+        *lo = 0;
+        *hi = (coverage == TILE_FULL) ? bk : 0;
+        return true;
+    } else if (mask->kind == ATTENTION_MASK_CAUSAL) {
+        last = i;
+    } else if (mask->kind == ATTENTION_MASK_SLIDING_WINDOW) {
+        if (i < mask->n_global) {
+            *lo = 0;
+            *hi = bk;
+            return true;
+        }
+        if (j0 < mask->n_global) return false;
+        first = (i > mask->window) ? i - mask->window : 0;
+        last = i + mask->window;
+    } else {
+        return false;
+    }
+    
+    *lo = (first > j0) ? (first - j0 < bk ? first - j0 : bk) : 0;
+    *hi = (last < j0) ? 0 : (last - j0 + 1 < bk ? last - j0 + 1 : bk);
+    if (*hi < *lo) *hi = *lo;
+    return true;
+}
+
+/**
+ * Classify the tile of queries [i0, i1) x keys [j0, j1) (absolute indices)
+ */
+static tile_coverage_t mask_tile_coverage(const attention_mask_t* mask, size_t n_kv,
+                                          size_t i0, size_t i1, size_t j0, size_t j1) {
+    if (!mask || mask->kind == ATTENTION_MASK_NONE) return TILE_FULL;
+    
+    if (mask->kind == ATTENTION_MASK_CAUSAL) {
+        if (j0 > i1 - 1) return TILE_EMPTY;
+        if (j1 - 1 <= i0) return TILE_FULL;
+        return TILE_PARTIAL;
+    }
+    
+    if (mask->kind == ATTENTION_MASK_SLIDING_WINDOW) {
+        // Tiles made only of global rows or columns are fully visible
+        if (i1 <= mask->n_global || j1 <= mask->n_global) return TILE_FULL;
+        bool touches_global = i0 < mask->n_global || j0 < mask->n_global;
+        size_t w = mask->window;
+    
+        if (j1 - 1 + w < i0 || j0 > i1 - 1 + w) {
+            return touches_global ? TILE_PARTIAL : TILE_EMPTY;
+        }
+        if (j0 + w >= i1 - 1 && j1 - 1 <= i0 + w) return TILE_FULL;
+        return TILE_PARTIAL;
+    }
+    
+    // A summarized boolean mask is read per row, otherwise boolean masks are
+    // scanned per entry and block-sparse masks per block
+    if (mask->kind == ATTENTION_MASK_BOOLEAN && mask->tile_summary) {
+        bool any_empty = false;
+        bool any_full = false;
+        for (size_t i = i0; i < i1; i++) {
+            tile_coverage_t coverage = mask_row_tile(mask, n_kv, i, j0);
+            if (coverage == TILE_PARTIAL) return TILE_PARTIAL;
+            any_empty |= coverage == TILE_EMPTY;
+            any_full |= coverage == TILE_FULL;
+        }
+        if (!any_full) return TILE_EMPTY;
+        return any_empty ? TILE_PARTIAL : TILE_FULL;
+    }
+    
+    size_t step = (mask->kind == ATTENTION_MASK_BLOCK_SPARSE) ? mask->block_size : 1;
+    size_t any = 0;
+    size_t total = 0;
+    for (size_t i = i0; i < i1; i = (i / step + 1) * step) {
+        for (size_t j = j0; j < j1; j = (j / step + 1) * step) {
+            any += mask_allows(mask, n_kv, i, j);
+            total++;
+        }
+    }
+    if (any == 0) return TILE_EMPTY;
+    return (any == total) ? TILE_FULL : TILE_PARTIAL;
+}
+
+bool attention_flash_kernel_masked(const attention_view_t* query,
+                                   const attention_view_t* key,
+                                   const attention_view_t* value,
+                                   const attention_mask_t* mask,
+                                   float* out, size_t ld_out,
+                                   float* workspace) {
+    if (!query || !key || !value || !out) return false;
+    if (key->cols != query->cols || value->rows != key->rows) return false;
+    if (mask && (mask->kind == ATTENTION_MASK_BOOLEAN ||
+                 mask->kind == ATTENTION_MASK_BLOCK_SPARSE)) {
+        if (!mask->mask) return false;
+        if (mask->kind == ATTENTION_MASK_BLOCK_SPARSE && mask->block_size == 0) return false;
+    }
+    
+    size_t d = query->cols;
+    size_t d_v = value->cols;
+    size_t n_q = query->rows;
+    size_t n_kv = key->rows;
+    size_t row_offset = mask ? mask->row_offset : 0;
+    
+    float* owned = NULL;
+    if (!workspace) {
+        owned = (float*)malloc(attention_flash_workspace_size(d, d_v) * sizeof(float));
+        if (!owned) return false;
+        workspace = owned;
+    }
+    
+    float* q_tile = workspace;
+    float* k_tile = q_tile + FLASH_BLOCK_Q * d;
+    float* v_tile = k_tile + FLASH_BLOCK_KV * d;
+    float* scores = v_tile + FLASH_BLOCK_KV * d_v;
+    float* acc = scores + FLASH_BLOCK_Q * FLASH_BLOCK_KV;
+    float* row_max = acc + FLASH_BLOCK_Q * d_v;
+    float* row_sum = row_max + FLASH_BLOCK_Q;
+    
+    float scale = (d > 0) ? 1.0f / sqrtf((float)d) : 1.0f;
+    
+    for (size_t i0 = 0; i0 < n_q; i0 += FLASH_BLOCK_Q) {
+        size_t bq = (i0 + FLASH_BLOCK_Q < n_q) ? FLASH_BLOCK_Q : n_q - i0;
+        size_t abs_i0 = row_offset + i0;
+    
+        view_load_rows(query, i0, bq, q_tile);
+        memset(acc, 0, bq * d_v * sizeof(float));
+        for (size_t r = 0; r < bq; r++) {
+            row_max[r] = -INFINITY;
+            row_sum[r] = 0.0f;
+        }
+    
+        // Stream key/value blocks, rescaling the accumulators as the max grows
+        for (size_t j0 = 0; j0 < n_kv; j0 += FLASH_BLOCK_KV) {
+            size_t bk = (j0 + FLASH_BLOCK_KV < n_kv) ? FLASH_BLOCK_KV : n_kv - j0;
+    
+            tile_coverage_t coverage = mask_tile_coverage(mask, n_kv, abs_i0, abs_i0 + bq,
+                                                          j0, j0 + bk);
+            if (coverage == TILE_EMPTY) continue;
+    
+            view_load_rows(key, j0, bk, k_tile);
+            view_load_rows(value, j0, bk, v_tile);
+    
+            for (size_t r = 0; r < bq; r++) {
+                const float* q_row = q_tile + r * d;
+                float* s_row = scores + r * FLASH_BLOCK_KV;
+    
+                // Banded masks give a contiguous span of allowed columns per row
+                size_t c_lo = 0;
+                size_t c_hi = bk;
+                bool check_each = coverage == TILE_PARTIAL &&
+                                  !mask_row_span(mask, n_kv, abs_i0 + r, j0, bk, &c_lo, &c_hi);
+    
+                for (size_t c = 0; c < c_lo; c++) {
+                    s_row[c] = -INFINITY;
+                }
+                for (size_t c = c_hi; c < bk; c++) {
+                    s_row[c] = -INFINITY;
+                }
+    
+                float tile_max = -INFINITY;
+                for (size_t c = c_lo; c < c_hi; c++) {
+                    if (check_each && !mask_allows(mask, n_kv, abs_i0 + r, j0 + c)) {
+                        s_row[c] = -INFINITY;
+                        continue;
+                    }
+                    const float* k_row = k_tile + c * d;
+                    float dot = 0.0f;
+                    for (size_t e = 0; e < d; e++) {
+                        dot += q_row[e] * k_row[e];
+                    }
+                    s_row[c] = dot * scale;
+                    if (s_row[c] > tile_max) tile_max = s_row[c];
+                }
+    
+                // Nothing allowed for this row yet
+                if (tile_max == -INFINITY && row_max[r] == -INFINITY) continue;
+    
+                float new_max = (tile_max > row_max[r]) ? tile_max : row_max[r];
+                float correction = expf(row_max[r] - new_max);
+    
+                float tile_sum = 0.0f;
+                for (size_t c = c_lo; c < c_hi; c++) {
+                    s_row[c] = expf(s_row[c] - new_max);
+                    tile_sum += s_row[c];
+                }
+                row_sum[r] = row_sum[r] * correction + tile_sum;
+                row_max[r] = new_max;
+    
+                float* acc_row = acc + r * d_v;
+                if (correction != 1.0f) {
+                    for (size_t e = 0; e < d_v; e++) {
+                        acc_row[e] *= correction;
+                    }
+                }
+                for (size_t c = c_lo; c < c_hi; c++) {
+                    float p = s_row[c];
+                    if (p == 0.0f) continue;
+                    const float* v_row = v_tile + c * d_v;
+                    for (size_t e = 0; e < d_v; e++) {
+                        acc_row[e] += p * v_row[e];
+                    }
+                }
+            }
+        }
+    
+        for (size_t r = 0; r < bq; r++) {
+            float inv_sum = (row_sum[r] > 0.0f) ? 1.0f / row_sum[r] : 0.0f;
+            const float* acc_row = acc + r * d_v;
+            float* out_row = out + (i0 + r) * ld_out;
+            for (size_t e = 0; e < d_v; e++) {
+                out_row[e] = acc_row[e] * inv_sum;
+            }
+        }
+    }
+    
+    free(owned);
+    return true;
+}
+
+bool attention_flash_kernel(const attention_view_t* query,
+                            const attention_view_t* key,
+                            const attention_view_t* value,
+                            float* out, size_t ld_out,
+                            float* workspace) {
+    return attention_flash_kernel_masked(query, key, value, NULL, out, ld_out, workspace);
+}
+
+/**
+ * Shared state for the query-chunk tasks of attention_masked
+ */
+typedef struct {
+    attention_view_t query;
+    attention_view_t key;
+    attention_view_t value;
+    const attention_mask_t* mask;
+    float* out;
+    size_t n_chunks;
+    atomic_bool failed;
+} flash_job_t;
+
+static void flash_chunk_task(void* ctx, size_t chunk) {
+    flash_job_t* job = (flash_job_t*)ctx;
+    
+    size_t n_q = job->query.rows;
+    size_t row0 = chunk * n_q / job->n_chunks;
+    size_t row1 = (chunk + 1) * n_q / job->n_chunks;
+    if (row1 == row0) return;
+    
+    attention_view_t rows = job->query;
+    rows.data += row0 * rows.row_stride;
+    rows.rows = row1 - row0;
+    
+    // The chunk's first query is row0 of the full problem
+    attention_mask_t mask = {ATTENTION_MASK_NONE, NULL, 0, 0, 0, 0, NULL};
+    if (job->mask) mask = *job->mask;
+    mask.row_offset += row0;
+    
+    size_t d_v = job->value.cols;
+    if (!attention_flash_kernel_masked(&rows, &job->key, &job->value, &mask,
+                                       job->out + row0 * d_v, d_v, NULL)) {
+        atomic_store(&job->failed, true);
+    }
+}
+
+neural_tensor_t* attention_masked(const neural_tensor_t* query,
+                                  const neural_tensor_t* key,
+                                  const neural_tensor_t* value,
+                                  const attention_mask_t* mask) {
+    if (!query || !key || !value) return NULL;
+    if (query->n_dims != 2 || key->n_dims != 2 || value->n_dims != 2) return NULL;
+    if (query->shape[1] != key->shape[1] || key->shape[0] != value->shape[0]) return NULL;
+    
+    size_t out_shape[2] = {query->shape[0], value->shape[1]};
+    neural_tensor_t* output = neural_tensor_create(out_shape, 2);
+    if (!output) return NULL;
+    
+    // One chunk of whole query blocks per thread
+    size_t n_blocks = (query->shape[0] + FLASH_BLOCK_Q - 1) / FLASH_BLOCK_Q;
+    size_t n_chunks = neural_parallel_get_threads();
+    if (n_chunks > n_blocks) n_chunks = n_blocks;
+    if (n_chunks == 0) n_chunks = 1;
+    
+    // Summarize an unsummarized boolean mask once for every chunk to share
+    attention_mask_t summarized;
+    uint8_t* summary = NULL;
+    if (mask && mask->kind == ATTENTION_MASK_BOOLEAN && mask->mask && !mask->tile_summary &&
+        mask->row_offset == 0 && key->shape[0] > 0) {
+        summary = attention_mask_summarize(mask->mask, query->shape[0], key->shape[0]);
+        if (summary) {
+            summarized = *mask;
+            summarized.tile_summary = summary;
+            mask = &summarized;
+        }
+    }
+    
+    flash_job_t job = {
+        attention_view_of(query), attention_view_of(key), attention_view_of(value),
+        mask, output->data, n_chunks, false
+    };
+    neural_parallel_for(n_chunks, flash_chunk_task, &job);
+    free(summary);
+    
+    if (atomic_load(&job.failed)) {
+        neural_tensor_free(output);
+        return NULL;
+    }
+    return output;
+}
+
+neural_tensor_t* attention_flash(const neural_tensor_t* query,
+                                 const neural_tensor_t* key,
+                                 const neural_tensor_t* value) {
+    return attention_masked(query, key, value, NULL);
+}
+
+neural_tensor_t* attention_windowed(const neural_tensor_t* query,
+                                    const neural_tensor_t* key,
+                                    const neural_tensor_t* value,
+                                    size_t window, size_t n_global) {
+    attention_mask_t mask = {ATTENTION_MASK_SLIDING_WINDOW, NULL, 0, window, n_global, 0, NULL};
+    return attention_masked(query, key, value, &mask);
+}
+
+// ============================================================================
+// KEY/VALUE CACHE IMPLEMENTATION
+// ============================================================================
+
+attention_kv_cache_t* attention_kv_cache_create(size_t capacity, size_t dim_key,
+                                                size_t dim_value,
+                                                attention_kv_policy_t policy) {
+    if (capacity == 0) return NULL;
+    
+    attention_kv_cache_t* cache = (attention_kv_cache_t*)calloc(1, sizeof(attention_kv_cache_t));
+    if (!cache) return NULL;
+    
+    cache->capacity = capacity;
+    cache->dim_key = dim_key;
+    cache->dim_value = dim_value;
+    cache->policy = policy;
+    
+    cache->keys = (float*)calloc(capacity * dim_key + 1, sizeof(float));
+    cache->values = (float*)calloc(capacity * dim_value + 1, sizeof(float));
+    cache->attention_mass = (float*)calloc(capacity, sizeof(float));
+    cache->inserted_at = (size_t*)calloc(capacity, sizeof(size_t));
+    cache->scores = (float*)malloc(capacity * sizeof(float));
+    cache->query_row = (float*)malloc((dim_key + 1) * sizeof(float));
+    cache->heads_row = (float*)malloc((dim_value + 1) * sizeof(float));
+    
+    if (!cache->keys || !cache->values || !cache->attention_mass || !cache->inserted_at ||
+        !cache->scores || !cache->query_row || !cache->heads_row) {
+        attention_kv_cache_free(cache);
+        return NULL;
+    }
+    
+    return cache;
+}
+
+void attention_kv_cache_free(attention_kv_cache_t* cache) {
+    if (cache) {
+        free(cache->keys);
+        free(cache->values);
+        free(cache->attention_mass);
+        free(cache->inserted_at);
+        free(cache->scores);
+        free(cache->query_row);
+        free(cache->heads_row);
+        free(cache);
+    }
+}
+
+void attention_kv_cache_reset(attention_kv_cache_t* cache) {
+    if (!cache) return;
+    
+    cache->length = 0;
+    cache->oldest = 0;
+    cache->n_queries = 0;
+}
+
+/**
+ * Pick the slot for a new entry, evicting if needed (SIZE_MAX if rejected)
+ */
+static size_t kv_cache_reserve(attention_kv_cache_t* cache) {
+    size_t slot;
+    
+    if (cache->length < cache->capacity) {
+        slot = cache->length++;
+    } else if (cache->policy == ATTENTION_KV_EVICT_OLDEST) {
+        slot = cache->oldest;
+        cache->oldest = (cache->oldest + 1) % cache->capacity;
+    } else if (cache->policy == ATTENTION_KV_EVICT_LEAST_ATTENDED) {
+        // Lowest attention per query since insertion. Entries not queried yet
+        // are kept; when no entry has been queried, slots go round-robin
+        slot = SIZE_MAX;
+        float lowest = INFINITY;
+        for (size_t i = 0; i < cache->length; i++) {
+            size_t age = cache->n_queries - cache->inserted_at[i];
+            if (age == 0) continue;
+            float mean = cache->attention_mass[i] / (float)age;
+            if (mean < lowest) {
+                lowest = mean;
+                slot = i;
+            }
+        }
+        if (slot == SIZE_MAX) {
+            slot = cache->oldest;
+            cache->oldest = (cache->oldest + 1) % cache->capacity;
+        }
+    } else {
+        return SIZE_MAX;
+    }
+    
+    cache->attention_mass[slot] = 0.0f;
+    cache->inserted_at[slot] = cache->n_queries;
+    return slot;
+}
+
+bool attention_kv_cache_append(attention_kv_cache_t* cache,
+                               const float* key, const float* value) {
+    if (!cache || !key || !value) return false;
+    
+    size_t slot = kv_cache_reserve(cache);
+    if (slot == SIZE_MAX) return false;
+    
+    memcpy(cache->keys + slot * cache->dim_key, key, cache->dim_key * sizeof(float));
+    memcpy(cache->values + slot * cache->dim_value, value, cache->dim_value * sizeof(float));
+    return true;
+}
+
+bool attention_kv_cache_attend(attention_kv_cache_t* cache, const float* query,
+                               size_t n_heads, float* out) {
+    if (!cache || !query || !out) return false;
+    if (n_heads == 0) n_heads = 1;
+    
+    size_t n = cache->length;
+    size_t d_k = cache->dim_key;
+    size_t d_v = cache->dim_value;
+    float* scores = cache->scores;
+    
+    memset(out, 0, d_v * sizeof(float));
+    cache->n_queries++;
+    if (n == 0) return true;
+    
+    for (size_t h = 0; h < n_heads; h++) {
+        size_t k0 = h * d_k / n_heads;
+        size_t k1 = (h + 1) * d_k / n_heads;
+        size_t v0 = h * d_v / n_heads;
+        size_t v1 = (h + 1) * d_v / n_heads;
+        if (k1 == k0) continue;
+        
+        float scale = 1.0f / sqrtf((float)(k1 - k0));
+        float max_score = -INFINITY;
+        for (size_t j = 0; j < n; j++) {
+            const float* k_row = cache->keys + j * d_k;
+            float dot = 0.0f;
+            for (size_t e = k0; e < k1; e++) {
+                dot += query[e] * k_row[e];
+            }
+            scores[j] = dot * scale;
+            if (scores[j] > max_score) max_score = scores[j];
+        }
+        
+        float sum = 0.0f;
+        for (size_t j = 0; j < n; j++) {
+            scores[j] = expf(scores[j] - max_score);
+            sum += scores[j];
+        }
+        
+        float inv_sum = 1.0f / sum;
+        float head_share = 1.0f / (float)n_heads;
+        for (size_t j = 0; j < n; j++) {
+            float p = scores[j] * inv_sum;
+            cache->attention_mass[j] += p * head_share;
+            const float* v_row = cache->values + j * d_v;
+            for (size_t e = v0; e < v1; e++) {
+                out[e] += p * v_row[e];
+            }
+        }
+    }
+    
+    return true;
+}
+
+/**
+ * Row vector times matrix: out[cols] = x[rows] * W[rows, cols]
+ */
+static void project_row(const float* x, const float* W, size_t rows, size_t cols,
+                        float* out) {
+    memset(out, 0, cols * sizeof(float));
+    for (size_t i = 0; i < rows; i++) {
+        float xi = x[i];
+        const float* w_row = W + i * cols;
+        for (size_t j = 0; j < cols; j++) {
+            out[j] += xi * w_row[j];
+        }
+    }
+}
+
+bool attention_incremental(const attention_state_t* state,
+                           attention_kv_cache_t* cache,
+                           const float* input, float* output) {
+    if (!state || !cache || !input || !output) return false;
+    
+    size_t dim_model = state->query->shape[0];
+    size_t dim_key = state->query->shape[1];
+    if (cache->dim_key != dim_key || cache->dim_value != dim_key) return false;
+    
+    size_t slot = kv_cache_reserve(cache);
+    if (slot == SIZE_MAX) return false;
+    
+    // Project the new row straight into its cache slot
+    project_row(input, state->key->data, dim_model, dim_key, cache->keys + slot * dim_key);
+    project_row(input, state->value->data, dim_model, dim_key, cache->values + slot * dim_key);
+    project_row(input, state->query->data, dim_model, dim_key, cache->query_row);
+    
+    attention_kv_cache_attend(cache, cache->query_row, state->n_heads, cache->heads_row);
+    
+    project_row(cache->heads_row, state->attention_weights->data, dim_key, dim_model, output);
+    return true;
+}
+
+// ============================================================================
+// LINEAR (KERNELIZED) ATTENTION IMPLEMENTATION
+// ============================================================================
+
+/**
+ * Standard normal sample from an xorshift state (Box-Muller)
+ */
+static float feature_map_gaussian(uint32_t* rng) {
+    float u[2];
+    for (int t = 0; t < 2; t++) {
+        *rng ^= *rng << 13;
+        *rng ^= *rng >> 17;
+        *rng ^= *rng << 5;
+        u[t] = ((float)(*rng >> 8) + 1.0f) / 16777217.0f;
+    }
+    return sqrtf(-2.0f * logf(u[0])) * cosf(6.28318530718f * u[1]);
+}
+
+attention_feature_map_t* attention_feature_map_create(size_t dim, size_t n_features,
+                                                      unsigned int seed) {
+    if (dim == 0 || n_features == 0) return NULL;
+    
+    attention_feature_map_t* map = (attention_feature_map_t*)calloc(1, sizeof(attention_feature_map_t));
+    if (!map) return NULL;
+    
+    map->dim = dim;
+    map->n_features = n_features;
+    map->projection = (float*)malloc(n_features * dim * sizeof(float));
+    if (!map->projection) {
+        attention_feature_map_free(map);
+        return NULL;
+    }
+    
+    uint32_t rng = seed ? (uint32_t)seed : 0x9E3779B9u;
+    for (size_t i = 0; i < n_features * dim; i++) {
+        map->projection[i] = feature_map_gaussian(&rng);
+    }
+    
+    return map;
+}
+
+void attention_feature_map_free(attention_feature_map_t* map) {
+    if (map) {
+        free(map->projection);
+        free(map);
+    }
+}
+
+/**
+ * Log-features of one row: out[r] = w_r . x' - |x'|^2 / 2; returns their maximum
+ * The common 1/sqrt(n_features) factor cancels in the attention ratio and is
+ * dropped, as is any constant shift applied to every key (or to one query).
+ */
+static float feature_map_exponents(const attention_feature_map_t* map, const float* x,
+                                   float* out) {
+    size_t dim = map->dim;
+    float scale = 1.0f / sqrtf(sqrtf((float)dim));
+    
+    float norm = 0.0f;
+    for (size_t e = 0; e < dim; e++) {
+        norm += x[e] * x[e];
+    }
+    float half_norm = 0.5f * norm * scale * scale;
+    
+    float max_exp = -INFINITY;
+    for (size_t r = 0; r < map->n_features; r++) {
+        const float* w = map->projection + r * dim;
+        float dot = 0.0f;
+        for (size_t e = 0; e < dim; e++) {
+            dot += w[e] * x[e];
+        }
+        out[r] = dot * scale - half_norm;
+        if (out[r] > max_exp) max_exp = out[r];
+    }
+    
+    return max_exp;
+}
+
+/**
+ * out[d_v] = phi(q) . kv_sum / phi(q) . k_sum (zeros if the denominator vanishes)
+ */
+static void linear_attend_row(const attention_feature_map_t* map, const float* kv_sum,
+                              const float* k_sum, size_t d_v, const float* query,
+                              float* features, float* out) {
+    size_t r_count = map->n_features;
+    float max_exp = feature_map_exponents(map, query, features);
+    
+    memset(out, 0, d_v * sizeof(float));
+    float denom = 0.0f;
+    for (size_t r = 0; r < r_count; r++) {
+        float phi = expf(features[r] - max_exp);
+        denom += phi * k_sum[r];
+        const float* kv_row = kv_sum + r * d_v;
+        for (size_t e = 0; e < d_v; e++) {
+            out[e] += phi * kv_row[e];
+        }
+    }
+    
+    if (denom <= 0.0f) {
+        memset(out, 0, d_v * sizeof(float));
+        return;
+    }
+    float inv = 1.0f / denom;
+    for (size_t e = 0; e < d_v; e++) {
+        out[e] *= inv;
+    }
+}
+
+/**
+ * Accumulate kv_sum [n_features, d_v] and k_sum [n_features] over all keys
+ * Every key is shifted by the same (global maximum) exponent.
+ */
+static bool linear_summarize(const attention_feature_map_t* map,
+                             const neural_tensor_t* key, const neural_tensor_t* value,
+                             float* kv_sum, float* k_sum) {
+    size_t m = key->shape[0];
+    size_t r_count = map->n_features;
+    size_t d_v = value->shape[1];
+    
+    float* exponents = (float*)malloc((m * r_count + 1) * sizeof(float));
+    if (!exponents) return false;
+    
+    float reference = -INFINITY;
+    for (size_t j = 0; j < m; j++) {
+        float row_max = feature_map_exponents(map, key->data + j * map->dim,
+                                              exponents + j * r_count);
+        if (row_max > reference) reference = row_max;
+    }
+    
+    memset(kv_sum, 0, r_count * d_v * sizeof(float));
+    memset(k_sum, 0, r_count * sizeof(float));
+    for (size_t j = 0; j < m; j++) {
+        const float* v_row = value->data + j * d_v;
+        for (size_t r = 0; r < r_count; r++) {
+            float phi = expf(exponents[j * r_count + r] - reference);
+            k_sum[r] += phi;
+            float* kv_row = kv_sum + r * d_v;
+            for (size_t e = 0; e < d_v; e++) {
+                kv_row[e] += phi * v_row[e];
+            }
+        }
+    }
+    
+    free(exponents);
+    return true;
+}
+
+static bool linear_shapes_match(const attention_feature_map_t* map,
+                                const neural_tensor_t* query,
+                                const neural_tensor_t* key,
+                                const neural_tensor_t* value) {
+    if (!map || !query || !key || !value) return false;
+    if (query->n_dims != 2 || key->n_dims != 2 || value->n_dims != 2) return false;
+    return query->shape[1] == map->dim && key->shape[1] == map->dim &&
+           key->shape[0] == value->shape[0];
+}
+
+typedef struct {
+    const attention_feature_map_t* map;
+    const float* kv_sum;
+    const float* k_sum;
+    const neural_tensor_t* query;
+    float* out;
+    size_t d_v;
+    size_t n_chunks;
+    atomic_bool failed;
+} linear_job_t;
+
+static void linear_chunk_task(void* ctx, size_t chunk) {
+    linear_job_t* job = (linear_job_t*)ctx;
+    
+    size_t n = job->query->shape[0];
+    size_t row0 = chunk * n / job->n_chunks;
+    size_t row1 = (chunk + 1) * n / job->n_chunks;
+    if (row1 == row0) return;
+    
+    float* features = (float*)malloc(job->map->n_features * sizeof(float));
+    if (!features) {
+        atomic_store(&job->failed, true);
+        return;
+    }
+    
+    for (size_t i = row0; i < row1; i++) {
+        linear_attend_row(job->map, job->kv_sum, job->k_sum, job->d_v,
+                          job->query->data + i * job->map->dim, features,
+                          job->out + i * job->d_v);
+    }
+    
+    free(features);
+}
+
+neural_tensor_t* attention_linear(const attention_feature_map_t* map,
+                                  const neural_tensor_t* query,
+                                  const neural_tensor_t* key,
+                                  const neural_tensor_t* value) {
+    if (!linear_shapes_match(map, query, key, value)) return NULL;
+    
+    size_t d_v = value->shape[1];
+    float* kv_sum = (float*)malloc((map->n_features * d_v + 1) * sizeof(float));
+    float* k_sum = (float*)malloc(map->n_features * sizeof(float));
+    size_t out_shape[2] = {query->shape[0], d_v};
+    neural_tensor_t* output = neural_tensor_create(out_shape, 2);
+    
+    if (!kv_sum || !k_sum || !output || !linear_summarize(map, key, value, kv_sum, k_sum)) {
+        free(kv_sum);
+        free(k_sum);
+        neural_tensor_free(output);
+        return NULL;
+    }
+    
+    // Query rows are independent once the key summary is built
+    size_t n_chunks = neural_parallel_get_threads();
+    if (n_chunks > query->shape[0]) n_chunks = query->shape[0];
+    if (n_chunks == 0) n_chunks = 1;
+    
+    linear_job_t job = {map, kv_sum, k_sum, query, output->data, d_v, n_chunks, false};
+    neural_parallel_for(n_chunks, linear_chunk_task, &job);
+    
+    free(kv_sum);
+    free(k_sum);
+    
+    if (atomic_load(&job.failed)) {
+        neural_tensor_free(output);
+        return NULL;
+    }
+    return output;
+}
+
+float attention_linear_error(const attention_feature_map_t* map,
+                             const neural_tensor_t* query,
+                             const neural_tensor_t* key,
+                             const neural_tensor_t* value,
+                             size_t n_samples) {
+    if (!linear_shapes_match(map, query, key, value)) return -1.0f;
+    
+    size_t n = query->shape[0];
+    size_t d_v = value->shape[1];
+    if (n == 0) return 0.0f;
+    if (n_samples == 0 || n_samples > n) n_samples = n;
+    size_t step = n / n_samples;
+    
+    float* kv_sum = (float*)malloc((map->n_features * d_v + 1) * sizeof(float));
+    float* k_sum = (float*)malloc(map->n_features * sizeof(float));
+    float* features = (float*)malloc(map->n_features * sizeof(float));
+    float* approx = (float*)malloc((n_samples * d_v + 1) * sizeof(float));
+    float* exact = (float*)malloc((n_samples * d_v + 1) * sizeof(float));
+    
+    float error = -1.0f;
+    if (kv_sum && k_sum && features && approx && exact &&
+        linear_summarize(map, key, value, kv_sum, k_sum)) {
+        // Sampled rows as one strided view, so exact attention is O(samples * m)
+        attention_view_t rows = attention_view_of(query);
+        rows.rows = n_samples;
+        rows.row_stride *= step;
+        attention_view_t k_view = attention_view_of(key);
+        attention_view_t v_view = attention_view_of(value);
+    
+        if (attention_flash_kernel(&rows, &k_view, &v_view, exact, d_v, NULL)) {
+            double diff = 0.0;
+            double norm = 0.0;
+            for (size_t s = 0; s < n_samples; s++) {
+                float* a_row = approx + s * d_v;
+                const float* e_row = exact + s * d_v;
+                linear_attend_row(map, kv_sum, k_sum, d_v, query->data + s * step * map->dim,
+                                  features, a_row);
+                for (size_t e = 0; e < d_v; e++) {
+                    double delta = (double)a_row[e] - (double)e_row[e];
+                    diff += delta * delta;
+                    norm += (double)e_row[e] * (double)e_row[e];
+                }
+            }
+            error = (norm > 0.0) ? (float)sqrt(diff / norm) : (float)sqrt(diff);
+        }
+    }
+    
+    free(kv_sum);
+    free(k_sum);
+    free(features);
+    free(approx);
+    free(exact);
+    return error;
+}
+
+attention_linear_state_t* attention_linear_state_create(const attention_feature_map_t* map,
+                                                        size_t dim_value) {
+    if (!map || dim_value == 0) return NULL;
+    
+    attention_linear_state_t* state = (attention_linear_state_t*)calloc(1, sizeof(attention_linear_state_t));
+    if (!state) return NULL;
+    
+    state->map = map;
+    state->dim_value = dim_value;
+    state->kv_sum = (float*)calloc(map->n_features * dim_value, sizeof(float));
+    state->k_sum = (float*)calloc(map->n_features, sizeof(float));
+    state->features = (float*)malloc(map->n_features * sizeof(float));
+    
+    if (!state->kv_sum || !state->k_sum || !state->features) {
+        attention_linear_state_free(state);
+        return NULL;
+    }
+    
+    return state;
+}
+
+void attention_linear_state_free(attention_linear_state_t* state) {
+    if (state) {
+        free(state->kv_sum);
+        free(state->k_sum);
+        free(state->features);
+        free(state);
+    }
+}
+
+bool attention_linear_state_append(attention_linear_state_t* state,
+                                   const float* key, const float* value) {
+    if (!state || !key || !value) return false;
+    
+    const attention_feature_map_t* map = state->map;
+    size_t r_count = map->n_features;
+    size_t d_v = state->dim_value;
+    float max_exp = feature_map_exponents(map, key, state->features);
+    
+    // Keep one shift for every accumulated key, rescaling the sums when it grows
+    if (state->length == 0) {
+        state->reference = max_exp;
+    } else if (max_exp > state->reference) {
+        float rescale = expf(state->reference - max_exp);
+        for (size_t i = 0; i < r_count * d_v; i++) {
+            state->kv_sum[i] *= rescale;
+        }
+        for (size_t r = 0; r < r_count; r++) {
+            state->k_sum[r] *= rescale;
+        }
+        state->reference = max_exp;
+    }
+    
+    for (size_t r = 0; r < r_count; r++) {
+        float phi = expf(state->features[r] - state->reference);
+        state->k_sum[r] += phi;
+        float* kv_row = state->kv_sum + r * d_v;
+        for (size_t e = 0; e < d_v; e++) {
+            kv_row[e] += phi * value[e];
+        }
+    }
+    
+    state->length++;
+    return true;
+}
+
+bool attention_linear_state_attend(attention_linear_state_t* state,
+                                   const float* query, float* out) {
+    if (!state || !query || !out) return false;
+    
+    linear_attend_row(state->map, state->kv_sum, state->k_sum, state->dim_value,
+                      query, state->features, out);
+    return true;
+}
+
+// ============================================================================
+// ATTENTION PLANS IMPLEMENTATION
+// ============================================================================
+
+#define ATTENTION_PLAN_CACHE_SIZE 8
+
+static pthread_mutex_t plan_lock = PTHREAD_MUTEX_INITIALIZER;
+static attention_plan_t* plan_cache[ATTENTION_PLAN_CACHE_SIZE];
+static unsigned long plan_tick = 0;
+
+static void attention_plan_free(attention_plan_t* plan) {
+    if (plan) {
+        attention_free(plan->state);
+        free(plan->scratch);
+        free(plan);
+    }
+}
+
+static attention_plan_t* attention_plan_create(size_t n_heads, size_t dim_model,
+                                               size_t dim_key) {
+    attention_plan_t* plan = (attention_plan_t*)calloc(1, sizeof(attention_plan_t));
+    if (!plan) return NULL;
+    
+    plan->state = attention_create(n_heads, dim_model, dim_key);
+    if (!plan->state) {
+        attention_plan_free(plan);
+        return NULL;
+    }
+    plan->n_heads = plan->state->n_heads;
+    plan->dim_model = dim_model;
+    plan->dim_key = dim_key;
+    
+    return plan;
+}
+
+attention_plan_t* attention_plan_acquire(size_t n_heads, size_t dim_model, size_t dim_key) {
+    if (n_heads == 0) n_heads = 1;
+    
+    pthread_mutex_lock(&plan_lock);
+    for (size_t i = 0; i < ATTENTION_PLAN_CACHE_SIZE; i++) {
+        attention_plan_t* plan = plan_cache[i];
+        if (plan && plan->n_heads == n_heads && plan->dim_model == dim_model &&
+            plan->dim_key == dim_key) {
+            plan_cache[i] = NULL;
+            pthread_mutex_unlock(&plan_lock);
+            return plan;
+        }
+    }
+    pthread_mutex_unlock(&plan_lock);
+    
+    return attention_plan_create(n_heads, dim_model, dim_key);
+}
+
+void attention_plan_release(attention_plan_t* plan) {
+    if (!plan) return;
+    
+    attention_plan_t* evicted = NULL;
+    
+    pthread_mutex_lock(&plan_lock);
+    plan->last_used = ++plan_tick;
+    
+    size_t slot = 0;
+    for (size_t i = 0; i < ATTENTION_PLAN_CACHE_SIZE; i++) {
+        if (!plan_cache[i]) {
+            slot = i;
+            evicted = NULL;
+            break;
+        }
+        if (!evicted || plan_cache[i]->last_used < evicted->last_used) {
+            evicted = plan_cache[i];
+            slot = i;
+        }
+    }
+    plan_cache[slot] = plan;
+    pthread_mutex_unlock(&plan_lock);
+    
+    attention_plan_free(evicted);
+}
+
+bool attention_plan_execute_into(attention_plan_t* plan,
+                                 const attention_state_t* state,
+                                 const neural_tensor_t* input,
+                                 neural_tensor_t* output) {
+    if (!plan || !input || input->n_dims != 2) return false;
+    
+    if (!state) state = plan->state;
+    if (state->n_heads != plan->n_heads || state->query->shape[0] != plan->dim_model ||
+        state->query->shape[1] != plan->dim_key) return false;
+    
+    // Scratch grows to the largest input seen and is reused afterwards
+    size_t n = input->shape[0];
+    if (!plan->scratch || n > plan->scratch_rows) {
+        float* scratch = (float*)realloc(plan->scratch,
+            attention_multihead_scratch_size(state, n) * sizeof(float));
+        if (!scratch) return false;
+        plan->scratch = scratch;
+        plan->scratch_rows = n;
+    }
+    
+    return attention_multihead_into(state, input, plan->scratch, output);
+}
+
+neural_tensor_t* attention_plan_execute(attention_plan_t* plan,
+                                        const attention_state_t* state,
+                                        const neural_tensor_t* input) {
+    if (!plan || !input || input->n_dims != 2) return NULL;
+    
+    size_t out_shape[2] = {input->shape[0], plan->dim_model};
+    neural_tensor_t* output = neural_tensor_create(out_shape, 2);
+    if (output && !attention_plan_execute_into(plan, state, input, output)) {
+        neural_tensor_free(output);
+        return NULL;
+    }
+    return output;
+}
+
+void attention_plan_cache_clear(void) {
+    pthread_mutex_lock(&plan_lock);
+    for (size_t i = 0; i < ATTENTION_PLAN_CACHE_SIZE; i++) {
+        attention_plan_free(plan_cache[i]);
+        plan_cache[i] = NULL;
+    }
+    pthread_mutex_unlock(&plan_lock);
+}
@@ -0,0 +1,177 @@
+/**
+ * neural_parallel.c
+ *
+ * Persistent pthread pool behind neural_parallel_for
+ */
+
+#include "neural_parallel.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+// ============================================================================
+// POOL STATE
+// ============================================================================
+
+// Held by the caller that owns the pool for the duration of a job
+static pthread_mutex_t pool_lock = PTHREAD_MUTEX_INITIALIZER;
+
+// Protects the job description and worker handshake
+static pthread_mutex_t job_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t job_cond = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t done_cond = PTHREAD_COND_INITIALIZER;
+
+static pthread_t* workers = NULL;
+static size_t n_workers = 0;
+static atomic_size_t requested_threads = 0;    // 0 = number of online processors
+
+static size_t job_generation = 0;
+static size_t job_busy = 0;
+static bool job_stopping = false;
+static neural_task_fn job_fn = NULL;
+static void* job_ctx = NULL;
+static size_t job_tasks = 0;
+static atomic_size_t job_next_task = 0;
+
+static _Thread_local bool in_worker = false;
+
+// ============================================================================
+// WORKERS
+// ============================================================================
+
+static void run_tasks(void) {
+    size_t task;
+    while ((task = atomic_fetch_add(&job_next_task, 1)) < job_tasks) {
+        job_fn(job_ctx, task);
+    }
+}
+
+static void* worker_main(void* arg) {
+    // Generation current when the worker was created; later jobs are picked up
+    size_t seen = (size_t)(uintptr_t)arg;
+    in_worker = true;
+    
+    pthread_mutex_lock(&job_lock);
+    for (;;) {
+        while (!job_stopping && job_generation == seen) {
+            pthread_cond_wait(&job_cond, &job_lock);
+        }
+        if (job_stopping) break;
+        seen = job_generation;
+        pthread_mutex_unlock(&job_lock);
+    
+        run_tasks();
+    
+        pthread_mutex_lock(&job_lock);
+        if (--job_busy == 0) {
+            pthread_cond_signal(&done_cond);
+        }
+    }
+    pthread_mutex_unlock(&job_lock);
+    
+    return NULL;
+}
+
+/**
+ * Join all workers (caller holds pool_lock)
+ */
+static void pool_stop(void) {
+    if (!workers) return;
+    
+    pthread_mutex_lock(&job_lock);
+    job_stopping = true;
+    pthread_cond_broadcast(&job_cond);
+    pthread_mutex_unlock(&job_lock);
+    
+    for (size_t i = 0; i < n_workers; i++) {
+        pthread_join(workers[i], NULL);
+    }
+    free(workers);
+    workers = NULL;
+    n_workers = 0;
+    job_stopping = false;
+}
+
+/**
+ * Make sure n worker threads are running (caller holds pool_lock)
+ */
+static void pool_start(size_t n) {
+    if (workers && n_workers == n) return;
+    pool_stop();
+    if (n == 0) return;
+    
+    workers = (pthread_t*)malloc(n * sizeof(pthread_t));
+    if (!workers) return;
+    
+    void* generation = (void*)(uintptr_t)job_generation;
+    for (size_t i = 0; i < n; i++) {
+        if (pthread_create(&workers[i], NULL, worker_main, generation) != 0) break;
+        n_workers++;
+    }
+    if (n_workers == 0) {
+        free(workers);
+        workers = NULL;
+    }
+}
+
+// ============================================================================
+// PUBLIC INTERFACE
+// ============================================================================
+
+void neural_parallel_set_threads(size_t n_threads) {
+    atomic_store(&requested_threads, n_threads);
+}
+
+size_t neural_parallel_get_threads(void) {
+    size_t n = atomic_load(&requested_threads);
+    if (n == 0) {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        n = (online > 0) ? (size_t)online : 1;
+    }
+    return n;
+}
+
+void neural_parallel_for(size_t n_tasks, neural_task_fn fn, void* ctx) {
+    if (!fn || n_tasks == 0) return;
+    
+    size_t n_threads = neural_parallel_get_threads();
+    if (n_tasks == 1 || n_threads <= 1 || in_worker ||
+        pthread_mutex_trylock(&pool_lock) != 0) {
+        for (size_t task = 0; task < n_tasks; task++) {
+            fn(ctx, task);
+        }
+        return;
+    }
+    
+    pool_start(n_threads - 1);
+    
+    pthread_mutex_lock(&job_lock);
+    job_fn = fn;
+    job_ctx = ctx;
+    job_tasks = n_tasks;
+    atomic_store(&job_next_task, 0);
+    job_busy = n_workers;
+    job_generation++;
+    pthread_cond_broadcast(&job_cond);
+    pthread_mutex_unlock(&job_lock);
+    
+    // The caller works on the job too
+    run_tasks();
+    
+    pthread_mutex_lock(&job_lock);
+    while (job_busy > 0) {
+        pthread_cond_wait(&done_cond, &job_lock);
+    }
+    pthread_mutex_unlock(&job_lock);
+    
+    pthread_mutex_unlock(&pool_lock);
+}
+
+void neural_parallel_shutdown(void) {
+    pthread_mutex_lock(&pool_lock);
+    pool_stop();
+    pthread_mutex_unlock(&pool_lock);
+}
@@ -6,10 +6,15 @@
  */
 
 #include "neural_physics.h"
+#include "neural_attention.h"
+#include "neural_parallel.h"
+#include "cognitive_pipeline.h"
+#include "working_memory.h"
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
 #include <stdio.h>
+#include <sys/mman.h>
 
 // ============================================================================
 // TENSOR OPERATIONS IMPLEMENTATION
@@ -40,44 +45,103 @@ neural_tensor_t* neural_tensor_create(const size_t* shape, size_t n_dims) {
         free(tensor);
         return NULL;
     }
+    tensor->owns_data = true;
+    
+    return tensor;
+}
+
+neural_tensor_t* neural_tensor_wrap(float* data, const size_t* shape, size_t n_dims) {
+    if (!data) return NULL;
+    
+    neural_tensor_t* tensor = (neural_tensor_t*)malloc(sizeof(neural_tensor_t));
+    if (!tensor) return NULL;
+    
+    tensor->n_dims = n_dims;
+    tensor->shape = (size_t*)malloc((n_dims + 1) * sizeof(size_t));
+    if (!tensor->shape) {
+        free(tensor);
+        return NULL;
+    }
+    
+    tensor->total_size = 1;
+    for (size_t i = 0; i < n_dims; i++) {
+        tensor->shape[i] = shape[i];
+        tensor->total_size *= shape[i];
+    }
+    tensor->data = data;
+    tensor->owns_data = false;
     
     return tensor;
 }
 
 void neural_tensor_free(neural_tensor_t* tensor) {
     if (tensor) {
-        if (tensor->data) free(tensor->data);
+        if (tensor->data && tensor->owns_data) free(tensor->data);
         if (tensor->shape) free(tensor->shape);
         free(tensor);
     }
 }
 
+// Cache blocking for the matmul kernel (rows of A, shared dim, columns of B)
+#define MATMUL_BLOCK_M 32
+#define MATMUL_BLOCK_K 128
+#define MATMUL_BLOCK_N 512
+
+/**
+ * Blocked row-major GEMM: C[m, n] = A[m, k] * B[k, n]
+ * The innermost loop runs along contiguous rows of B and C so it vectorizes.
+ */
+static void matmul_kernel(size_t m, size_t n, size_t k,
+                          const float* A, const float* B, float* C) {
+    memset(C, 0, m * n * sizeof(float));
+    
+    for (size_t i0 = 0; i0 < m; i0 += MATMUL_BLOCK_M) {
+        size_t i1 = (i0 + MATMUL_BLOCK_M < m) ? i0 + MATMUL_BLOCK_M : m;
+        for (size_t l0 = 0; l0 < k; l0 += MATMUL_BLOCK_K) {
+            size_t l1 = (l0 + MATMUL_BLOCK_K < k) ? l0 + MATMUL_BLOCK_K : k;
+            for (size_t j0 = 0; j0 < n; j0 += MATMUL_BLOCK_N) {
+                size_t j1 = (j0 + MATMUL_BLOCK_N < n) ? j0 + MATMUL_BLOCK_N : n;
+                for (size_t i = i0; i < i1; i++) {
+                    float* c_row = C + i * n;
+                    for (size_t l = l0; l < l1; l++) {
+                        float a = A[i * k + l];
+                        const float* b_row = B + l * n;
+                        for (size_t j = j0; j < j1; j++) {
+                            c_row[j] += a * b_row[j];
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
 neural_tensor_t* neural_matmul(const neural_tensor_t* A, const neural_tensor_t* B) {
     if (!A || !B || A->n_dims != 2 || B->n_dims != 2) return NULL;
     if (A->shape[1] != B->shape[0]) return NULL;
     
     size_t m = A->shape[0];
     size_t n = B->shape[1];
-    size_t k = A->shape[1];
     
     size_t result_shape[2] = {m, n};
     neural_tensor_t* result = neural_tensor_create(result_shape, 2);
     if (!result) return NULL;
     
-    // Simple matrix multiplication
-    for (size_t i = 0; i < m; i++) {
-        for (size_t j = 0; j < n; j++) {
-            float sum = 0.0f;
-            for (size_t l = 0; l < k; l++) {
-                sum += A->data[i * k + l] * B->data[l * n + j];
-            }
-            result->data[i * n + j] = sum;
-        }
-    }
+    matmul_kernel(m, n, A->shape[1], A->data, B->data, result->data);
     
     return result;
 }
 
+bool neural_matmul_into(const neural_tensor_t* A, const neural_tensor_t* B,
+                        neural_tensor_t* C) {
+    if (!A || !B || !C || A->n_dims != 2 || B->n_dims != 2) return false;
+    if (A->shape[1] != B->shape[0]) return false;
+    if (C->total_size != A->shape[0] * B->shape[1]) return false;
+    
+    matmul_kernel(A->shape[0], B->shape[1], A->shape[1], A->data, B->data, C->data);
+    return true;
+}
+
 neural_tensor_t* neural_add(const neural_tensor_t* A, const neural_tensor_t* B) {
     if (!A || !B || A->total_size != B->total_size) return NULL;
     
@@ -162,15 +226,22 @@ neural_tensor_t* neural_tanh(const neural_tensor_t* input) {
 // ============================================================================
 
 activation_landscape_t* activation_landscape_create(size_t n_nodes) {
-    activation_landscape_t* landscape = (activation_landscape_t*)malloc(sizeof(activation_landscape_t));
+    activation_landscape_t* landscape = (activation_landscape_t*)calloc(1, sizeof(activation_landscape_t));
     if (!landscape) return NULL;
     
     landscape->n_nodes = n_nodes;
     size_t shape[1] = {n_nodes};
     landscape->activations = neural_tensor_create(shape, 1);
     landscape->thresholds = (float*)calloc(n_nodes, sizeof(float));
-    
-    if (!landscape->activations || !landscape->thresholds) {
+    landscape->is_active = (bool*)calloc(n_nodes, sizeof(bool));
+    landscape->active_nodes = (size_t*)malloc(n_nodes * sizeof(size_t));
+    landscape->active_scratch = (size_t*)malloc(n_nodes * sizeof(size_t));
+    landscape->crossings = (activation_crossing_t*)malloc(n_nodes * sizeof(activation_crossing_t));
+    landscape->spread_buffer = (float*)malloc(n_nodes * sizeof(float));
+    
+    if (!landscape->activations || !landscape->thresholds || !landscape->is_active ||
+        !landscape->active_nodes || !landscape->active_scratch || !landscape->crossings ||
+        !landscape->spread_buffer) {
         activation_landscape_free(landscape);
         return NULL;
     }
@@ -187,16 +258,92 @@ void activation_landscape_free(activation_landscape_t* landscape) {
     if (landscape) {
         if (landscape->activations) neural_tensor_free(landscape->activations);
         if (landscape->thresholds) free(landscape->thresholds);
+        free(landscape->is_active);
+        free(landscape->active_nodes);
+        free(landscape->active_scratch);
+        free(landscape->crossings);
+        free(landscape->spread_buffer);
         free(landscape);
     }
 }
 
+/**
+ * Whether a stored value changes, compared bit for bit so that rewriting an
+ * unchanged NaN does not count as a change
+ */
+static bool float_changed(float before, float after) {
+    return memcmp(&before, &after, sizeof(float)) != 0;
+}
+
+/**
+ * Position of the first active node with index >= node (binary search)
+ */
+static size_t landscape_active_lower_bound(const activation_landscape_t* landscape,
+                                           size_t node) {
+    size_t lo = 0;
+    size_t hi = landscape->n_active;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (landscape->active_nodes[mid] < node) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+/**
+ * Write activations for nodes [begin, begin + count) and update the active
+ * set and crossing list in the same pass. With src == NULL the values already
+ * in the landscape are re-evaluated (used after direct writes).
+ */
+static void landscape_commit(activation_landscape_t* landscape, const float* src,
+                             size_t begin, size_t count, float scale) {
+    float* data = landscape->activations->data;
+    const float* thresholds = landscape->thresholds;
+    bool* is_active = landscape->is_active;
+    size_t* scratch = landscape->active_scratch;
+    size_t end = begin + count;
+    
+    landscape->n_crossings = 0;
+    
+    // Active entries outside the written range are kept as they are
+    size_t lo = landscape_active_lower_bound(landscape, begin);
+    size_t hi = landscape_active_lower_bound(landscape, end);
+    
+    size_t n_range = 0;
+    bool changed = false;
+    for (size_t i = begin; i < end; i++) {
+        float value = src ? src[i - begin] * scale : data[i];
+        changed |= float_changed(data[i], value);
+        data[i] = value;
+        
+        bool active = value > thresholds[i];
+        if (active != is_active[i]) {
+            activation_crossing_t* crossing = &landscape->crossings[landscape->n_crossings++];
+            crossing->node = i;
+            crossing->activation = value;
+            crossing->rising = active;
+            is_active[i] = active;
+        }
+        if (active) scratch[n_range++] = i;
+    }
+    
+    size_t n_tail = landscape->n_active - hi;
+    memmove(landscape->active_nodes + lo + n_range, landscape->active_nodes + hi,
+            n_tail * sizeof(size_t));
+    memcpy(landscape->active_nodes + lo, scratch, n_range * sizeof(size_t));
+    landscape->n_active = lo + n_range + n_tail;
+    
+    if (changed) landscape->generation++;
+}
+
 void activation_landscape_update(activation_landscape_t* landscape,
                                 const float* new_activations) {
     if (!landscape || !new_activations) return;
     
-    memcpy(landscape->activations->data, new_activations, 
-           landscape->n_nodes * sizeof(float));
+    landscape_commit(landscape, new_activations, 0, landscape->n_nodes, 1.0f);
 }
 
 void activation_landscape_spread(activation_landscape_t* landscape,
@@ -225,9 +372,7 @@ void activation_landscape_spread(activation_landscape_t* landscape,
                        : landscape->n_nodes;
     
     // Apply decay
-    for (size_t i = 0; i < n_to_copy; i++) {
-        landscape->activations->data[i] = new_activations->data[i] * decay_factor;
-    }
+    landscape_commit(landscape, new_activations->data, 0, n_to_copy, decay_factor);
     
     neural_tensor_free(new_activations);
 }
@@ -236,39 +381,76 @@ size_t* activation_landscape_get_active_nodes(const activation_landscape_t* land
                                               size_t* n_active) {
     if (!landscape || !n_active) return NULL;
     
-    // Count active nodes
-    *n_active = 0;
-    for (size_t i = 0; i < landscape->n_nodes; i++) {
-        if (landscape->activations->data[i] > landscape->thresholds[i]) {
-            (*n_active)++;
-        }
-    }
-    
+    *n_active = landscape->n_active;
     if (*n_active == 0) return NULL;
     
-    // Collect active node indices
+    // Copy the maintained active set
     size_t* active_nodes = (size_t*)malloc(*n_active * sizeof(size_t));
-    size_t idx = 0;
-    for (size_t i = 0; i < landscape->n_nodes; i++) {
-        if (landscape->activations->data[i] > landscape->thresholds[i]) {
-            active_nodes[idx++] = i;
-        }
+    if (!active_nodes) {
+        *n_active = 0;
+        return NULL;
     }
+    memcpy(active_nodes, landscape->active_nodes, *n_active * sizeof(size_t));
     
     return active_nodes;
 }
 
+const size_t* activation_landscape_active_set(const activation_landscape_t* landscape,
+                                              size_t* n_active) {
+    if (!landscape || !n_active) return NULL;
+    
+    *n_active = landscape->n_active;
+    return landscape->active_nodes;
+}
+
+const activation_crossing_t* activation_landscape_crossings(const activation_landscape_t* landscape,
+                                                            size_t* n_crossings) {
+    if (!landscape || !n_crossings) return NULL;
+    
+    *n_crossings = landscape->n_crossings;
+    return landscape->crossings;
+}
+
+void activation_landscape_set_threshold(activation_landscape_t* landscape,
+                                        size_t node, float threshold) {
+    if (!landscape || node >= landscape->n_nodes) return;
+    
+    if (float_changed(landscape->thresholds[node], threshold)) landscape->generation++;
+    landscape->thresholds[node] = threshold;
+    landscape_commit(landscape, NULL, node, 1, 1.0f);
+}
+
+void activation_landscape_sync(activation_landscape_t* landscape) {
+    if (!landscape) return;
+    
+    // Direct writes are not visible to the commit, so always count a change
+    landscape_commit(landscape, NULL, 0, landscape->n_nodes, 1.0f);
+    landscape->generation++;
+}
+
 // ============================================================================
 // ATTENTION MECHANISMS IMPLEMENTATION
 // ============================================================================
 
+/**
+ * Fill a 2-D tensor with a (truncated) identity
+ */
+static void tensor_set_identity(neural_tensor_t* tensor) {
+    size_t rows = tensor->shape[0];
+    size_t cols = tensor->shape[1];
+    memset(tensor->data, 0, tensor->total_size * sizeof(float));
+    for (size_t i = 0; i < rows && i < cols; i++) {
+        tensor->data[i * cols + i] = 1.0f;
+    }
+}
+
 attention_state_t* attention_create(size_t n_heads, size_t dim_model, size_t dim_key) {
     attention_state_t* attention = (attention_state_t*)malloc(sizeof(attention_state_t));
     if (!attention) return NULL;
     
-    attention->n_heads = n_heads;
+    attention->n_heads = (n_heads > 0) ? n_heads : 1;
     
-    size_t shape_weights[2] = {dim_model, dim_model};
+    size_t shape_weights[2] = {dim_key, dim_model};
     attention->attention_weights = neural_tensor_create(shape_weights, 2);
     
     size_t shape_qkv[2] = {dim_model, dim_key};
@@ -282,6 +464,11 @@ attention_state_t* attention_create(size_t n_heads, size_t dim_model, size_t dim
         return NULL;
     }
     
+    tensor_set_identity(attention->attention_weights);
+    tensor_set_identity(attention->query);
+    tensor_set_identity(attention->key);
+    tensor_set_identity(attention->value);
+    
     return attention;
 }
 
@@ -300,46 +487,139 @@ neural_tensor_t* attention_compute(const attention_state_t* state,
                                   const neural_tensor_t* key,
                                   const neural_tensor_t* value) {
     if (!state || !query || !key || !value) return NULL;
+    if (query->n_dims != 2 || key->n_dims != 2 || value->n_dims != 2) return NULL;
     
-    // Compute Q * K^T
-    neural_tensor_t* scores = neural_matmul(query, key);
-    if (!scores) return NULL;
-    
-    // Scale by sqrt(d_k)
-    float scale = 1.0f / sqrtf((float)key->shape[1]);
-    for (size_t i = 0; i < scores->total_size; i++) {
-        scores->data[i] *= scale;
-    }
+    // Key is given as K^T [d_k, n_kv]; the tiled kernel reads it transposed in place
+    attention_view_t q = attention_view_of(query);
+    attention_view_t k = {key->data, key->shape[1], key->shape[0], 1, key->shape[1]};
+    attention_view_t v = attention_view_of(value);
     
-    // Apply softmax
-    neural_tensor_t* attention_weights = neural_softmax(scores);
-    neural_tensor_free(scores);
+    size_t out_shape[2] = {query->shape[0], value->shape[1]};
+    neural_tensor_t* output = neural_tensor_create(out_shape, 2);
+    if (!output) return NULL;
     
-    if (!attention_weights) return NULL;
-    
-    // Multiply by values
-    neural_tensor_t* output = neural_matmul(attention_weights, value);
-    neural_tensor_free(attention_weights);
+    // Scores are streamed block by block and never materialized
+    if (!attention_flash_kernel(&q, &k, &v, output->data, value->shape[1], NULL)) {
+        neural_tensor_free(output);
+        return NULL;
+    }
     
     return output;
 }
 
+/**
+ * Shared state for the per-head tasks of attention_multihead
+ */
+typedef struct {
+    const float* q;
+    const float* k;
+    const float* v;
+    float* heads;       // Concatenated head outputs [n, dim_key]
+    float* workspace;   // One tiled-kernel workspace per head
+    size_t workspace_size;
+    size_t n;
+    size_t dim_key;
+    size_t n_heads;
+} multihead_job_t;
+
+static void multihead_head_task(void* ctx, size_t head) {
+    const multihead_job_t* job = (const multihead_job_t*)ctx;
+    
+    // Head h owns columns [h * dim_key / n_heads, (h + 1) * dim_key / n_heads)
+    size_t col0 = head * job->dim_key / job->n_heads;
+    size_t col1 = (head + 1) * job->dim_key / job->n_heads;
+    if (col1 == col0) return;
+    
+    attention_view_t q = attention_view_columns(job->q, job->n, job->dim_key, col0, col1 - col0);
+    attention_view_t k = attention_view_columns(job->k, job->n, job->dim_key, col0, col1 - col0);
+    attention_view_t v = attention_view_columns(job->v, job->n, job->dim_key, col0, col1 - col0);
+    
+    attention_flash_kernel(&q, &k, &v, job->heads + col0, job->dim_key,
+                           job->workspace + head * job->workspace_size);
+}
+
+/**
+ * Widest head of a dim_key split across n_heads
+ */
+static size_t multihead_head_width(size_t dim_key, size_t n_heads) {
+    return (dim_key + n_heads - 1) / n_heads;
+}
+
+size_t attention_multihead_scratch_size(const attention_state_t* state, size_t n_rows) {
+    if (!state) return 0;
+    
+    size_t dim_key = state->query->shape[1];
+    size_t head_width = multihead_head_width(dim_key, state->n_heads);
+    return 4 * n_rows * dim_key +
+           state->n_heads * attention_flash_workspace_size(head_width, head_width);
+}
+
+bool attention_multihead_into(const attention_state_t* state,
+                              const neural_tensor_t* input,
+                              float* scratch,
+                              neural_tensor_t* output) {
+    if (!state || !input || !scratch || !output || input->n_dims != 2) return false;
+    
+    size_t n = input->shape[0];
+    size_t dim_model = state->query->shape[0];
+    size_t dim_key = state->query->shape[1];
+    if (input->shape[1] != dim_model || output->total_size != n * dim_model) return false;
+    
+    // Q/K/V projections, the concatenated head outputs and head workspaces
+    float* q = scratch;
+    float* k = q + n * dim_key;
+    float* v = k + n * dim_key;
+    float* heads = v + n * dim_key;
+    float* workspace = heads + n * dim_key;
+    
+    matmul_kernel(n, dim_key, dim_model, input->data, state->query->data, q);
+    matmul_kernel(n, dim_key, dim_model, input->data, state->key->data, k);
+    matmul_kernel(n, dim_key, dim_model, input->data, state->value->data, v);
+    memset(heads, 0, n * dim_key * sizeof(float));
+    
+    size_t head_width = multihead_head_width(dim_key, state->n_heads);
+    multihead_job_t job = {
+        q, k, v, heads, workspace,
+        attention_flash_workspace_size(head_width, head_width),
+        n, dim_key, state->n_heads
+    };
+    neural_parallel_for(state->n_heads, multihead_head_task, &job);
+    
+    matmul_kernel(n, dim_model, dim_key, heads, state->attention_weights->data, output->data);
+    return true;
+}
+
 neural_tensor_t* attention_multihead(const attention_state_t* state,
                                     const neural_tensor_t* input) {
-    if (!state || !input) return NULL;
+    if (!state || !input || input->n_dims != 2) return NULL;
+    
+    size_t n = input->shape[0];
+    size_t dim_model = state->query->shape[0];
+    if (input->shape[1] != dim_model) return NULL;
+    
+    float* scratch = (float*)malloc(attention_multihead_scratch_size(state, n) * sizeof(float));
+    if (!scratch) return NULL;
+    
+    size_t out_shape[2] = {n, dim_model};
+    neural_tensor_t* output = neural_tensor_create(out_shape, 2);
+    if (output && !attention_multihead_into(state, input, scratch, output)) {
+        neural_tensor_free(output);
+        output = NULL;
+    }
     
-    // Simplified multi-head attention
-    return attention_compute(state, input, input, input);
+    free(scratch);
+    return output;
 }
 
 neural_tensor_t* attention_self(const neural_tensor_t* input, size_t n_heads) {
     if (!input || input->n_dims != 2) return NULL;
     
-    attention_state_t* state = attention_create(n_heads, input->shape[1], input->shape[1]);
-    if (!state) return NULL;
+    // Weights and scratch come from the plan cache instead of per-call allocation
+    attention_plan_t* plan = attention_plan_acquire(n_heads, input->shape[1], input->shape[1]);
+    if (!plan) return NULL;
     
-    neural_tensor_t* output = attention_multihead(state, input);
-    attention_free(state);
+    neural_tensor_t* output = attention_plan_execute(plan, NULL, input);
+    attention_plan_release(plan);
     
     return output;
 }
@@ -349,21 +629,63 @@ neural_tensor_t* attention_self(const neural_tensor_t* input, size_t n_heads) {
 // ============================================================================
 
 cognitive_context_t* cognitive_context_create(size_t n_nodes, size_t memory_capacity) {
-    cognitive_context_t* context = (cognitive_context_t*)malloc(sizeof(cognitive_context_t));
+    return cognitive_context_create_with_attention(n_nodes, memory_capacity,
+                                                   COGNITIVE_ATTENTION_DENSE, 0);
+}
+
+cognitive_context_t* cognitive_context_create_with_attention(size_t n_nodes,
+                                                             size_t memory_capacity,
+                                                             cognitive_attention_mode_t mode,
+                                                             size_t n_features) {
+    cognitive_context_t* context = (cognitive_context_t*)calloc(1, sizeof(cognitive_context_t));
     if (!context) return NULL;
     
     context->capacity = memory_capacity;
+    context->attention_mode = mode;
     context->landscape = activation_landscape_create(n_nodes);
-    context->attention = attention_create(4, n_nodes, n_nodes / 4);
+    if (!context->landscape) {
+        cognitive_context_free(context);
+        return NULL;
+    }
     
-    size_t memory_shape[1] = {memory_capacity};
-    context->working_memory = neural_tensor_create(memory_shape, 1);
+    // One remembered state per slot
+    if (memory_capacity > 0) {
+        context->working_memory = working_memory_create(memory_capacity, n_nodes);
+        if (!context->working_memory) {
+            cognitive_context_free(context);
+            return NULL;
+        }
+    }
     
-    if (!context->landscape || !context->attention || !context->working_memory) {
+    if (mode == COGNITIVE_ATTENTION_LINEAR) {
+        // Running sums replace both the projections and the key/value history
+        if (n_features == 0) n_features = 64;
+        context->feature_map = attention_feature_map_create(n_nodes, n_features,
+                                                            (unsigned int)n_nodes);
+        context->linear_state = attention_linear_state_create(context->feature_map, n_nodes);
+        if (!context->linear_state) {
+            cognitive_context_free(context);
+            return NULL;
+        }
+        return context;
+    }
+    
+    context->attention = attention_create(4, n_nodes, n_nodes / 4);
+    if (!context->attention) {
         cognitive_context_free(context);
         return NULL;
     }
     
+    // One cached key/value row per remembered step
+    if (memory_capacity > 0) {
+        context->kv_cache = attention_kv_cache_create(memory_capacity, n_nodes / 4, n_nodes / 4,
+                                                      ATTENTION_KV_EVICT_OLDEST);
+        if (!context->kv_cache) {
+            cognitive_context_free(context);
+            return NULL;
+        }
+    }
+    
     return context;
 }
 
@@ -371,7 +693,13 @@ void cognitive_context_free(cognitive_context_t* context) {
     if (context) {
         if (context->landscape) activation_landscape_free(context->landscape);
         if (context->attention) attention_free(context->attention);
-        if (context->working_memory) neural_tensor_free(context->working_memory);
+        attention_kv_cache_free(context->kv_cache);
+        attention_linear_state_free(context->linear_state);
+        attention_feature_map_free(context->feature_map);
+        cognitive_pipeline_free(context->pipeline);
+        // Borrowed tensors are gone; the snapshot mapping can go too
+        if (context->mapping) munmap(context->mapping, context->mapping_size);
+        working_memory_free(context->working_memory);
         free(context);
     }
 }
@@ -382,9 +710,62 @@ void cognitive_context_step(cognitive_context_t* context,
     
     // Update activation landscape with input
     if (input->total_size <= context->landscape->n_nodes) {
-        memcpy(context->landscape->activations->data, input->data,
-               input->total_size * sizeof(float));
+        landscape_commit(context->landscape, input->data, 0, input->total_size, 1.0f);
+    }
+}
+
+bool cognitive_context_attend(cognitive_context_t* context, float* output) {
+    if (!context) return false;
+    
+    return cognitive_context_attend_state(context, context->landscape->activations->data,
+                                          output);
+}
+
+bool cognitive_context_attend_state(cognitive_context_t* context, const float* state,
+                                    float* output) {
+    if (!context || !state || !output) return false;
+    
+    if (context->attention_mode == COGNITIVE_ATTENTION_LINEAR) {
+        // The state is its own key, value and query (no projections)
+        return attention_linear_state_append(context->linear_state, state, state) &&
+               attention_linear_state_attend(context->linear_state, state, output);
+    }
+    
+    if (!context->kv_cache) return false;
+    return attention_incremental(context->attention, context->kv_cache, state, output);
+}
+
+neural_tensor_t* cognitive_context_attention(const cognitive_context_t* context,
+                                             const neural_tensor_t* input) {
+    if (!context || !input) return NULL;
+    
+    if (context->attention_mode == COGNITIVE_ATTENTION_LINEAR) {
+        return attention_linear(context->feature_map, input, input, input);
     }
+    
+    // Context weights, scratch reused from the plan cache
+    const attention_state_t* state = context->attention;
+    attention_plan_t* plan = attention_plan_acquire(state->n_heads, state->query->shape[0],
+                                                    state->query->shape[1]);
+    neural_tensor_t* output = plan ? attention_plan_execute(plan, state, input) : NULL;
+    attention_plan_release(plan);
+    
+    return output;
+}
+
+float cognitive_context_attention_error(const cognitive_context_t* context,
+                                        const neural_tensor_t* input,
+                                        size_t n_samples) {
+    if (!context || !input) return -1.0f;
+    if (context->attention_mode != COGNITIVE_ATTENTION_LINEAR) return 0.0f;
+    
+    return attention_linear_error(context->feature_map, input, input, input, n_samples);
+}
+
+size_t cognitive_context_remember(cognitive_context_t* context) {
+    if (!context || !context->working_memory) return SIZE_MAX;
+    
+    return working_memory_store(context->working_memory, context->landscape->activations->data);
 }
 
 neural_tensor_t* cognitive_context_get_state(const cognitive_context_t* context) {
@@ -404,6 +785,36 @@ neural_tensor_t* cognitive_context_get_state(const cognitive_context_t* context)
     return state;
 }
 
+cognitive_state_view_t cognitive_context_view_state(const cognitive_context_t* context) {
+    cognitive_state_view_t view;
+    memset(&view, 0, sizeof(view));
+    if (!context) return view;
+    
+    const activation_landscape_t* landscape = context->landscape;
+    view.activations = landscape->activations->data;
+    view.thresholds = landscape->thresholds;
+    view.active_nodes = landscape->active_nodes;
+    view.n_nodes = landscape->n_nodes;
+    view.n_active = landscape->n_active;
+    view.generation = landscape->generation;
+    return view;
+}
+
+size_t cognitive_context_copy_state(const cognitive_context_t* context, float* out,
+                                    size_t capacity) {
+    if (!context || !out) return 0;
+    
+    size_t n = context->landscape->n_nodes;
+    if (capacity < n) return 0;
+    
+    memcpy(out, context->landscape->activations->data, n * sizeof(float));
+    return n;
+}
+
+uint64_t cognitive_context_generation(const cognitive_context_t* context) {
+    return context ? context->landscape->generation : 0;
+}
+
 // ============================================================================
 // NEURAL-SYMBOLIC BRIDGE IMPLEMENTATION
 // ============================================================================
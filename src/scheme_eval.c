@@ -0,0 +1,3373 @@
+/**
+ * scheme_eval.c
+ *
+ * Embedded Scheme evaluator: heap and collector, reader, printer, the eval
+ * loop, and the built-in and neural primitives
+ */
+
+#include "scheme_eval.h"
+#include "scheme_neural_bridge.h"
+#include "symbol_embedding.h"
+#include "concept_table.h"
+#include <math.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Cells per heap block
+#define HEAP_BLOCK_CELLS 4096
+
+// Tensor bytes allocated between collections, at least
+#define TENSOR_GC_THRESHOLD (64u << 20)
+
+// Initial capacities
+#define ROOT_STACK_INITIAL 256
+#define MARK_STACK_INITIAL 256
+#define SYMBOL_TABLE_INITIAL 512
+
+// Slots eval() protects per call
+#define EVAL_ROOTS 5
+
+// Tensor operands accepted by neural-compute
+#define SCHEME_MAX_OPERANDS 8
+
+// Feature identifiers cond-expand treats as present
+static const char* const scheme_features[] = {"neural-scheme"};
+
+/**
+ * Special forms, recognized by the head symbol of a list
+ */
+typedef enum {
+    FORM_NONE,
+    FORM_QUOTE,
+    FORM_IF,
+    FORM_DEFINE,
+    FORM_SET,
+    FORM_LAMBDA,
+    FORM_BEGIN,
+    FORM_LET,
+    FORM_LET_STAR,              // let*, letrec and letrec*
+    FORM_COND,
+    FORM_AND,
+    FORM_OR,
+    FORM_WHEN,
+    FORM_UNLESS,
+    FORM_COND_EXPAND,
+    FORM_ELSE,                  // Markers: never evaluated as forms
+    FORM_ARROW
+} special_form_t;
+
+static const struct {
+    const char* name;
+    special_form_t form;
+} special_forms[] = {
+    {"quote", FORM_QUOTE},
+    {"if", FORM_IF},
+    {"define", FORM_DEFINE},
+    {"set!", FORM_SET},
+    {"lambda", FORM_LAMBDA},
+    {"begin", FORM_BEGIN},
+    {"let", FORM_LET},
+    {"let*", FORM_LET_STAR},
+    {"letrec", FORM_LET_STAR},
+    {"letrec*", FORM_LET_STAR},
+    {"cond", FORM_COND},
+    {"and", FORM_AND},
+    {"or", FORM_OR},
+    {"when", FORM_WHEN},
+    {"unless", FORM_UNLESS},
+    {"cond-expand", FORM_COND_EXPAND},
+    {"else", FORM_ELSE},
+    {"=>", FORM_ARROW}
+};
+
+typedef struct heap_block {
+    struct heap_block* next;
+    scheme_value_t cells[HEAP_BLOCK_CELLS];
+} heap_block_t;
+
+struct scheme_interp {
+    // Heap
+    heap_block_t* blocks;
+    scheme_value_t* free_list;          // Linked through as.pair.cdr
+    size_t n_cells;
+    size_t n_free;
+    size_t n_collections;
+    size_t tensor_bytes;
+    size_t tensor_threshold;
+    
+    // Interned symbols, open addressing (symbols are never collected)
+    scheme_value_t** symbols;
+    size_t symbol_capacity;
+    size_t n_symbols;
+    scheme_value_t* symbol_quote;
+    
+    // Protected C slots
+    scheme_value_t*** roots;
+    size_t n_roots;
+    size_t root_capacity;
+    
+    // Collector work list
+    scheme_value_t** mark_stack;
+    size_t n_mark;
+    size_t mark_capacity;
+    bool mark_overflow;
+    
+    cognitive_context_t* context;       // Borrowed
+    symbol_encoder_t* encoder;          // Created by the first embed
+    concept_table_t* concepts;          // Created by the first register-concepts
+    scheme_value_t** concept_symbols;   // [n_nodes] symbol of each named node
+    FILE* output;
+    scheme_value_t* result;             // Last top-level result (a root)
+    size_t depth;
+    bool failed;
+    char error[SCHEME_ERROR_MAX];
+};
+
+// Shared immutable values; they live outside every heap and are never marked
+static scheme_value_t nil_cell = {.type = SCHEME_NIL};
+static scheme_value_t true_cell = {.type = SCHEME_BOOLEAN, .as.boolean = true};
+static scheme_value_t false_cell = {.type = SCHEME_BOOLEAN, .as.boolean = false};
+static scheme_value_t unspecified_cell = {.type = SCHEME_UNSPECIFIED};
+
+#define ROOT(interp, var) ((interp)->roots[(interp)->n_roots++] = &(var))
+
+static inline bool is_pair(const scheme_value_t* value) {
+    return value->type == SCHEME_PAIR;
+}
+
+static inline scheme_value_t* car(const scheme_value_t* value) {
+    return value->as.pair.car;
+}
+
+static inline scheme_value_t* cdr(const scheme_value_t* value) {
+    return value->as.pair.cdr;
+}
+
+/**
+ * Length of a proper list, SIZE_MAX for anything else (circular lists
+ * included: a second cursor at half speed meets the first inside a cycle)
+ */
+static size_t list_length(const scheme_value_t* list) {
+    const scheme_value_t* slow = list;
+    size_t length = 0;
+    while (is_pair(list)) {
+        length++;
+        list = cdr(list);
+        if ((length & 1) == 0) slow = cdr(slow);
+        if (list == slow) return SIZE_MAX;
+    }
+    return list->type == SCHEME_NIL ? length : SIZE_MAX;
+}
+
+static const char* type_name(const scheme_value_t* value) {
+    switch (value->type) {
+        case SCHEME_NIL: return "empty list";
+        case SCHEME_BOOLEAN: return "boolean";
+        case SCHEME_NUMBER: return "number";
+        case SCHEME_SYMBOL: return "symbol";
+        case SCHEME_STRING: return "string";
+        case SCHEME_PAIR: return "pair";
+        case SCHEME_CLOSURE: return "procedure";
+        case SCHEME_PRIMITIVE: return "primitive";
+        case SCHEME_TENSOR: return "tensor";
+        default: return "unspecified";
+    }
+}
+
+// ============================================================================
+// ERRORS AND ROOTS
+// ============================================================================
+
+scheme_value_t* scheme_fail(scheme_interp_t* interp, const char* format, ...) {
+    if (!interp->failed) {
+        va_list arguments;
+        va_start(arguments, format);
+        vsnprintf(interp->error, sizeof(interp->error), format, arguments);
+        va_end(arguments);
+        interp->failed = true;
+    }
+    return NULL;
+}
+
+const char* scheme_interp_error(const scheme_interp_t* interp) {
+    return interp ? interp->error : "no interpreter";
+}
+
+/**
+ * Make room for n more protected slots
+ */
+static bool reserve_roots(scheme_interp_t* interp, size_t n) {
+    if (interp->n_roots + n <= interp->root_capacity) return true;
+    
+    size_t capacity = interp->root_capacity;
+    while (capacity < interp->n_roots + n) capacity *= 2;
+    scheme_value_t*** roots = (scheme_value_t***)realloc(interp->roots,
+                                                          capacity * sizeof(scheme_value_t**));
+    if (!roots) return false;
+    interp->roots = roots;
+    interp->root_capacity = capacity;
+    return true;
+}
+
+bool scheme_protect(scheme_interp_t* interp, scheme_value_t** slot) {
+    if (!interp || !slot || !reserve_roots(interp, 1)) return false;
+    interp->roots[interp->n_roots++] = slot;
+    return true;
+}
+
+void scheme_unprotect(scheme_interp_t* interp, size_t count) {
+    if (!interp) return;
+    interp->n_roots = (count < interp->n_roots) ? interp->n_roots - count : 0;
+}
+
+// ============================================================================
+// HEAP AND COLLECTOR
+// ============================================================================
+
+static bool heap_grow(scheme_interp_t* interp) {
+    heap_block_t* block = (heap_block_t*)malloc(sizeof(heap_block_t));
+    if (!block) return false;
+    
+    block->next = interp->blocks;
+    interp->blocks = block;
+    for (size_t i = HEAP_BLOCK_CELLS; i-- > 0;) {
+        scheme_value_t* cell = &block->cells[i];
+        cell->type = SCHEME_FREE;
+        cell->marked = 0;
+        cell->as.pair.cdr = interp->free_list;
+        interp->free_list = cell;
+    }
+    interp->n_cells += HEAP_BLOCK_CELLS;
+    interp->n_free += HEAP_BLOCK_CELLS;
+    return true;
+}
+
+static bool has_children(const scheme_value_t* value) {
+    return value->type == SCHEME_PAIR || value->type == SCHEME_SYMBOL ||
+           value->type == SCHEME_CLOSURE;
+}
+
+/**
+ * Mark a value and queue it for scanning
+ * When the work list cannot grow the value stays marked but unscanned, and
+ * the collector rescans the heap for such cells afterwards.
+ */
+static void mark_value(scheme_interp_t* interp, scheme_value_t* value) {
+    if (!value || value->marked) return;
+    if (value->type == SCHEME_NIL || value->type == SCHEME_BOOLEAN ||
+        value->type == SCHEME_UNSPECIFIED) {
+        return;
+    }
+    
+    value->marked = 1;
+    if (!has_children(value)) return;
+    
+    if (interp->n_mark == interp->mark_capacity) {
+        size_t capacity = interp->mark_capacity * 2;
+        scheme_value_t** stack = (scheme_value_t**)realloc(interp->mark_stack,
+                                                           capacity * sizeof(scheme_value_t*));
+        if (!stack) {
+            interp->mark_overflow = true;
+            return;
+        }
+        interp->mark_stack = stack;
+        interp->mark_capacity = capacity;
+    }
+    interp->mark_stack[interp->n_mark++] = value;
+}
+
+static void mark_children(scheme_interp_t* interp, scheme_value_t* value) {
+    switch (value->type) {
+        case SCHEME_PAIR:
+            mark_value(interp, value->as.pair.car);
+            mark_value(interp, value->as.pair.cdr);
+            break;
+        case SCHEME_SYMBOL:
+            mark_value(interp, value->as.symbol.global);
+            break;
+        case SCHEME_CLOSURE:
+            mark_value(interp, value->as.closure.params);
+            mark_value(interp, value->as.closure.body);
+            mark_value(interp, value->as.closure.env);
+            break;
+        default:
+            break;
+    }
+}
+
+static void mark_drain(scheme_interp_t* interp) {
+    while (interp->n_mark > 0) {
+        mark_children(interp, interp->mark_stack[--interp->n_mark]);
+    }
+}
+
+static void finalize_cell(scheme_value_t* cell) {
+    if (cell->type == SCHEME_STRING) {
+        free(cell->as.string.chars);
+    } else if (cell->type == SCHEME_TENSOR) {
+        neural_tensor_free(cell->as.tensor);
+    } else if (cell->type == SCHEME_SYMBOL) {
+        free(cell->as.symbol.name);
+    }
+}
+
+static size_t tensor_bytes(const neural_tensor_t* tensor) {
+    return tensor ? tensor->total_size * sizeof(float) : 0;
+}
+
+void scheme_collect(scheme_interp_t* interp) {
+    if (!interp) return;
+    
+    // Mark from the symbol table (global bindings), protected slots and the last result
+    for (size_t i = 0; i < interp->symbol_capacity; i++) {
+        mark_value(interp, interp->symbols[i]);
+    }
+    for (size_t i = 0; i < interp->n_roots; i++) {
+        mark_value(interp, *interp->roots[i]);
+    }
+    mark_value(interp, interp->result);
+    mark_drain(interp);
+    
+    while (interp->mark_overflow) {
+        interp->mark_overflow = false;
+        for (heap_block_t* block = interp->blocks; block; block = block->next) {
+            for (size_t i = 0; i < HEAP_BLOCK_CELLS; i++) {
+                scheme_value_t* cell = &block->cells[i];
+                if (cell->marked && cell->type != SCHEME_FREE) {
+                    mark_children(interp, cell);
+                    mark_drain(interp);
+                }
+            }
+        }
+    }
+    
+    // Sweep: rebuild the free list and recount live tensor bytes
+    interp->free_list = NULL;
+    interp->n_free = 0;
+    interp->tensor_bytes = 0;
+    for (heap_block_t* block = interp->blocks; block; block = block->next) {
+        for (size_t i = HEAP_BLOCK_CELLS; i-- > 0;) {
+            scheme_value_t* cell = &block->cells[i];
+            if (cell->marked) {
+                cell->marked = 0;
+                if (cell->type == SCHEME_TENSOR) interp->tensor_bytes += tensor_bytes(cell->as.tensor);
+                continue;
+            }
+            if (cell->type != SCHEME_FREE) {
+                finalize_cell(cell);
+                cell->type = SCHEME_FREE;
+            }
+            cell->as.pair.cdr = interp->free_list;
+            interp->free_list = cell;
+            interp->n_free++;
+        }
+    }
+    
+    interp->tensor_threshold = interp->tensor_bytes * 2;
+    if (interp->tensor_threshold < TENSOR_GC_THRESHOLD) {
+        interp->tensor_threshold = TENSOR_GC_THRESHOLD;
+    }
+    interp->n_collections++;
+}
+
+/**
+ * Take a cell off the free list, collecting (and growing the heap when less
+ * than half of it is free afterwards) once the list is empty
+ */
+static scheme_value_t* alloc_cell(scheme_interp_t* interp, scheme_type_t type) {
+    if (!interp->free_list) {
+        scheme_collect(interp);
+        if (interp->n_free < interp->n_cells / 2) heap_grow(interp);
+        if (!interp->free_list) return scheme_fail(interp, "out of memory");
+    }
+    
+    scheme_value_t* cell = interp->free_list;
+    interp->free_list = cell->as.pair.cdr;
+    interp->n_free--;
+    cell->type = (uint8_t)type;
+    cell->marked = 0;
+    cell->form = FORM_NONE;
+    return cell;
+}
+
+scheme_heap_stats_t scheme_interp_stats(const scheme_interp_t* interp) {
+    scheme_heap_stats_t stats = {0, 0, 0, 0};
+    if (interp) {
+        stats.n_cells = interp->n_cells;
+        stats.n_free = interp->n_free;
+        stats.n_collections = interp->n_collections;
+        stats.tensor_bytes = interp->tensor_bytes;
+    }
+    return stats;
+}
+
+// ============================================================================
+// VALUES
+// ============================================================================
+
+scheme_value_t* scheme_nil(void) {
+    return &nil_cell;
+}
+
+scheme_value_t* scheme_boolean(bool value) {
+    return value ? &true_cell : &false_cell;
+}
+
+scheme_value_t* scheme_unspecified(void) {
+    return &unspecified_cell;
+}
+
+bool scheme_is_true(const scheme_value_t* value) {
+    return value != &false_cell;
+}
+
+scheme_value_t* scheme_make_number(scheme_interp_t* interp, double value) {
+    scheme_value_t* cell = alloc_cell(interp, SCHEME_NUMBER);
+    if (cell) cell->as.number = value;
+    return cell;
+}
+
+scheme_value_t* scheme_make_string(scheme_interp_t* interp, const char* chars, size_t length) {
+    char* copy = (char*)malloc(length + 1);
+    if (!copy) return scheme_fail(interp, "out of memory");
+    memcpy(copy, chars, length);
+    copy[length] = '\0';
+    
+    scheme_value_t* cell = alloc_cell(interp, SCHEME_STRING);
+    if (!cell) {
+        free(copy);
+        return NULL;
+    }
+    cell->as.string.chars = copy;
+    cell->as.string.length = length;
+    return cell;
+}
+
+scheme_value_t* scheme_cons(scheme_interp_t* interp, scheme_value_t* car_value,
+                            scheme_value_t* cdr_value) {
+    if (!reserve_roots(interp, 2)) return scheme_fail(interp, "out of memory");
+    ROOT(interp, car_value);
+    ROOT(interp, cdr_value);
+    scheme_value_t* cell = alloc_cell(interp, SCHEME_PAIR);
+    interp->n_roots -= 2;
+    
+    if (cell) {
+        cell->as.pair.car = car_value;
+        cell->as.pair.cdr = cdr_value;
+    }
+    return cell;
+}
+
+scheme_value_t* scheme_make_tensor(scheme_interp_t* interp, neural_tensor_t* tensor) {
+    if (!tensor) return scheme_fail(interp, "no tensor");
+    
+    // Tensor memory lives outside the heap, so it paces collections too
+    if (interp->tensor_bytes + tensor_bytes(tensor) > interp->tensor_threshold) {
+        scheme_collect(interp);
+    }
+    
+    scheme_value_t* cell = alloc_cell(interp, SCHEME_TENSOR);
+    if (!cell) {
+        neural_tensor_free(tensor);
+        return NULL;
+    }
+    cell->as.tensor = tensor;
+    interp->tensor_bytes += tensor_bytes(tensor);
+    return cell;
+}
+
+neural_tensor_t* scheme_value_tensor(const scheme_value_t* value) {
+    return (value && value->type == SCHEME_TENSOR) ? value->as.tensor : NULL;
+}
+
+static scheme_value_t* make_closure(scheme_interp_t* interp, scheme_value_t* params,
+                                    scheme_value_t* body, scheme_value_t* env) {
+    for (scheme_value_t* param = params; ; param = cdr(param)) {
+        if (param->type == SCHEME_NIL || param->type == SCHEME_SYMBOL) break;
+        if (!is_pair(param) || car(param)->type != SCHEME_SYMBOL) {
+            return scheme_fail(interp, "lambda: parameters must be symbols");
+        }
+    }
+    if (!is_pair(body)) return scheme_fail(interp, "lambda: empty body");
+    
+    if (!reserve_roots(interp, 3)) return scheme_fail(interp, "out of memory");
+    ROOT(interp, params);
+    ROOT(interp, body);
+    ROOT(interp, env);
+    scheme_value_t* cell = alloc_cell(interp, SCHEME_CLOSURE);
+    interp->n_roots -= 3;
+    
+    if (cell) {
+        cell->as.closure.params = params;
+        cell->as.closure.body = body;
+        cell->as.closure.env = env;
+    }
+    return cell;
+}
+
+// ============================================================================
+// SYMBOLS
+// ============================================================================
+
+static uint64_t hash_name(const char* name, size_t length) {
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < length; i++) {
+        hash = (hash ^ (uint8_t)name[i]) * 1099511628211ull;
+    }
+    return hash;
+}
+
+/**
+ * Slot holding the name, or the empty slot where it belongs
+ */
+static size_t symbol_slot(const scheme_interp_t* interp, const char* name, size_t length) {
+    size_t mask = interp->symbol_capacity - 1;
+    size_t slot = (size_t)hash_name(name, length) & mask;
+    while (interp->symbols[slot]) {
+        const char* existing = interp->symbols[slot]->as.symbol.name;
+        if (strncmp(existing, name, length) == 0 && existing[length] == '\0') break;
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+static bool symbols_grow(scheme_interp_t* interp) {
+    size_t old_capacity = interp->symbol_capacity;
+    scheme_value_t** old_symbols = interp->symbols;
+    scheme_value_t** symbols = (scheme_value_t**)calloc(old_capacity * 2, sizeof(scheme_value_t*));
+    if (!symbols) return false;
+    
+    interp->symbols = symbols;
+    interp->symbol_capacity = old_capacity * 2;
+    for (size_t i = 0; i < old_capacity; i++) {
+        scheme_value_t* symbol = old_symbols[i];
+        if (!symbol) continue;
+        const char* name = symbol->as.symbol.name;
+        interp->symbols[symbol_slot(interp, name, strlen(name))] = symbol;
+    }
+    free(old_symbols);
+    return true;
+}
+
+static scheme_value_t* intern_n(scheme_interp_t* interp, const char* name, size_t length) {
+    size_t slot = symbol_slot(interp, name, length);
+    if (interp->symbols[slot]) return interp->symbols[slot];
+    
+    // Keep the load factor under 0.7
+    if ((interp->n_symbols + 1) * 10 > interp->symbol_capacity * 7) {
+        if (!symbols_grow(interp)) return scheme_fail(interp, "out of memory");
+        slot = symbol_slot(interp, name, length);
+    }
+    
+    char* copy = (char*)malloc(length + 1);
+    if (!copy) return scheme_fail(interp, "out of memory");
+    memcpy(copy, name, length);
+    copy[length] = '\0';
+    
+    scheme_value_t* symbol = alloc_cell(interp, SCHEME_SYMBOL);
+    if (!symbol) {
+        free(copy);
+        return NULL;
+    }
+    symbol->as.symbol.name = copy;
+    symbol->as.symbol.global = NULL;
+    interp->symbols[slot] = symbol;
+    interp->n_symbols++;
+    return symbol;
+}
+
+scheme_value_t* scheme_intern(scheme_interp_t* interp, const char* name) {
+    if (!interp || !name) return NULL;
+    return intern_n(interp, name, strlen(name));
+}
+
+// ============================================================================
+// ENVIRONMENTS
+// ============================================================================
+
+// An environment is () for the global scope, or (frame . parent) where the
+// frame is a list of (symbol . value) bindings. Globals live in the symbols.
+
+static scheme_value_t* find_binding(scheme_value_t* symbol, scheme_value_t* env) {
+    for (; is_pair(env); env = cdr(env)) {
+        for (scheme_value_t* frame = car(env); is_pair(frame); frame = cdr(frame)) {
+            if (car(car(frame)) == symbol) return car(frame);
+        }
+    }
+    return NULL;
+}
+
+static scheme_value_t* variable_value(scheme_interp_t* interp, scheme_value_t* symbol,
+                                      scheme_value_t* env) {
+    scheme_value_t* binding = find_binding(symbol, env);
+    if (binding) return cdr(binding);
+    if (symbol->as.symbol.global) return symbol->as.symbol.global;
+    return scheme_fail(interp, "unbound variable: %s", symbol->as.symbol.name);
+}
+
+/**
+ * Bind (or rebind) a symbol in the innermost frame of env
+ */
+static bool define_variable(scheme_interp_t* interp, scheme_value_t* env,
+                            scheme_value_t* symbol, scheme_value_t* value) {
+    if (!is_pair(env)) {
+        symbol->as.symbol.global = value;
+        return true;
+    }
+    
+    for (scheme_value_t* frame = car(env); is_pair(frame); frame = cdr(frame)) {
+        if (car(car(frame)) == symbol) {
+            car(frame)->as.pair.cdr = value;
+            return true;
+        }
+    }
+    
+    scheme_value_t* binding = scheme_cons(interp, symbol, value);
+    if (!binding) return false;
+    scheme_value_t* frame = scheme_cons(interp, binding, car(env));
+    if (!frame) return false;
+    env->as.pair.car = frame;
+    return true;
+}
+
+/**
+ * New environment binding a closure's parameters to args
+ */
+static scheme_value_t* bind_params(scheme_interp_t* interp, scheme_value_t* closure,
+                                   scheme_value_t* args) {
+    if (!reserve_roots(interp, 1)) return scheme_fail(interp, "out of memory");
+    scheme_value_t* frame = &nil_cell;
+    ROOT(interp, frame);
+    
+    scheme_value_t* params = closure->as.closure.params;
+    scheme_value_t* env = NULL;
+    for (; is_pair(params); params = cdr(params), args = cdr(args)) {
+        if (!is_pair(args)) {
+            scheme_fail(interp, "too few arguments");
+            goto done;
+        }
+        scheme_value_t* binding = scheme_cons(interp, car(params), car(args));
+        if (!binding || !(frame = scheme_cons(interp, binding, frame))) goto done;
+    }
+    
+    if (params->type == SCHEME_SYMBOL) {
+        // Rest parameter takes the remaining arguments
+        scheme_value_t* binding = scheme_cons(interp, params, args);
+        if (!binding || !(frame = scheme_cons(interp, binding, frame))) goto done;
+    } else if (args->type != SCHEME_NIL) {
+        scheme_fail(interp, "too many arguments");
+        goto done;
+    }
+    
+    env = scheme_cons(interp, frame, closure->as.closure.env);
+    
+done:
+    interp->n_roots--;
+    return env;
+}
+
+// ============================================================================
+// EVALUATION
+// ============================================================================
+
+static scheme_value_t* eval(scheme_interp_t* interp, scheme_value_t* expr, scheme_value_t* env);
+
+static scheme_value_t* malformed(scheme_interp_t* interp, const scheme_value_t* head) {
+    return scheme_fail(interp, "malformed %s", head->as.symbol.name);
+}
+
+/**
+ * Evaluate all but the last expression of a body; returns the last one
+ * (for the caller to evaluate in tail position), NULL on error
+ */
+static scheme_value_t* eval_body(scheme_interp_t* interp, scheme_value_t* body,
+                                 scheme_value_t* env) {
+    if (!is_pair(body)) return scheme_fail(interp, "empty body");
+    
+    while (is_pair(cdr(body))) {
+        if (!eval(interp, car(body), env)) return NULL;
+        body = cdr(body);
+    }
+    if (cdr(body)->type != SCHEME_NIL) return scheme_fail(interp, "improper body");
+    return car(body);
+}
+
+static bool check_arity(scheme_interp_t* interp, const scheme_primitive_t* primitive,
+                        const scheme_value_t* args) {
+    size_t n_args = list_length(args);
+    if (n_args >= primitive->min_args && n_args <= primitive->max_args) return true;
+    
+    if (primitive->min_args == primitive->max_args) {
+        scheme_fail(interp, "%s: expected %zu argument(s), got %zu",
+                    primitive->name, primitive->min_args, n_args);
+    } else {
+        scheme_fail(interp, "%s: expected at least %zu argument(s), got %zu",
+                    primitive->name, primitive->min_args, n_args);
+    }
+    return false;
+}
+
+/**
+ * (define name expr) or (define (name . params) body ...)
+ */
+static scheme_value_t* eval_define(scheme_interp_t* interp, scheme_value_t* head,
+                                   scheme_value_t* rest, scheme_value_t* env) {
+    if (!is_pair(rest)) return malformed(interp, head);
+    
+    scheme_value_t* target = car(rest);
+    scheme_value_t* name;
+    scheme_value_t* value;
+    if (is_pair(target)) {
+        name = car(target);
+        if (name->type != SCHEME_SYMBOL) return malformed(interp, head);
+        value = make_closure(interp, cdr(target), cdr(rest), env);
+    } else {
+        name = target;
+        if (name->type != SCHEME_SYMBOL || list_length(rest) != 2) return malformed(interp, head);
+        value = eval(interp, car(cdr(rest)), env);
+    }
+    
+    if (!value || !define_variable(interp, env, name, value)) return NULL;
+    return &unspecified_cell;
+}
+
+/**
+ * (set! name expr)
+ */
+static scheme_value_t* eval_set(scheme_interp_t* interp, scheme_value_t* head,
+                                scheme_value_t* rest, scheme_value_t* env) {
+    if (list_length(rest) != 2 || car(rest)->type != SCHEME_SYMBOL) return malformed(interp, head);
+    
+    scheme_value_t* value = eval(interp, car(cdr(rest)), env);
+    if (!value) return NULL;
+    
+    scheme_value_t* symbol = car(rest);
+    scheme_value_t* binding = find_binding(symbol, env);
+    if (binding) {
+        binding->as.pair.cdr = value;
+    } else if (symbol->as.symbol.global) {
+        symbol->as.symbol.global = value;
+    } else {
+        return scheme_fail(interp, "set!: unbound variable: %s", symbol->as.symbol.name);
+    }
+    return &unspecified_cell;
+}
+
+static bool valid_binding(const scheme_value_t* binding) {
+    return is_pair(binding) && car(binding)->type == SCHEME_SYMBOL &&
+           list_length(binding) == 2;
+}
+
+/**
+ * Names of a let's bindings, in order (the parameters of a named let)
+ */
+static scheme_value_t* binding_names(scheme_interp_t* interp, scheme_value_t* bindings) {
+    if (!reserve_roots(interp, 1)) return scheme_fail(interp, "out of memory");
+    scheme_value_t* names = &nil_cell;
+    ROOT(interp, names);
+    
+    scheme_value_t* tail = NULL;
+    for (; is_pair(bindings); bindings = cdr(bindings)) {
+        scheme_value_t* cell = scheme_cons(interp, car(car(bindings)), &nil_cell);
+        if (!cell) {
+            names = NULL;
+            break;
+        }
+        if (tail) {
+            tail->as.pair.cdr = cell;
+        } else {
+            names = cell;
+        }
+        tail = cell;
+    }
+    
+    interp->n_roots--;
+    return names;
+}
+
+/**
+ * Test a cond-expand feature requirement: a feature identifier, else, or
+ * (and ...), (or ...), (not req); (library ...) never matches
+ * Returns 1 or 0, or -1 if the requirement is malformed.
+ */
+static int feature_requirement(const scheme_value_t* requirement) {
+    if (requirement->type == SCHEME_SYMBOL) {
+        if (requirement->form == FORM_ELSE) return 1;
+        for (size_t i = 0; i < sizeof(scheme_features) / sizeof(scheme_features[0]); i++) {
+            if (strcmp(requirement->as.symbol.name, scheme_features[i]) == 0) return 1;
+        }
+        return 0;
+    }
+    if (!is_pair(requirement) || car(requirement)->type != SCHEME_SYMBOL ||
+        list_length(requirement) == SIZE_MAX) {
+        return -1;
+    }
+    
+    const scheme_value_t* head = car(requirement);
+    const scheme_value_t* rest = cdr(requirement);
+    if (head->form == FORM_AND || head->form == FORM_OR) {
+        int all = (head->form == FORM_AND);
+        for (; is_pair(rest); rest = cdr(rest)) {
+            int met = feature_requirement(car(rest));
+            if (met < 0) return -1;
+            if (met != all) return met;
+        }
+        return all;
+    }
+    if (strcmp(head->as.symbol.name, "not") == 0) {
+        if (list_length(rest) != 1) return -1;
+        int met = feature_requirement(car(rest));
+        return met < 0 ? -1 : !met;
+    }
+    return strcmp(head->as.symbol.name, "library") == 0 ? 0 : -1;
+}
+
+/**
+ * Evaluate an expression
+ * Tail positions (if branches, the last expression of a body, closure calls)
+ * loop instead of recursing, so iteration written as recursion runs in
+ * constant C stack.
+ */
+static scheme_value_t* eval(scheme_interp_t* interp, scheme_value_t* expr, scheme_value_t* env) {
+    if (interp->depth >= SCHEME_MAX_DEPTH) return scheme_fail(interp, "recursion too deep");
+    if (!reserve_roots(interp, EVAL_ROOTS)) return scheme_fail(interp, "out of memory");
+    
+    size_t saved_roots = interp->n_roots;
+    scheme_value_t* procedure = &nil_cell;
+    scheme_value_t* args = &nil_cell;
+    scheme_value_t* value = &nil_cell;
+    scheme_value_t* result = NULL;
+    ROOT(interp, expr);
+    ROOT(interp, env);
+    ROOT(interp, procedure);
+    ROOT(interp, args);
+    ROOT(interp, value);
+    interp->depth++;
+    
+    for (;;) {
+        if (expr->type == SCHEME_SYMBOL) {
+            result = variable_value(interp, expr, env);
+            goto done;
+        }
+        if (!is_pair(expr)) {
+            result = expr;
+            goto done;
+        }
+    
+        scheme_value_t* head = car(expr);
+        scheme_value_t* rest = cdr(expr);
+        scheme_value_t* next;
+        special_form_t form = (head->type == SCHEME_SYMBOL) ? (special_form_t)head->form : FORM_NONE;
+    
+        switch (form) {
+            case FORM_QUOTE:
+                result = (list_length(rest) == 1) ? car(rest) : malformed(interp, head);
+                goto done;
+    
+            case FORM_IF: {
+                size_t n = list_length(rest);
+                if (n != 2 && n != 3) {
+                    malformed(interp, head);
+                    goto done;
+                }
+                value = eval(interp, car(rest), env);
+                if (!value) goto done;
+                if (scheme_is_true(value)) {
+                    expr = car(cdr(rest));
+                } else if (n == 3) {
+                    expr = car(cdr(cdr(rest)));
+                } else {
+                    result = &unspecified_cell;
+                    goto done;
+                }
+                continue;
+            }
+    
+            case FORM_DEFINE:
+                result = eval_define(interp, head, rest, env);
+                goto done;
+    
+            case FORM_SET:
+                result = eval_set(interp, head, rest, env);
+                goto done;
+    
+            case FORM_LAMBDA:
+                result = is_pair(rest) ? make_closure(interp, car(rest), cdr(rest), env)
+                                       : malformed(interp, head);
+                goto done;
+    
+            case FORM_BEGIN:
+                if (rest->type == SCHEME_NIL) {
+                    result = &unspecified_cell;
+                    goto done;
+                }
+                if (!(next = eval_body(interp, rest, env))) goto done;
+                expr = next;
+                continue;
+    
+            case FORM_LET: {
+                // (let ((v init) ...) body) or (let name ((v init) ...) body)
+                if (!is_pair(rest)) {
+                    malformed(interp, head);
+                    goto done;
+                }
+                scheme_value_t* name = NULL;
+                if (car(rest)->type == SCHEME_SYMBOL) {
+                    name = car(rest);
+                    rest = cdr(rest);
+                    if (!is_pair(rest)) {
+                        malformed(interp, head);
+                        goto done;
+                    }
+                }
+                scheme_value_t* bindings = car(rest);
+                scheme_value_t* body = cdr(rest);
+                if (list_length(bindings) == SIZE_MAX) {
+                    malformed(interp, head);
+                    goto done;
+                }
+    
+                // Inits are evaluated in the outer environment; args collects the frame
+                args = &nil_cell;
+                for (scheme_value_t* b = bindings; is_pair(b); b = cdr(b)) {
+                    if (!valid_binding(car(b))) {
+                        malformed(interp, head);
+                        goto done;
+                    }
+                    if (!(value = eval(interp, car(cdr(car(b))), env))) goto done;
+                    if (!(value = scheme_cons(interp, car(car(b)), value))) goto done;
+                    if (!(args = scheme_cons(interp, value, args))) goto done;
+                }
+    
+                if (name) {
+                    // The loop procedure is bound in its own frame around the body
+                    if (!(env = scheme_cons(interp, &nil_cell, env))) goto done;
+                    if (!(value = binding_names(interp, bindings))) goto done;
+                    if (!(procedure = make_closure(interp, value, body, env))) goto done;
+                    if (!define_variable(interp, env, name, procedure)) goto done;
+                }
+                if (!(env = scheme_cons(interp, args, env))) goto done;
+                if (!(next = eval_body(interp, body, env))) goto done;
+                expr = next;
+                continue;
+            }
+    
+            case FORM_LET_STAR: {
+                // let*, letrec, letrec*: one frame, filled in order, inits see it
+                if (!is_pair(rest) || list_length(car(rest)) == SIZE_MAX) {
+                    malformed(interp, head);
+                    goto done;
+                }
+                if (!(env = scheme_cons(interp, &nil_cell, env))) goto done;
+                for (scheme_value_t* b = car(rest); is_pair(b); b = cdr(b)) {
+                    if (!valid_binding(car(b))) {
+                        malformed(interp, head);
+                        goto done;
+                    }
+                    if (!(value = eval(interp, car(cdr(car(b))), env))) goto done;
+                    if (!define_variable(interp, env, car(car(b)), value)) goto done;
+                }
+                if (!(next = eval_body(interp, cdr(rest), env))) goto done;
+                expr = next;
+                continue;
+            }
+    
+            case FORM_COND: {
+                scheme_value_t* clauses = rest;
+                for (; is_pair(clauses); clauses = cdr(clauses)) {
+                    scheme_value_t* clause = car(clauses);
+                    if (!is_pair(clause)) {
+                        malformed(interp, head);
+                        goto done;
+                    }
+                    if (car(clause)->type == SCHEME_SYMBOL && car(clause)->form == FORM_ELSE) {
+                        break;
+                    }
+                    if (!(value = eval(interp, car(clause), env))) goto done;
+                    if (scheme_is_true(value)) break;
+                }
+    
+                if (!is_pair(clauses)) {
+                    result = &unspecified_cell;
+                    goto done;
+                }
+                scheme_value_t* body = cdr(car(clauses));
+                if (body->type == SCHEME_NIL && car(car(clauses))->form == FORM_ELSE) {
+                    malformed(interp, head);
+                    goto done;
+                }
+                if (body->type == SCHEME_NIL) {
+                    // (test) yields the test value
+                    result = value;
+                    goto done;
+                }
+                if (car(body)->type == SCHEME_SYMBOL && car(body)->form == FORM_ARROW) {
+                    // (test => receiver) calls receiver on the test value
+                    if (list_length(body) != 2) {
+                        malformed(interp, head);
+                        goto done;
+                    }
+                    if (!(procedure = eval(interp, car(cdr(body)), env))) goto done;
+                    if (!(args = scheme_cons(interp, value, &nil_cell))) goto done;
+                    goto apply;
+                }
+                if (!(next = eval_body(interp, body, env))) goto done;
+                expr = next;
+                continue;
+            }
+    
+            case FORM_AND:
+            case FORM_OR: {
+                if (rest->type == SCHEME_NIL) {
+                    result = scheme_boolean(form == FORM_AND);
+                    goto done;
+                }
+                for (; is_pair(cdr(rest)); rest = cdr(rest)) {
+                    if (!(value = eval(interp, car(rest), env))) goto done;
+                    if (scheme_is_true(value) != (form == FORM_AND)) {
+                        result = value;
+                        goto done;
+                    }
+                }
+                expr = car(rest);
+                continue;
+            }
+    
+            case FORM_WHEN:
+            case FORM_UNLESS:
+                if (!is_pair(rest)) {
+                    malformed(interp, head);
+                    goto done;
+                }
+                if (!(value = eval(interp, car(rest), env))) goto done;
+                if (scheme_is_true(value) != (form == FORM_WHEN)) {
+                    result = &unspecified_cell;
+                    goto done;
+                }
+                if (!(next = eval_body(interp, cdr(rest), env))) goto done;
+                expr = next;
+                continue;
+    
+            case FORM_COND_EXPAND: {
+                // The first clause whose requirement holds is spliced in like begin
+                scheme_value_t* clauses = rest;
+                for (; is_pair(clauses); clauses = cdr(clauses)) {
+                    int met = is_pair(car(clauses)) ? feature_requirement(car(car(clauses))) : -1;
+                    if (met < 0) {
+                        malformed(interp, head);
+                        goto done;
+                    }
+                    if (met) break;
+                }
+                if (!is_pair(clauses) || cdr(car(clauses))->type == SCHEME_NIL) {
+                    result = &unspecified_cell;
+                    goto done;
+                }
+                if (!(next = eval_body(interp, cdr(car(clauses)), env))) goto done;
+                expr = next;
+                continue;
+            }
+    
+            default:
+                break;
+        }
+    
+        // Application: evaluate the operator, then the operands left to right
+        if (!(procedure = eval(interp, head, env))) goto done;
+        args = &nil_cell;
+        scheme_value_t* tail = NULL;
+        for (; is_pair(rest); rest = cdr(rest)) {
+            if (!(value = eval(interp, car(rest), env))) goto done;
+            if (!(value = scheme_cons(interp, value, &nil_cell))) goto done;
+            if (tail) {
+                tail->as.pair.cdr = value;
+            } else {
+                args = value;
+            }
+            tail = value;
+        }
+        if (rest->type != SCHEME_NIL) {
+            scheme_fail(interp, "improper argument list");
+            goto done;
+        }
+    
+    apply:
+        if (procedure->type == SCHEME_PRIMITIVE) {
+            if (check_arity(interp, procedure->as.primitive, args)) {
+                result = procedure->as.primitive->fn(interp, args);
+            }
+            goto done;
+        }
+        if (procedure->type != SCHEME_CLOSURE) {
+            scheme_fail(interp, "not a procedure: %s", type_name(procedure));
+            goto done;
+        }
+        if (!(env = bind_params(interp, procedure, args))) goto done;
+        if (!(next = eval_body(interp, procedure->as.closure.body, env))) goto done;
+        expr = next;
+    }
+    
+done:
+    interp->depth--;
+    interp->n_roots = saved_roots;
+    return result;
+}
+
+/**
+ * Call a procedure on an argument list (non-tail; used by primitives)
+ */
+static scheme_value_t* apply_procedure(scheme_interp_t* interp, scheme_value_t* procedure,
+                                       scheme_value_t* args) {
+    if (procedure->type == SCHEME_PRIMITIVE) {
+        if (!check_arity(interp, procedure->as.primitive, args)) return NULL;
+        return procedure->as.primitive->fn(interp, args);
+    }
+    if (procedure->type != SCHEME_CLOSURE) {
+        return scheme_fail(interp, "not a procedure: %s", type_name(procedure));
+    }
+    if (!reserve_roots(interp, 3)) return scheme_fail(interp, "out of memory");
+    
+    scheme_value_t* env = NULL;
+    scheme_value_t* result = NULL;
+    ROOT(interp, procedure);
+    ROOT(interp, args);
+    ROOT(interp, env);
+    
+    env = bind_params(interp, procedure, args);
+    if (env) {
+        for (scheme_value_t* body = procedure->as.closure.body; is_pair(body); body = cdr(body)) {
+            if (!(result = eval(interp, car(body), env))) break;
+        }
+    }
+    
+    interp->n_roots -= 3;
+    return result;
+}
+
+scheme_value_t* scheme_apply(scheme_interp_t* interp, scheme_value_t* procedure,
+                             scheme_value_t* args) {
+    if (!interp || !procedure || !args) return NULL;
+    if (interp->depth == 0) {
+        interp->failed = false;
+        interp->error[0] = '\0';
+    }
+    return apply_procedure(interp, procedure, args);
+}
+
+// ============================================================================
+// READER
+// ============================================================================
+
+typedef struct {
+    const char* text;
+    size_t length;
+    size_t pos;
+    size_t depth;
+} scheme_reader_t;
+
+static scheme_value_t* read_fail(scheme_interp_t* interp, const scheme_reader_t* reader,
+                                 const char* message) {
+    return scheme_fail(interp, "read error at offset %zu: %s", reader->pos, message);
+}
+
+static bool is_whitespace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+}
+
+static bool is_delimiter(char c) {
+    return is_whitespace(c) || c == '(' || c == ')' || c == '[' || c == ']' ||
+           c == '"' || c == ';' || c == '\'';
+}
+
+static bool reader_peek(const scheme_reader_t* reader, size_t ahead, char c) {
+    return reader->pos + ahead < reader->length && reader->text[reader->pos + ahead] == c;
+}
+
+static scheme_value_t* read_datum(scheme_interp_t* interp, scheme_reader_t* reader);
+
+/**
+ * Skip whitespace and comments: ; to end of line, nested #| |#, #; datum, and
+ * #! directives (which also covers an interpreter line at the top of a file)
+ */
+static bool read_skip(scheme_interp_t* interp, scheme_reader_t* reader) {
+    const char* text = reader->text;
+    while (reader->pos < reader->length) {
+        char c = text[reader->pos];
+        if (is_whitespace(c)) {
+            reader->pos++;
+        } else if (c == ';' || (c == '#' && reader_peek(reader, 1, '!'))) {
+            while (reader->pos < reader->length && text[reader->pos] != '\n') reader->pos++;
+        } else if (c == '#' && reader_peek(reader, 1, '|')) {
+            size_t start = reader->pos;
+            size_t nesting = 1;
+            reader->pos += 2;
+            while (nesting > 0) {
+                if (reader->pos + 1 >= reader->length) {
+                    reader->pos = start;
+                    read_fail(interp, reader, "unterminated block comment");
+                    return false;
+                }
+                if (reader_peek(reader, 0, '|') && reader_peek(reader, 1, '#')) {
+                    nesting--;
+                    reader->pos += 2;
+                } else if (reader_peek(reader, 0, '#') && reader_peek(reader, 1, '|')) {
+                    nesting++;
+                    reader->pos += 2;
+                } else {
+                    reader->pos++;
+                }
+            }
+        } else if (c == '#' && reader_peek(reader, 1, ';')) {
+            reader->pos += 2;
+            if (!read_datum(interp, reader)) return false;
+        } else {
+            break;
+        }
+    }
+    return true;
+}
+
+static scheme_value_t* read_string(scheme_interp_t* interp, scheme_reader_t* reader) {
+    const char* text = reader->text;
+    size_t start = reader->pos++;
+    
+    // Escapes only shorten the text, so the raw span bounds the length
+    size_t end = reader->pos;
+    while (end < reader->length && text[end] != '"') {
+        if (text[end] == '\\') end++;
+        end++;
+    }
+    if (end >= reader->length) {
+        reader->pos = start;
+        return read_fail(interp, reader, "unterminated string");
+    }
+    
+    char* chars = (char*)malloc(end - reader->pos + 1);
+    if (!chars) return scheme_fail(interp, "out of memory");
+    
+    size_t n = 0;
+    while (reader->pos < end) {
+        char c = text[reader->pos++];
+        if (c != '\\') {
+            chars[n++] = c;
+            continue;
+        }
+        char escape = text[reader->pos++];
+        switch (escape) {
+            case 'n': chars[n++] = '\n'; break;
+            case 't': chars[n++] = '\t'; break;
+            case 'r': chars[n++] = '\r'; break;
+            case 'a': chars[n++] = '\a'; break;
+            case '0': chars[n++] = '\0'; break;
+            case '\\': chars[n++] = '\\'; break;
+            case '"': chars[n++] = '"'; break;
+            case '\n':
+                // Line continuation: drop the newline and the next line's indentation
+                while (reader->pos < end && (text[reader->pos] == ' ' || text[reader->pos] == '\t')) {
+                    reader->pos++;
+                }
+                break;
+            default:
+                free(chars);
+                reader->pos -= 2;
+                return read_fail(interp, reader, "unknown string escape");
+        }
+    }
+    reader->pos = end + 1;
+    
+    scheme_value_t* value = scheme_make_string(interp, chars, n);
+    free(chars);
+    return value;
+}
+
+/**
+ * Decimal number token (integers, decimals, exponents, +inf.0 -inf.0 +nan.0)
+ */
+static bool parse_number(const char* token, size_t length, double* out) {
+    char buffer[64];
+    if (length == 0 || length >= sizeof(buffer)) return false;
+    memcpy(buffer, token, length);
+    buffer[length] = '\0';
+    
+    if (strcmp(buffer, "+inf.0") == 0 || strcmp(buffer, "-inf.0") == 0) {
+        *out = (buffer[0] == '-') ? -INFINITY : INFINITY;
+        return true;
+    }
+    if (strcmp(buffer, "+nan.0") == 0 || strcmp(buffer, "-nan.0") == 0) {
+        *out = NAN;
+        return true;
+    }
+    
+    // strtod also takes hex, inf and nan spellings that are symbols here
+    bool has_digit = false;
+    for (size_t i = 0; i < length; i++) {
+        char c = buffer[i];
+        if (c >= '0' && c <= '9') {
+            has_digit = true;
+        } else if (c != '+' && c != '-' && c != '.' && c != 'e' && c != 'E') {
+            return false;
+        }
+    }
+    if (!has_digit) return false;
+    
+    char* end;
+    *out = strtod(buffer, &end);
+    return *end == '\0';
+}
+
+static scheme_value_t* read_atom(scheme_interp_t* interp, scheme_reader_t* reader) {
+    size_t start = reader->pos;
+    while (reader->pos < reader->length && !is_delimiter(reader->text[reader->pos])) {
+        reader->pos++;
+    }
+    const char* token = reader->text + start;
+    size_t length = reader->pos - start;
+    
+    if (token[0] == '#') {
+        if ((length == 2 && token[1] == 't') || (length == 5 && memcmp(token, "#true", 5) == 0)) {
+            return &true_cell;
+        }
+        if ((length == 2 && token[1] == 'f') || (length == 6 && memcmp(token, "#false", 6) == 0)) {
+            return &false_cell;
+        }
+        reader->pos = start;
+        return read_fail(interp, reader, "unsupported # syntax");
+    }
+    
+    double number;
+    if (parse_number(token, length, &number)) return scheme_make_number(interp, number);
+    return intern_n(interp, token, length);
+}
+
+/**
+ * Proper or dotted list; ( ) and [ ] are interchangeable but must match
+ */
+static scheme_value_t* read_list(scheme_interp_t* interp, scheme_reader_t* reader) {
+    const char* text = reader->text;
+    char close = (text[reader->pos] == '[') ? ']' : ')';
+    size_t start = reader->pos++;
+    if (!reserve_roots(interp, 2)) return scheme_fail(interp, "out of memory");
+    
+    scheme_value_t* head = &nil_cell;
+    scheme_value_t* item = &nil_cell;
+    scheme_value_t* tail = NULL;
+    scheme_value_t* result = NULL;
+    ROOT(interp, head);
+    ROOT(interp, item);
+    reader->depth++;
+    
+    for (;;) {
+        if (!read_skip(interp, reader)) break;
+        if (reader->pos >= reader->length) {
+            reader->pos = start;
+            read_fail(interp, reader, "unterminated list");
+            break;
+        }
+    
+        char c = text[reader->pos];
+        if (c == ')' || c == ']') {
+            if (c != close) {
+                read_fail(interp, reader, "mismatched closing bracket");
+                break;
+            }
+            reader->pos++;
+            result = head;
+            break;
+        }
+    
+        if (c == '.' && (reader->pos + 1 >= reader->length || is_delimiter(text[reader->pos + 1]))) {
+            if (!tail) {
+                read_fail(interp, reader, "unexpected '.'");
+                break;
+            }
+            reader->pos++;
+            if (!(item = read_datum(interp, reader))) break;
+            tail->as.pair.cdr = item;
+            if (!read_skip(interp, reader)) break;
+            if (reader->pos >= reader->length || text[reader->pos] != close) {
+                read_fail(interp, reader, "expected one datum after '.'");
+                break;
+            }
+            reader->pos++;
+            result = head;
+            break;
+        }
+    
+        if (!(item = read_datum(interp, reader))) break;
+        if (!(item = scheme_cons(interp, item, &nil_cell))) break;
+        if (tail) {
+            tail->as.pair.cdr = item;
+        } else {
+            head = item;
+        }
+        tail = item;
+    }
+    
+    reader->depth--;
+    interp->n_roots -= 2;
+    return result;
+}
+
+static scheme_value_t* read_datum(scheme_interp_t* interp, scheme_reader_t* reader) {
+    if (!read_skip(interp, reader)) return NULL;
+    if (reader->pos >= reader->length) return read_fail(interp, reader, "unexpected end of input");
+    if (reader->depth >= SCHEME_MAX_DEPTH) return read_fail(interp, reader, "nesting too deep");
+    
+    char c = reader->text[reader->pos];
+    if (c == '(' || c == '[') return read_list(interp, reader);
+    if (c == ')' || c == ']') return read_fail(interp, reader, "unexpected closing bracket");
+    if (c == '"') return read_string(interp, reader);
+    if (c == '`' || c == ',') return read_fail(interp, reader, "quasiquote is not supported");
+    
+    if (c == '\'') {
+        reader->pos++;
+        reader->depth++;
+        scheme_value_t* datum = read_datum(interp, reader);
+        reader->depth--;
+        if (!datum || !(datum = scheme_cons(interp, datum, &nil_cell))) return NULL;
+        return scheme_cons(interp, interp->symbol_quote, datum);
+    }
+    
+    return read_atom(interp, reader);
+}
+
+// ============================================================================
+// PRINTER
+// ============================================================================
+
+/**
+ * Growable, always NUL-terminated text
+ */
+typedef struct {
+    char* data;
+    size_t length;
+    size_t capacity;
+    bool failed;
+    bool unprintable;           // Value nested past SCHEME_MAX_DEPTH or circular
+} text_builder_t;
+
+static bool builder_append(void* ctx, const char* bytes, size_t length) {
+    text_builder_t* builder = (text_builder_t*)ctx;
+    if (builder->failed) return false;
+    
+    if (builder->length + length + 1 > builder->capacity) {
+        size_t capacity = builder->capacity ? builder->capacity : 64;
+        while (capacity < builder->length + length + 1) capacity *= 2;
+        char* data = (char*)realloc(builder->data, capacity);
+        if (!data) {
+            builder->failed = true;
+            return false;
+        }
+        builder->data = data;
+        builder->capacity = capacity;
+    }
+    memcpy(builder->data + builder->length, bytes, length);
+    builder->length += length;
+    builder->data[builder->length] = '\0';
+    return true;
+}
+
+static void builder_text(text_builder_t* builder, const char* text) {
+    builder_append(builder, text, strlen(text));
+}
+
+/**
+ * Integral values print without a fraction; others in the shortest of
+ * 15-17 significant digits that reads back exactly
+ */
+static void format_number(double value, char* out, size_t capacity) {
+    if (isnan(value)) {
+        snprintf(out, capacity, "+nan.0");
+    } else if (isinf(value)) {
+        snprintf(out, capacity, value > 0 ? "+inf.0" : "-inf.0");
+    } else if (value == floor(value) && fabs(value) < 1e15) {
+        snprintf(out, capacity, "%.0f", value);
+    } else {
+        for (int precision = 15; precision <= 17; precision++) {
+            snprintf(out, capacity, "%.*g", precision, value);
+            if (strtod(out, NULL) == value) break;
+        }
+    }
+}
+
+static void print_string(text_builder_t* builder, const scheme_value_t* value, bool display) {
+    if (display) {
+        builder_append(builder, value->as.string.chars, value->as.string.length);
+        return;
+    }
+    
+    builder_text(builder, "\"");
+    for (size_t i = 0; i < value->as.string.length; i++) {
+        char c = value->as.string.chars[i];
+        switch (c) {
+            case '"': builder_text(builder, "\\\""); break;
+            case '\\': builder_text(builder, "\\\\"); break;
+            case '\n': builder_text(builder, "\\n"); break;
+            case '\t': builder_text(builder, "\\t"); break;
+            case '\r': builder_text(builder, "\\r"); break;
+            default: builder_append(builder, &c, 1); break;
+        }
+    }
+    builder_text(builder, "\"");
+}
+
+/**
+ * Print a value; nesting past SCHEME_MAX_DEPTH or a circular list fails the
+ * builder with unprintable set instead of recursing or looping forever
+ */
+static void print_value(text_builder_t* builder, const scheme_value_t* value, bool display,
+                        size_t depth) {
+    char number[32];
+    
+    if (builder->failed) return;
+    if (depth >= SCHEME_MAX_DEPTH) {
+        builder->failed = builder->unprintable = true;
+        return;
+    }
+    
+    switch (value->type) {
+        case SCHEME_NIL:
+            builder_text(builder, "()");
+            break;
+        case SCHEME_BOOLEAN:
+            builder_text(builder, value->as.boolean ? "#t" : "#f");
+            break;
+        case SCHEME_NUMBER:
+            format_number(value->as.number, number, sizeof(number));
+            builder_text(builder, number);
+            break;
+        case SCHEME_SYMBOL:
+            builder_text(builder, value->as.symbol.name);
+            break;
+        case SCHEME_STRING:
+            print_string(builder, value, display);
+            break;
+        case SCHEME_PAIR: {
+            const scheme_value_t* slow = value;
+            size_t n_items = 0;
+            builder_text(builder, "(");
+            for (;;) {
+                print_value(builder, car(value), display, depth + 1);
+                value = cdr(value);
+                if (!is_pair(value) || builder->failed) break;
+                if ((++n_items & 1) == 0) slow = cdr(slow);
+                if (value == slow) {
+                    builder->failed = builder->unprintable = true;
+                    return;
+                }
+                builder_text(builder, " ");
+            }
+            if (value->type != SCHEME_NIL) {
+                builder_text(builder, " . ");
+                print_value(builder, value, display, depth + 1);
+            }
+            builder_text(builder, ")");
+            break;
+        }
+        case SCHEME_CLOSURE:
+            builder_text(builder, "#<procedure>");
+            break;
+        case SCHEME_PRIMITIVE:
+            builder_text(builder, "#<primitive ");
+            builder_text(builder, value->as.primitive->name);
+            builder_text(builder, ">");
+            break;
+        case SCHEME_TENSOR:
+            scheme_write_tensor(value->as.tensor, builder_append, builder);
+            break;
+        default:
+            builder_text(builder, "#<unspecified>");
+            break;
+    }
+}
+
+char* scheme_value_to_string(const scheme_value_t* value, bool display) {
+    if (!value) return NULL;
+    
+    text_builder_t builder = {NULL, 0, 0, false, false};
+    builder_append(&builder, "", 0);
+    print_value(&builder, value, display, 0);
+    if (builder.failed) {
+        free(builder.data);
+        return NULL;
+    }
+    return builder.data;
+}
+
+// ============================================================================
+// PRIMITIVES
+// ============================================================================
+
+static inline scheme_value_t* first(const scheme_value_t* args) {
+    return car(args);
+}
+
+static inline scheme_value_t* second(const scheme_value_t* args) {
+    return car(cdr(args));
+}
+
+static inline scheme_value_t* third(const scheme_value_t* args) {
+    return car(cdr(cdr(args)));
+}
+
+static bool number_arg(scheme_interp_t* interp, const char* name, const scheme_value_t* value,
+                       double* out) {
+    if (value->type != SCHEME_NUMBER) {
+        scheme_fail(interp, "%s: expected a number, got %s", name, type_name(value));
+        return false;
+    }
+    *out = value->as.number;
+    return true;
+}
+
+/**
+ * Non-negative integer argument (indices, sizes)
+ */
+static bool index_arg(scheme_interp_t* interp, const char* name, const scheme_value_t* value,
+                      size_t* out) {
+    double number;
+    if (!number_arg(interp, name, value, &number)) return false;
+    if (number < 0 || number != floor(number) || number >= 9007199254740992.0) {
+        scheme_fail(interp, "%s: expected a non-negative integer", name);
+        return false;
+    }
+    *out = (size_t)number;
+    return true;
+}
+
+static bool type_arg(scheme_interp_t* interp, const char* name, const scheme_value_t* value,
+                     scheme_type_t type, const char* expected) {
+    if (value->type == type) return true;
+    scheme_fail(interp, "%s: expected a %s, got %s", name, expected, type_name(value));
+    return false;
+}
+
+static neural_tensor_t* tensor_arg(scheme_interp_t* interp, const char* name,
+                                   const scheme_value_t* value) {
+    if (!type_arg(interp, name, value, SCHEME_TENSOR, "tensor")) return NULL;
+    return value->as.tensor;
+}
+
+/**
+ * Name given as a symbol or a string
+ */
+static const char* name_arg(scheme_interp_t* interp, const char* name, const scheme_value_t* value) {
+    if (value->type == SCHEME_SYMBOL) return value->as.symbol.name;
+    if (value->type == SCHEME_STRING) return value->as.string.chars;
+    scheme_fail(interp, "%s: expected a symbol or string, got %s", name, type_name(value));
+    return NULL;
+}
+
+/**
+ * List of numbers, built back to front
+ */
+static scheme_value_t* list_from_sizes(scheme_interp_t* interp, const size_t* values, size_t n) {
+    if (!reserve_roots(interp, 1)) return scheme_fail(interp, "out of memory");
+    scheme_value_t* list = &nil_cell;
+    ROOT(interp, list);
+    
+    for (size_t i = n; i-- > 0 && list;) {
+        scheme_value_t* number = scheme_make_number(interp, (double)values[i]);
+        list = number ? scheme_cons(interp, number, list) : NULL;
+    }
+    
+    interp->n_roots--;
+    return list;
+}
+
+static scheme_value_t* list_from_floats(scheme_interp_t* interp, const float* values, size_t n) {
+    if (!reserve_roots(interp, 1)) return scheme_fail(interp, "out of memory");
+    scheme_value_t* list = &nil_cell;
+    ROOT(interp, list);
+    
+    for (size_t i = n; i-- > 0 && list;) {
+        scheme_value_t* number = scheme_make_number(interp, (double)values[i]);
+        list = number ? scheme_cons(interp, number, list) : NULL;
+    }
+    
+    interp->n_roots--;
+    return list;
+}
+
+// ----------------------------------------------------------------------------
+// Numbers
+// ----------------------------------------------------------------------------
+
+static scheme_value_t* prim_add(scheme_interp_t* interp, scheme_value_t* args) {
+    double sum = 0.0;
+    for (; is_pair(args); args = cdr(args)) {
+        double x;
+        if (!number_arg(interp, "+", car(args), &x)) return NULL;
+        sum += x;
+    }
+    return scheme_make_number(interp, sum);
+}
+
+static scheme_value_t* prim_mul(scheme_interp_t* interp, scheme_value_t* args) {
+    double product = 1.0;
+    for (; is_pair(args); args = cdr(args)) {
+        double x;
+        if (!number_arg(interp, "*", car(args), &x)) return NULL;
+        product *= x;
+    }
+    return scheme_make_number(interp, product);
+}
+
+static scheme_value_t* prim_sub(scheme_interp_t* interp, scheme_value_t* args) {
+    double result;
+    if (!number_arg(interp, "-", first(args), &result)) return NULL;
+    if (cdr(args)->type == SCHEME_NIL) return scheme_make_number(interp, -result);
+    
+    for (args = cdr(args); is_pair(args); args = cdr(args)) {
+        double x;
+        if (!number_arg(interp, "-", car(args), &x)) return NULL;
+        result -= x;
+    }
+    return scheme_make_number(interp, result);
+}
+
+static scheme_value_t* prim_div(scheme_interp_t* interp, scheme_value_t* args) {
+    double result;
+    if (!number_arg(interp, "/", first(args), &result)) return NULL;
+    if (cdr(args)->type == SCHEME_NIL) return scheme_make_number(interp, 1.0 / result);
+    
+    for (args = cdr(args); is_pair(args); args = cdr(args)) {
+        double x;
+        if (!number_arg(interp, "/", car(args), &x)) return NULL;
+        result /= x;
+    }
+    return scheme_make_number(interp, result);
+}
+
+typedef enum {
+    COMPARE_EQ,
+    COMPARE_LT,
+    COMPARE_GT,
+    COMPARE_LE,
+    COMPARE_GE
+} compare_op_t;
+
+static scheme_value_t* compare_chain(scheme_interp_t* interp, scheme_value_t* args,
+                                     const char* name, compare_op_t op) {
+    double previous;
+    if (!number_arg(interp, name, first(args), &previous)) return NULL;
+    
+    bool holds = true;
+    for (args = cdr(args); is_pair(args); args = cdr(args)) {
+        double x;
+        if (!number_arg(interp, name, car(args), &x)) return NULL;
+        switch (op) {
+            case COMPARE_EQ: holds = holds && previous == x; break;
+            case COMPARE_LT: holds = holds && previous < x; break;
+            case COMPARE_GT: holds = holds && previous > x; break;
+            case COMPARE_LE: holds = holds && previous <= x; break;
+            case COMPARE_GE: holds = holds && previous >= x; break;
+        }
+        previous = x;
+    }
+    return scheme_boolean(holds);
+}
+
+static scheme_value_t* prim_num_eq(scheme_interp_t* interp, scheme_value_t* args) {
+    return compare_chain(interp, args, "=", COMPARE_EQ);
+}
+
+static scheme_value_t* prim_lt(scheme_interp_t* interp, scheme_value_t* args) {
+    return compare_chain(interp, args, "<", COMPARE_LT);
+}
+
+static scheme_value_t* prim_gt(scheme_interp_t* interp, scheme_value_t* args) {
+    return compare_chain(interp, args, ">", COMPARE_GT);
+}
+
+static scheme_value_t* prim_le(scheme_interp_t* interp, scheme_value_t* args) {
+    return compare_chain(interp, args, "<=", COMPARE_LE);
+}
+
+static scheme_value_t* prim_ge(scheme_interp_t* interp, scheme_value_t* args) {
+    return compare_chain(interp, args, ">=", COMPARE_GE);
+}
+
+static scheme_value_t* extremum(scheme_interp_t* interp, scheme_value_t* args,
+                                const char* name, bool maximum) {
+    double result;
+    if (!number_arg(interp, name, first(args), &result)) return NULL;
+    for (args = cdr(args); is_pair(args); args = cdr(args)) {
+        double x;
+        if (!number_arg(interp, name, car(args), &x)) return NULL;
+        if (maximum ? x > result : x < result) result = x;
+    }
+    return scheme_make_number(interp, result);
+}
+
+static scheme_value_t* prim_min(scheme_interp_t* interp, scheme_value_t* args) {
+    return extremum(interp, args, "min", false);
+}
+
+static scheme_value_t* prim_max(scheme_interp_t* interp, scheme_value_t* args) {
+    return extremum(interp, args, "max", true);
+}
+
+static scheme_value_t* unary_math(scheme_interp_t* interp, scheme_value_t* args,
+                                  const char* name, double (*fn)(double)) {
+    double x;
+    if (!number_arg(interp, name, first(args), &x)) return NULL;
+    return scheme_make_number(interp, fn(x));
+}
+
+static scheme_value_t* prim_abs(scheme_interp_t* interp, scheme_value_t* args) {
+    return unary_math(interp, args, "abs", fabs);
+}
+
+static scheme_value_t* prim_floor(scheme_interp_t* interp, scheme_value_t* args) {
+    return unary_math(interp, args, "floor", floor);
+}
+
+static scheme_value_t* prim_ceiling(scheme_interp_t* interp, scheme_value_t* args) {
+    return unary_math(interp, args, "ceiling", ceil);
+}
+
+static scheme_value_t* prim_round(scheme_interp_t* interp, scheme_value_t* args) {
+    // Ties to even, as R7RS specifies
+    return unary_math(interp, args, "round", nearbyint);
+}
+
+static scheme_value_t* prim_truncate(scheme_interp_t* interp, scheme_value_t* args) {
+    return unary_math(interp, args, "truncate", trunc);
+}
+
+static scheme_value_t* prim_sqrt(scheme_interp_t* interp, scheme_value_t* args) {
+    return unary_math(interp, args, "sqrt", sqrt);
+}
+
+static scheme_value_t* prim_exp(scheme_interp_t* interp, scheme_value_t* args) {
+    return unary_math(interp, args, "exp", exp);
+}
+
+static scheme_value_t* prim_log(scheme_interp_t* interp, scheme_value_t* args) {
+    return unary_math(interp, args, "log", log);
+}
+
+static scheme_value_t* prim_expt(scheme_interp_t* interp, scheme_value_t* args) {
+    double base, exponent;
+    if (!number_arg(interp, "expt", first(args), &base) ||
+        !number_arg(interp, "expt", second(args), &exponent)) {
+        return NULL;
+    }
+    return scheme_make_number(interp, pow(base, exponent));
+}
+
+static bool division_args(scheme_interp_t* interp, scheme_value_t* args, const char* name,
+                          double* dividend, double* divisor) {
+    if (!number_arg(interp, name, first(args), dividend) ||
+        !number_arg(interp, name, second(args), divisor)) {
+        return false;
+    }
+    if (*divisor == 0.0) {
+        scheme_fail(interp, "%s: division by zero", name);
+        return false;
+    }
+    return true;
+}
+
+static scheme_value_t* prim_quotient(scheme_interp_t* interp, scheme_value_t* args) {
+    double a, b;
+    if (!division_args(interp, args, "quotient", &a, &b)) return NULL;
+    return scheme_make_number(interp, trunc(a / b));
+}
+
+static scheme_value_t* prim_remainder(scheme_interp_t* interp, scheme_value_t* args) {
+    double a, b;
+    if (!division_args(interp, args, "remainder", &a, &b)) return NULL;
+    return scheme_make_number(interp, fmod(a, b));
+}
+
+static scheme_value_t* prim_modulo(scheme_interp_t* interp, scheme_value_t* args) {
+    double a, b;
+    if (!division_args(interp, args, "modulo", &a, &b)) return NULL;
+    double r = fmod(a, b);
+    if (r != 0.0 && (r < 0.0) != (b < 0.0)) r += b;
+    return scheme_make_number(interp, r);
+}
+
+static scheme_value_t* prim_is_number(scheme_interp_t* interp, scheme_value_t* args) {
+    (void)interp;
+    return scheme_boolean(first(args)->type == SCHEME_NUMBER);
+}
+
+static scheme_value_t* prim_is_integer(scheme_interp_t* interp, scheme_value_t* args) {
+    (void)interp;
+    const scheme_value_t* x = first(args);
+    return scheme_boolean(x->type == SCHEME_NUMBER && isfinite(x->as.number) &&
+                          x->as.number == floor(x->as.number));
+}
+
+static scheme_value_t* prim_is_zero(scheme_interp_t* interp, scheme_value_t* args) {
+    double x;
+    if (!number_arg(interp, "zero?", first(args), &x)) return NULL;
+    return scheme_boolean(x == 0.0);
+}
+
+static scheme_value_t* prim_is_positive(scheme_interp_t* interp, scheme_value_t* args) {
+    double x;
+    if (!number_arg(interp, "positive?", first(args), &x)) return NULL;
+    return scheme_boolean(x > 0.0);
+}
+
+static scheme_value_t* prim_is_negative(scheme_interp_t* interp, scheme_value_t* args) {
+    double x;
+    if (!number_arg(interp, "negative?", first(args), &x)) return NULL;
+    return scheme_boolean(x < 0.0);
+}
+
+static scheme_value_t* prim_is_even(scheme_interp_t* interp, scheme_value_t* args) {
+    double x;
+    if (!number_arg(interp, "even?", first(args), &x)) return NULL;
+    return scheme_boolean(fmod(x, 2.0) == 0.0);
+}
+
+static scheme_value_t* prim_is_odd(scheme_interp_t* interp, scheme_value_t* args) {
+    double x;
+    if (!number_arg(interp, "odd?", first(args), &x)) return NULL;
+    return scheme_boolean(fabs(fmod(x, 2.0)) == 1.0);
+}
+
+static scheme_value_t* prim_inexact(scheme_interp_t* interp, scheme_value_t* args) {
+    // Every number is already an inexact double
+    double x;
+    if (!number_arg(interp, "inexact", first(args), &x)) return NULL;
+    return first(args);
+}
+
+static scheme_value_t* prim_number_to_string(scheme_interp_t* interp, scheme_value_t* args) {
+    double x;
+    if (!number_arg(interp, "number->string", first(args), &x)) return NULL;
+    char text[32];
+    format_number(x, text, sizeof(text));
+    return scheme_make_string(interp, text, strlen(text));
+}
+
+static scheme_value_t* prim_string_to_number(scheme_interp_t* interp, scheme_value_t* args) {
+    if (!type_arg(interp, "string->number", first(args), SCHEME_STRING, "string")) return NULL;
+    double x;
+    const scheme_value_t* text = first(args);
+    if (!parse_number(text->as.string.chars, text->as.string.length, &x)) return &false_cell;
+    return scheme_make_number(interp, x);
+}
+
+// ----------------------------------------------------------------------------
+// Equivalence
+// ----------------------------------------------------------------------------
+
+static bool values_eqv(const scheme_value_t* a, const scheme_value_t* b) {
+    if (a == b) return true;
+    return a->type == SCHEME_NUMBER && b->type == SCHEME_NUMBER && a->as.number == b->as.number;
+}
+
+static bool tensors_equal(const neural_tensor_t* a, const neural_tensor_t* b) {
+    if (a->n_dims != b->n_dims || a->total_size != b->total_size) return false;
+    for (size_t i = 0; i < a->n_dims; i++) {
+        if (a->shape[i] != b->shape[i]) return false;
+    }
+    for (size_t i = 0; i < a->total_size; i++) {
+        if (a->data[i] != b->data[i]) return false;
+    }
+    return true;
+}
+
+/**
+ * equal?: structural comparison of pairs, strings and tensors
+ * Nesting past SCHEME_MAX_DEPTH or a circular list of a sets *too_deep and
+ * compares unequal.
+ */
+static bool values_equal(const scheme_value_t* a, const scheme_value_t* b, size_t depth,
+                         bool* too_deep) {
+    const scheme_value_t* slow = a;
+    size_t n_items = 0;
+    if (depth >= SCHEME_MAX_DEPTH) {
+        *too_deep = true;
+        return false;
+    }
+    
+    for (;;) {
+        if (values_eqv(a, b)) return true;
+        if (a->type != b->type) return false;
+    
+        switch (a->type) {
+            case SCHEME_STRING:
+                return a->as.string.length == b->as.string.length &&
+                       memcmp(a->as.string.chars, b->as.string.chars, a->as.string.length) == 0;
+            case SCHEME_TENSOR:
+                return tensors_equal(a->as.tensor, b->as.tensor);
+            case SCHEME_PAIR:
+                if (!values_equal(car(a), car(b), depth + 1, too_deep)) return false;
+                a = cdr(a);
+                b = cdr(b);
+                if ((++n_items & 1) == 0) slow = cdr(slow);
+                if (a == slow) {
+                    *too_deep = true;
+                    return false;
+                }
+                break;
+            default:
+                return false;
+        }
+    }
+}
+
+/**
+ * equal? for primitives: #t, #f, or an error when the values cannot be compared
+ */
+static scheme_value_t* equal_result(scheme_interp_t* interp, const char* name,
+                                    const scheme_value_t* a, const scheme_value_t* b) {
+    bool too_deep = false;
+    bool equal = values_equal(a, b, 0, &too_deep);
+    if (too_deep) return scheme_fail(interp, "%s: values nested too deeply or circular", name);
+    return scheme_boolean(equal);
+}
+
+static scheme_value_t* prim_eq(scheme_interp_t* interp, scheme_value_t* args) {
+    (void)interp;
+    return scheme_boolean(values_eqv(first(args), second(args)));
+}
+
+static scheme_value_t* prim_equal(scheme_interp_t* interp, scheme_value_t* args) {
+    return equal_result(interp, "equal?", first(args), second(args));
+}
+
+static scheme_value_t* prim_not(scheme_interp_t* interp, scheme_value_t* args) {
+    (void)interp;
+    return scheme_boolean(!scheme_is_true(first(args)));
+}
+
+static scheme_value_t* prim_is_boolean(scheme_interp_t* interp, scheme_value_t* args) {
+    (void)interp;
+    return scheme_boolean(first(args)->type == SCHEME_BOOLEAN);
+}
+
+// ----------------------------------------------------------------------------
+// Pairs and lists
+// ----------------------------------------------------------------------------
+
+static scheme_value_t* prim_cons(scheme_interp_t* interp, scheme_value_t* args) {
+    return scheme_cons(interp, first(args), second(args));
+}
+
+/**
+ * c[ad]+r accessors: the letters apply right to left
+ */
+static scheme_value_t* cxr(scheme_interp_t* interp, const char* name, scheme_value_t* value) {
+    for (size_t i = strlen(name) - 1; i-- > 1;) {
+        if (!type_arg(interp, name, value, SCHEME_PAIR, "pair")) return NULL;
+        value = (name[i] == 'a') ? car(value) : cdr(value);
+    }
+    return value;
+}
+
+static scheme_value_t* prim_car(scheme_interp_t* interp, scheme_value_t* args) {
+    return cxr(interp, "car", first(args));
+}
+
+static scheme_value_t* prim_cdr(scheme_interp_t* interp, scheme_value_t* args) {
+    return cxr(interp, "cdr", first(args));
+}
+
+static scheme_value_t* prim_caar(scheme_interp_t* interp, scheme_value_t* args) {
+    return cxr(interp, "caar", first(args));
+}
+
+static scheme_value_t* prim_cadr(scheme_interp_t* interp, scheme_value_t* args) {
+    return cxr(interp, "cadr", first(args));
+}
+
+static scheme_value_t* prim_cdar(scheme_interp_t* interp, scheme_value_t* args) {
+    return cxr(interp, "cdar", first(args));
+}
+
+static scheme_value_t* prim_cddr(scheme_interp_t* interp, scheme_value_t* args) {
+    return cxr(interp, "cddr", first(args));
+}
+
+static scheme_value_t* prim_caddr(scheme_interp_t* interp, scheme_value_t* args) {
+    return cxr(interp, "caddr", first(args));
+}
+
+static scheme_value_t* prim_cdddr(scheme_interp_t* interp, scheme_value_t* args) {
+    return cxr(interp, "cdddr", first(args));
+}
+
+static scheme_value_t* prim_cadddr(scheme_interp_t* interp, scheme_value_t* args) {
+    return cxr(interp, "cadddr", first(args));
+}
+
+static scheme_value_t* prim_set_car(scheme_interp_t* interp, scheme_value_t* args) {
+    if (!type_arg(interp, "set-car!", first(args), SCHEME_PAIR, "pair")) return NULL;
+    first(args)->as.pair.car = second(args);
+    return &unspecified_cell;
+}
+
+static scheme_value_t* prim_set_cdr(scheme_interp_t* interp, scheme_value_t* args) {
+    if (!type_arg(interp, "set-cdr!", first(args), SCHEME_PAIR, "pair")) return NULL;
+    first(args)->as.pair.cdr = second(args);
+    return &unspecified_cell;
+}
+
+static scheme_value_t* prim_list(scheme_interp_t* interp, scheme_value_t* args) {
+    // The argument list is freshly allocated for every call
+    (void)interp;
+    return args;
+}
+
+static scheme_value_t* prim_length(scheme_interp_t* interp, scheme_value_t* args) {
+    size_t length = list_length(first(args));
+    if (length == SIZE_MAX) return scheme_fail(interp, "length: expected a list");
+    return scheme_make_number(interp, (double)length);
+}
+
+static scheme_value_t* prim_append(scheme_interp_t* interp, scheme_value_t* args) {
+    if (args->type == SCHEME_NIL) return &nil_cell;
+    if (!reserve_roots(interp, 1)) return scheme_fail(interp, "out of memory");
+    
+    scheme_value_t* result = &nil_cell;
+    scheme_value_t* tail = NULL;
+    ROOT(interp, result);
+    
+    // Every list but the last is copied; the last is shared
+    for (; is_pair(cdr(args)); args = cdr(args)) {
+        scheme_value_t* list = car(args);
+        for (; is_pair(list); list = cdr(list)) {
+            scheme_value_t* cell = scheme_cons(interp, car(list), &nil_cell);
+            if (!cell) goto fail;
+            if (tail) {
+                tail->as.pair.cdr = cell;
+            } else {
+                result = cell;
+            }
+            tail = cell;
+        }
+        if (list->type != SCHEME_NIL) {
+            scheme_fail(interp, "append: expected a list");
+            goto fail;
+        }
+    }
+    if (tail) {
+        tail->as.pair.cdr = car(args);
+    } else {
+        result = car(args);
+    }
+    interp->n_roots--;
+    return result;
+    
+fail:
+    interp->n_roots--;
+    return NULL;
+}
+
+static scheme_value_t* prim_reverse(scheme_interp_t* interp, scheme_value_t* args) {
+    if (!reserve_roots(interp, 1)) return scheme_fail(interp, "out of memory");
+    scheme_value_t* result = &nil_cell;
+    ROOT(interp, result);
+    
+    scheme_value_t* list = first(args);
+    for (; is_pair(list) && result; list = cdr(list)) {
+        result = scheme_cons(interp, car(list), result);
+    }
+    if (result && list->type != SCHEME_NIL) result = scheme_fail(interp, "reverse: expected a list");
+    
+    interp->n_roots--;
+    return result;
+}
+
+static scheme_value_t* list_tail(scheme_interp_t* interp, scheme_value_t* args, const char* name) {
+    size_t k;
+    if (!index_arg(interp, name, second(args), &k)) return NULL;
+    scheme_value_t* list = first(args);
+    for (; k > 0; k--) {
+        if (!is_pair(list)) return scheme_fail(interp, "%s: index out of range", name);
+        list = cdr(list);
+    }
+    return list;
+}
+
+static scheme_value_t* prim_list_tail(scheme_interp_t* interp, scheme_value_t* args) {
+    return list_tail(interp, args, "list-tail");
+}
+
+static scheme_value_t* prim_list_ref(scheme_interp_t* interp, scheme_value_t* args) {
+    scheme_value_t* tail = list_tail(interp, args, "list-ref");
+    if (!tail) return NULL;
+    if (!is_pair(tail)) return scheme_fail(interp, "list-ref: index out of range");
+    return car(tail);
+}
+
+/**
+ * memq/member (sublist starting at the item) and assq/assoc (the pair)
+ * structural selects equal? over eqv?.
+ */
+static scheme_value_t* search_list(scheme_interp_t* interp, const char* name,
+                                   scheme_value_t* item, scheme_value_t* list, bool by_key,
+                                   bool structural) {
+    if (list_length(list) == SIZE_MAX) return scheme_fail(interp, "%s: expected a list", name);
+    
+    bool too_deep = false;
+    for (; is_pair(list); list = cdr(list)) {
+        scheme_value_t* candidate = car(list);
+        if (by_key) {
+            if (!is_pair(candidate)) continue;
+            candidate = car(candidate);
+        }
+        bool same = structural ? values_equal(item, candidate, 0, &too_deep)
+                               : values_eqv(item, candidate);
+        if (too_deep) return scheme_fail(interp, "%s: values nested too deeply or circular", name);
+        if (same) return by_key ? car(list) : list;
+    }
+    return &false_cell;
+}
+
+static scheme_value_t* prim_memq(scheme_interp_t* interp, scheme_value_t* args) {
+    return search_list(interp, "memq", first(args), second(args), false, false);
+}
+
+static scheme_value_t* prim_member(scheme_interp_t* interp, scheme_value_t* args) {
+    return search_list(interp, "member", first(args), second(args), false, true);
+}
+
+static scheme_value_t* prim_assq(scheme_interp_t* interp, scheme_value_t* args) {
+    return search_list(interp, "assq", first(args), second(args), true, false);
+}
+
+static scheme_value_t* prim_assoc(scheme_interp_t* interp, scheme_value_t* args) {
+    return search_list(interp, "assoc", first(args), second(args), true, true);
+}
+
+static scheme_value_t* prim_is_null(scheme_interp_t* interp, scheme_value_t* args) {
+    (void)interp;
+    return scheme_boolean(first(args)->type == SCHEME_NIL);
+}
+
+static scheme_value_t* prim_is_pair(scheme_interp_t* interp, scheme_value_t* args) {
+    (void)interp;
+    return scheme_boolean(is_pair(first(args)));
+}
+
+static scheme_value_t* prim_is_list(scheme_interp_t* interp, scheme_value_t* args) {
+    (void)interp;
+    return scheme_boolean(list_length(first(args)) != SIZE_MAX);
+}
+
+// ----------------------------------------------------------------------------
+// Symbols and strings
+// ----------------------------------------------------------------------------
+
+static scheme_value_t* prim_is_symbol(scheme_interp_t* interp, scheme_value_t* args) {
+    (void)interp;
+    return scheme_boolean(first(args)->type == SCHEME_SYMBOL);
+}
+
+static scheme_value_t* prim_is_string(scheme_interp_t* interp, scheme_value_t* args) {
+    (void)interp;
+    return scheme_boolean(first(args)->type == SCHEME_STRING);
+}
+
+static scheme_value_t* prim_symbol_to_string(scheme_interp_t* interp, scheme_value_t* args) {
+    if (!type_arg(interp, "symbol->string", first(args), SCHEME_SYMBOL, "symbol")) return NULL;
+    const char* name = first(args)->as.symbol.name;
+    return scheme_make_string(interp, name, strlen(name));
+}
+
+static scheme_value_t* prim_string_to_symbol(scheme_interp_t* interp, scheme_value_t* args) {
+    if (!type_arg(interp, "string->symbol", first(args), SCHEME_STRING, "string")) return NULL;
+    return intern_n(interp, first(args)->as.string.chars, first(args)->as.string.length);
+}
+
+static scheme_value_t* prim_string_length(scheme_interp_t* interp, scheme_value_t* args) {
+    if (!type_arg(interp, "string-length", first(args), SCHEME_STRING, "string")) return NULL;
+    return scheme_make_number(interp, (double)first(args)->as.string.length);
+}
+
+static scheme_value_t* prim_string_append(scheme_interp_t* interp, scheme_value_t* args) {
+    text_builder_t builder = {NULL, 0, 0, false, false};
+    builder_append(&builder, "", 0);
+    for (; is_pair(args); args = cdr(args)) {
+        if (!type_arg(interp, "string-append", car(args), SCHEME_STRING, "string")) {
+            free(builder.data);
+            return NULL;
+        }
+        builder_append(&builder, car(args)->as.string.chars, car(args)->as.string.length);
+    }
+    
+    scheme_value_t* result = builder.failed ? scheme_fail(interp, "out of memory")
+                                            : scheme_make_string(interp, builder.data, builder.length);
+    free(builder.data);
+    return result;
+}
+
+static scheme_value_t* prim_substring(scheme_interp_t* interp, scheme_value_t* args) {
+    if (!type_arg(interp, "substring", first(args), SCHEME_STRING, "string")) return NULL;
+    const scheme_value_t* text = first(args);
+    size_t start, end = text->as.string.length;
+    if (!index_arg(interp, "substring", second(args), &start)) return NULL;
+    if (is_pair(cdr(cdr(args))) && !index_arg(interp, "substring", third(args), &end)) return NULL;
+    if (start > end || end > text->as.string.length) {
+        return scheme_fail(interp, "substring: range out of bounds");
+    }
+    return scheme_make_string(interp, text->as.string.chars + start, end - start);
+}
+
+static scheme_value_t* prim_string_eq(scheme_interp_t* interp, scheme_value_t* args) {
+    if (!type_arg(interp, "string=?", first(args), SCHEME_STRING, "string") ||
+        !type_arg(interp, "string=?", second(args), SCHEME_STRING, "string")) {
+        return NULL;
+    }
+    return equal_result(interp, "string=?", first(args), second(args));
+}
+
+// ----------------------------------------------------------------------------
+// Control
+// ----------------------------------------------------------------------------
+
+static scheme_value_t* prim_is_procedure(scheme_interp_t* interp, scheme_value_t* args) {
+    (void)interp;
+    return scheme_boolean(first(args)->type == SCHEME_CLOSURE ||
+                          first(args)->type == SCHEME_PRIMITIVE);
+}
+
+/**
+ * (apply f a ... list): the spread arguments and the list are copied
+ */
+static scheme_value_t* prim_apply(scheme_interp_t* interp, scheme_value_t* args) {
+    if (!reserve_roots(interp, 1)) return scheme_fail(interp, "out of memory");
+    scheme_value_t* call_args = &nil_cell;
+    scheme_value_t* tail = NULL;
+    scheme_value_t* result = NULL;
+    ROOT(interp, call_args);
+    
+    for (scheme_value_t* arg = cdr(args); is_pair(arg); arg = cdr(arg)) {
+        scheme_value_t* items = car(arg);
+        bool spread = !is_pair(cdr(arg));
+        if (spread && list_length(items) == SIZE_MAX) {
+            scheme_fail(interp, "apply: last argument must be a list");
+            goto done;
+        }
+        for (; spread ? is_pair(items) : items != NULL; items = spread ? cdr(items) : NULL) {
+            scheme_value_t* cell = scheme_cons(interp, spread ? car(items) : items, &nil_cell);
+            if (!cell) goto done;
+            if (tail) {
+                tail->as.pair.cdr = cell;
+            } else {
+                call_args = cell;
+            }
+            tail = cell;
+        }
+    }
+    result = apply_procedure(interp, first(args), call_args);
+    
+done:
+    interp->n_roots--;
+    return result;
+}
+
+/**
+ * map / for-each over one or more lists, stopping at the shortest
+ */
+static scheme_value_t* map_lists(scheme_interp_t* interp, scheme_value_t* args, const char* name,
+                                 bool collect) {
+    scheme_value_t* procedure = first(args);
+    size_t n_lists = list_length(cdr(args));
+    scheme_value_t** cursors = (scheme_value_t**)malloc(n_lists * sizeof(scheme_value_t*));
+    if (!cursors || !reserve_roots(interp, 2)) {
+        free(cursors);
+        return scheme_fail(interp, "out of memory");
+    }
+    
+    scheme_value_t* result = &nil_cell;
+    scheme_value_t* call_args = &nil_cell;
+    scheme_value_t* tail = NULL;
+    ROOT(interp, result);
+    ROOT(interp, call_args);
+    
+    size_t i = 0;
+    for (scheme_value_t* list = cdr(args); is_pair(list); list = cdr(list)) {
+        if (list_length(car(list)) == SIZE_MAX) {
+            result = scheme_fail(interp, "%s: expected lists", name);
+            goto done;
+        }
+        cursors[i++] = car(list);
+    }
+    
+    for (;;) {
+        for (i = 0; i < n_lists; i++) {
+            if (!is_pair(cursors[i])) goto done;
+        }
+    
+        call_args = &nil_cell;
+        for (i = n_lists; i-- > 0;) {
+            if (!(call_args = scheme_cons(interp, car(cursors[i]), call_args))) {
+                result = NULL;
+                goto done;
+            }
+            cursors[i] = cdr(cursors[i]);
+        }
+    
+        scheme_value_t* value = apply_procedure(interp, procedure, call_args);
+        if (!value) {
+            result = NULL;
+            goto done;
+        }
+        if (collect) {
+            scheme_value_t* cell = scheme_cons(interp, value, &nil_cell);
+            if (!cell) {
+                result = NULL;
+                goto done;
+            }
+            if (tail) {
+                tail->as.pair.cdr = cell;
+            } else {
+                result = cell;
+            }
+            tail = cell;
+        }
+    }
+    
+done:
+    free(cursors);
+    interp->n_roots -= 2;
+    if (!result) return NULL;
+    return collect ? result : &unspecified_cell;
+}
+
+static scheme_value_t* prim_map(scheme_interp_t* interp, scheme_value_t* args) {
+    return map_lists(interp, args, "map", true);
+}
+
+static scheme_value_t* prim_for_each(scheme_interp_t* interp, scheme_value_t* args) {
+    return map_lists(interp, args, "for-each", false);
+}
+
+static scheme_value_t* prim_filter(scheme_interp_t* interp, scheme_value_t* args) {
+    if (list_length(second(args)) == SIZE_MAX) return scheme_fail(interp, "filter: expected a list");
+    if (!reserve_roots(interp, 2)) return scheme_fail(interp, "out of memory");
+    
+    scheme_value_t* result = &nil_cell;
+    scheme_value_t* call_args = &nil_cell;
+    scheme_value_t* tail = NULL;
+    ROOT(interp, result);
+    ROOT(interp, call_args);
+    
+    for (scheme_value_t* list = second(args); is_pair(list); list = cdr(list)) {
+        scheme_value_t* keep;
+        if (!(call_args = scheme_cons(interp, car(list), &nil_cell)) ||
+            !(keep = apply_procedure(interp, first(args), call_args))) {
+            result = NULL;
+            break;
+        }
+        if (!scheme_is_true(keep)) continue;
+    
+        scheme_value_t* cell = scheme_cons(interp, car(list), &nil_cell);
+        if (!cell) {
+            result = NULL;
+            break;
+        }
+        if (tail) {
+            tail->as.pair.cdr = cell;
+        } else {
+            result = cell;
+        }
+        tail = cell;
+    }
+    
+    interp->n_roots -= 2;
+    return result;
+}
+
+/**
+ * (error message irritant ...)
+ */
+static scheme_value_t* prim_error(scheme_interp_t* interp, scheme_value_t* args) {
+    text_builder_t builder = {NULL, 0, 0, false, false};
+    builder_append(&builder, "", 0);
+    print_value(&builder, first(args), true, 0);
+    for (args = cdr(args); is_pair(args); args = cdr(args)) {
+        builder_text(&builder, " ");
+        print_value(&builder, car(args), false, 0);
+    }
+    
+    scheme_fail(interp, "%s", builder.failed ? "error" : builder.data);
+    free(builder.data);
+    return NULL;
+}
+
+static scheme_value_t* eval_file(scheme_interp_t* interp, const char* path);
+
+static scheme_value_t* prim_load(scheme_interp_t* interp, scheme_value_t* args) {
+    if (!type_arg(interp, "load", first(args), SCHEME_STRING, "string")) return NULL;
+    return eval_file(interp, first(args)->as.string.chars) ? &unspecified_cell : NULL;
+}
+
+// ----------------------------------------------------------------------------
+// Output
+// ----------------------------------------------------------------------------
+
+static scheme_value_t* print_to_output(scheme_interp_t* interp, scheme_value_t* value,
+                                       bool display) {
+    text_builder_t builder = {NULL, 0, 0, false, false};
+    print_value(&builder, value, display, 0);
+    if (builder.failed) {
+        free(builder.data);
+        return builder.unprintable
+            ? scheme_fail(interp, "%s: value nested too deeply or circular",
+                          display ? "display" : "write")
+            : scheme_fail(interp, "out of memory");
+    }
+    if (builder.length > 0) fwrite(builder.data, 1, builder.length, interp->output);
+    free(builder.data);
+    return &unspecified_cell;
+}
+
+static scheme_value_t* prim_display(scheme_interp_t* interp, scheme_value_t* args) {
+    return print_to_output(interp, first(args), true);
+}
+
+static scheme_value_t* prim_write(scheme_interp_t* interp, scheme_value_t* args) {
+    return print_to_output(interp, first(args), false);
+}
+
+static scheme_value_t* prim_newline(scheme_interp_t* interp, scheme_value_t* args) {
+    (void)args;
+    fputc('\n', interp->output);
+    return &unspecified_cell;
+}
+
+// ----------------------------------------------------------------------------
+// Tensors
+// ----------------------------------------------------------------------------
+
+/**
+ * Tensor from a shape list and a fill value, a flat data list, or NULL (zeros)
+ */
+static neural_tensor_t* tensor_from_lists(scheme_interp_t* interp, const char* name,
+                                          const scheme_value_t* shape_list,
+                                          const scheme_value_t* init) {
+    size_t shape[SCHEME_TENSOR_MAX_RANK];
+    size_t n_dims = 0;
+    size_t total = 1;
+    for (; is_pair(shape_list); shape_list = cdr(shape_list)) {
+        if (n_dims == SCHEME_TENSOR_MAX_RANK) {
+            scheme_fail(interp, "%s: rank exceeds %d", name, SCHEME_TENSOR_MAX_RANK);
+            return NULL;
+        }
+        size_t dim;
+        if (!index_arg(interp, name, car(shape_list), &dim)) return NULL;
+        if (dim == 0 || total > SIZE_MAX / sizeof(float) / dim) {
+            scheme_fail(interp, "%s: dimensions must be positive and fit in memory", name);
+            return NULL;
+        }
+        shape[n_dims++] = dim;
+        total *= dim;
+    }
+    if (n_dims == 0 || shape_list->type != SCHEME_NIL) {
+        scheme_fail(interp, "%s: shape must be a non-empty list", name);
+        return NULL;
+    }
+    
+    double fill = 0.0;
+    if (init && init->type == SCHEME_NUMBER) {
+        fill = init->as.number;
+    } else if (init && list_length(init) != total) {
+        scheme_fail(interp, "%s: expected %zu data values", name, total);
+        return NULL;
+    }
+    
+    neural_tensor_t* tensor = neural_tensor_create(shape, n_dims);
+    if (!tensor) {
+        scheme_fail(interp, "out of memory");
+        return NULL;
+    }
+    
+    if (init && init->type != SCHEME_NUMBER) {
+        size_t i = 0;
+        for (; is_pair(init); init = cdr(init)) {
+            double x;
+            if (!number_arg(interp, name, car(init), &x)) {
+                neural_tensor_free(tensor);
+                return NULL;
+            }
+            tensor->data[i++] = (float)x;
+        }
+    } else if (fill != 0.0) {
+        for (size_t i = 0; i < total; i++) tensor->data[i] = (float)fill;
+    }
+    return tensor;
+}
+
+/**
+ * (make-tensor shape [fill-or-data])
+ */
+static scheme_value_t* prim_make_tensor(scheme_interp_t* interp, scheme_value_t* args) {
+    scheme_value_t* init = is_pair(cdr(args)) ? second(args) : NULL;
+    if (init && init->type != SCHEME_NUMBER && !is_pair(init)) {
+        return scheme_fail(interp, "make-tensor: expected a fill number or a data list");
+    }
+    neural_tensor_t* tensor = tensor_from_lists(interp, "make-tensor", first(args), init);
+    return tensor ? scheme_make_tensor(interp, tensor) : NULL;
+}
+
+static bool headed_by(const scheme_value_t* list, const char* name) {
+    return is_pair(list) && car(list)->type == SCHEME_SYMBOL &&
+           strcmp(car(list)->as.symbol.name, name) == 0;
+}
+
+/**
+ * (datum->tensor '(tensor (shape d ...) (data v ...))), the bridge text form
+ */
+static scheme_value_t* prim_datum_to_tensor(scheme_interp_t* interp, scheme_value_t* args) {
+    const scheme_value_t* datum = first(args);
+    if (!headed_by(datum, "tensor") || list_length(datum) != 3 ||
+        !headed_by(car(cdr(datum)), "shape") || !headed_by(car(cdr(cdr(datum))), "data")) {
+        return scheme_fail(interp, "datum->tensor: expected (tensor (shape ...) (data ...))");
+    }
+    neural_tensor_t* tensor = tensor_from_lists(interp, "datum->tensor", cdr(car(cdr(datum))),
+                                                cdr(car(cdr(cdr(datum)))));
+    return tensor ? scheme_make_tensor(interp, tensor) : NULL;
+}
+
+static scheme_value_t* prim_tensor_to_datum(scheme_interp_t* interp, scheme_value_t* args) {
+    const neural_tensor_t* tensor = tensor_arg(interp, "tensor->datum", first(args));
+    if (!tensor || !reserve_roots(interp, 2)) return tensor ? scheme_fail(interp, "out of memory") : NULL;
+    
+    scheme_value_t* data = NULL;
+    scheme_value_t* shape = NULL;
+    ROOT(interp, data);
+    ROOT(interp, shape);
+    
+    scheme_value_t* result = NULL;
+    scheme_value_t* symbol;
+    if ((data = list_from_floats(interp, tensor->data, tensor->total_size)) &&
+        (symbol = scheme_intern(interp, "data")) && (data = scheme_cons(interp, symbol, data)) &&
+        (data = scheme_cons(interp, data, &nil_cell)) &&
+        (shape = list_from_sizes(interp, tensor->shape, tensor->n_dims)) &&
+        (symbol = scheme_intern(interp, "shape")) && (shape = scheme_cons(interp, symbol, shape)) &&
+        (data = scheme_cons(interp, shape, data)) &&
+        (symbol = scheme_intern(interp, "tensor"))) {
+        result = scheme_cons(interp, symbol, data);
+    }
+    
+    interp->n_roots -= 2;
+    return result;
+}
+
+static scheme_value_t* prim_is_tensor(scheme_interp_t* interp, scheme_value_t* args) {
+    (void)interp;
+    return scheme_boolean(first(args)->type == SCHEME_TENSOR);
+}
+
+static scheme_value_t* prim_tensor_shape(scheme_interp_t* interp, scheme_value_t* args) {
+    const neural_tensor_t* tensor = tensor_arg(interp, "tensor-shape", first(args));
+    return tensor ? list_from_sizes(interp, tensor->shape, tensor->n_dims) : NULL;
+}
+
+static scheme_value_t* prim_tensor_size(scheme_interp_t* interp, scheme_value_t* args) {
+    const neural_tensor_t* tensor = tensor_arg(interp, "tensor-size", first(args));
+    return tensor ? scheme_make_number(interp, (double)tensor->total_size) : NULL;
+}
+
+static scheme_value_t* prim_tensor_to_list(scheme_interp_t* interp, scheme_value_t* args) {
+    const neural_tensor_t* tensor = tensor_arg(interp, "tensor->list", first(args));
+    return tensor ? list_from_floats(interp, tensor->data, tensor->total_size) : NULL;
+}
+
+/**
+ * (tensor-ref t i0 i1 ...) with one index per dimension, or one flat index
+ */
+static scheme_value_t* prim_tensor_ref(scheme_interp_t* interp, scheme_value_t* args) {
+    const neural_tensor_t* tensor = tensor_arg(interp, "tensor-ref", first(args));
+    if (!tensor) return NULL;
+    
+    scheme_value_t* indices = cdr(args);
+    size_t n_indices = list_length(indices);
+    if (n_indices != 1 && n_indices != tensor->n_dims) {
+        return scheme_fail(interp, "tensor-ref: expected 1 or %zu indices", tensor->n_dims);
+    }
+    
+    size_t offset = 0;
+    for (size_t d = 0; d < n_indices; d++, indices = cdr(indices)) {
+        size_t index;
+        size_t extent = (n_indices == 1) ? tensor->total_size : tensor->shape[d];
+        if (!index_arg(interp, "tensor-ref", car(indices), &index)) return NULL;
+        if (index >= extent) return scheme_fail(interp, "tensor-ref: index out of range");
+        offset = offset * extent + index;
+    }
+    return scheme_make_number(interp, (double)tensor->data[offset]);
+}
+
+// ----------------------------------------------------------------------------
+// Neural operations
+// ----------------------------------------------------------------------------
+
+static cognitive_context_t* context_arg(scheme_interp_t* interp, const char* name) {
+    if (!interp->context) scheme_fail(interp, "%s: the interpreter has no cognitive context", name);
+    return interp->context;
+}
+
+/**
+ * Active nodes, each as its concept symbol when named and its index otherwise
+ * Symbols are permanent, so the per-node symbol array needs no interning here.
+ */
+static scheme_value_t* node_list(scheme_interp_t* interp, const size_t* nodes, size_t n) {
+    if (!interp->concept_symbols) return list_from_sizes(interp, nodes, n);
+    if (!reserve_roots(interp, 1)) return scheme_fail(interp, "out of memory");
+    
+    scheme_value_t* list = &nil_cell;
+    ROOT(interp, list);
+    for (size_t i = n; i-- > 0 && list;) {
+        scheme_value_t* item = interp->concept_symbols[nodes[i]];
+        if (!item) item = scheme_make_number(interp, (double)nodes[i]);
+        list = item ? scheme_cons(interp, item, list) : NULL;
+    }
+    
+    interp->n_roots--;
+    return list;
+}
+
+static scheme_value_t* active_list(scheme_interp_t* interp, const cognitive_context_t* context) {
+    size_t n_active = 0;
+    const size_t* active = activation_landscape_active_set(context->landscape, &n_active);
+    return node_list(interp, active, n_active);
+}
+
+/**
+ * Node of a registered concept name; fails naming the concept otherwise
+ */
+static bool concept_arg(scheme_interp_t* interp, const char* name, const scheme_value_t* value,
+                        size_t* node) {
+    const char* concept = name_arg(interp, name, value);
+    if (!concept) return false;
+    *node = interp->concepts ? concept_table_node(interp->concepts, concept) : SIZE_MAX;
+    if (*node == SIZE_MAX) scheme_fail(interp, "%s: unknown concept %s", name, concept);
+    return *node != SIZE_MAX;
+}
+
+static concept_table_t* concepts_arg(scheme_interp_t* interp, const char* name) {
+    cognitive_context_t* context = context_arg(interp, name);
+    if (!context || interp->concepts) return interp->concepts;
+    
+    size_t n_nodes = context->landscape->n_nodes;
+    interp->concepts = concept_table_create(n_nodes);
+    interp->concept_symbols = (scheme_value_t**)calloc(n_nodes, sizeof(scheme_value_t*));
+    if (!interp->concepts || !interp->concept_symbols) {
+        concept_table_free(interp->concepts);
+        free(interp->concept_symbols);
+        interp->concepts = NULL;
+        interp->concept_symbols = NULL;
+        scheme_fail(interp, "out of memory");
+    }
+    return interp->concepts;
+}
+
+/**
+ * (register-concepts node name ...) names node, node + 1, ... -> count
+ */
+static scheme_value_t* prim_register_concepts(scheme_interp_t* interp, scheme_value_t* args) {
+    concept_table_t* concepts = concepts_arg(interp, "register-concepts");
+    size_t node;
+    if (!concepts || !index_arg(interp, "register-concepts", first(args), &node)) return NULL;
+    
+    // The names stay reachable through args; interned symbols are never collected
+    size_t n_names = list_length(cdr(args));
+    const char** names = (const char**)malloc((n_names ? n_names : 1) * sizeof(const char*));
+    if (!names) return scheme_fail(interp, "out of memory");
+    size_t i = 0;
+    for (scheme_value_t* list = cdr(args); is_pair(list); list = cdr(list), i++) {
+        names[i] = name_arg(interp, "register-concepts", car(list));
+        if (!names[i] || !scheme_intern(interp, names[i])) {
+            free(names);
+            return NULL;
+        }
+    }
+    
+    // All or nothing, with the same checks as the bridge command
+    if (!concept_table_register_all(concepts, names, n_names, node)) {
+        free(names);
+        return scheme_fail(interp, "register-concepts: a name is already registered or a node "
+                           "is unavailable");
+    }
+    for (i = 0; i < n_names; i++) {
+        interp->concept_symbols[node + i] = scheme_intern(interp, names[i]);
+    }
+    free(names);
+    return scheme_make_number(interp, (double)n_names);
+}
+
+static scheme_value_t* prim_concept_node(scheme_interp_t* interp, scheme_value_t* args) {
+    const char* name = name_arg(interp, "concept-node", first(args));
+    if (!name) return NULL;
+    size_t node = concept_table_node(interp->concepts, name);
+    return node == SIZE_MAX ? &false_cell : scheme_make_number(interp, (double)node);
+}
+
+static scheme_value_t* prim_concept_name(scheme_interp_t* interp, scheme_value_t* args) {
+    size_t node;
+    if (!index_arg(interp, "concept-name", first(args), &node)) return NULL;
+    if (!interp->concept_symbols || node >= interp->concepts->n_nodes) return &false_cell;
+    scheme_value_t* symbol = interp->concept_symbols[node];
+    return symbol ? symbol : &false_cell;
+}
+
+/**
+ * (neural-compute op t ...) or, as cognitive-grammar.scm builds it,
+ * (neural-compute op (list t ...))
+ */
+static scheme_value_t* prim_neural_compute(scheme_interp_t* interp, scheme_value_t* args) {
+    const char* operation = name_arg(interp, "neural-compute", first(args));
+    if (!operation) return NULL;
+    
+    scheme_value_t* operands = cdr(args);
+    if (list_length(operands) == 1 && list_length(car(operands)) != SIZE_MAX) {
+        operands = car(operands);
+    }
+    
+    const neural_tensor_t* inputs[SCHEME_MAX_OPERANDS];
+    size_t n_inputs = 0;
+    for (; is_pair(operands); operands = cdr(operands)) {
+        if (n_inputs == SCHEME_MAX_OPERANDS) {
+            return scheme_fail(interp, "neural-compute: at most %d operands", SCHEME_MAX_OPERANDS);
+        }
+        if (!(inputs[n_inputs++] = tensor_arg(interp, "neural-compute", car(operands)))) return NULL;
+    }
+    
+    neural_tensor_t* result = neural_execute(operation, inputs, n_inputs);
+    if (!result) return scheme_fail(interp, "neural-compute: %s failed on its operands", operation);
+    return scheme_make_tensor(interp, result);
+}
+
+/**
+ * (encode form): a symbol or string encodes its text, any other datum its
+ * written form, as the bridge's encode command does; a tensor is returned as is
+ */
+static scheme_value_t* prim_encode(scheme_interp_t* interp, scheme_value_t* args) {
+    scheme_value_t* form = first(args);
+    if (form->type == SCHEME_TENSOR) return form;
+    
+    char* written = NULL;
+    const char* text;
+    if (form->type == SCHEME_SYMBOL || form->type == SCHEME_STRING) {
+        text = name_arg(interp, "encode", form);
+    } else if (!(text = written = scheme_value_to_string(form, false))) {
+        return scheme_fail(interp, "encode: cannot write the form");
+    }
+    neural_tensor_t* tensor = encode_symbolic(text);
+    free(written);
+    if (!tensor) return scheme_fail(interp, "out of memory");
+    return scheme_make_tensor(interp, tensor);
+}
+
+static scheme_value_t* prim_decode(scheme_interp_t* interp, scheme_value_t* args) {
+    const neural_tensor_t* tensor = tensor_arg(interp, "decode", first(args));
+    if (!tensor) return NULL;
+    char* text = decode_neural(tensor);
+    if (!text) return scheme_fail(interp, "out of memory");
+    scheme_value_t* result = scheme_make_string(interp, text, strlen(text));
+    free(text);
+    return result;
+}
+
+/**
+ * The interpreter's encoder, created on first use one value per node of the
+ * context's landscape wide (BRIDGE_DEFAULT_NODES without a context)
+ */
+static symbol_encoder_t* interp_encoder(scheme_interp_t* interp) {
+    if (!interp->encoder) {
+        size_t dim = interp->context ? interp->context->landscape->n_nodes : BRIDGE_DEFAULT_NODES;
+        symbol_encoder_config_t config = symbol_encoder_default_config(dim);
+        if (!(interp->encoder = symbol_encoder_create(&config))) {
+            scheme_fail(interp, "out of memory");
+        }
+    }
+    return interp->encoder;
+}
+
+/**
+ * (embed name) -> fixed-width hashed n-gram embedding
+ */
+static scheme_value_t* prim_embed(scheme_interp_t* interp, scheme_value_t* args) {
+    const char* text = name_arg(interp, "embed", first(args));
+    symbol_encoder_t* encoder = text ? interp_encoder(interp) : NULL;
+    if (!encoder) return NULL;
+    
+    neural_tensor_t* tensor = symbol_encoder_encode(encoder, text);
+    return tensor ? scheme_make_tensor(interp, tensor) : scheme_fail(interp, "out of memory");
+}
+
+/**
+ * (embed-batch (name ...)) -> [n, dim] tensor of embeddings, one row per
+ * name, ready for attention
+ */
+static scheme_value_t* prim_embed_batch(scheme_interp_t* interp, scheme_value_t* args) {
+    scheme_value_t* list = first(args);
+    size_t n_texts = list_length(list);
+    if (n_texts == SIZE_MAX || n_texts == 0) {
+        return scheme_fail(interp, "embed-batch: expected a non-empty list of names");
+    }
+    symbol_encoder_t* encoder = interp_encoder(interp);
+    if (!encoder) return NULL;
+    
+    // The names stay reachable through args for the whole call
+    const char** texts = (const char**)malloc(n_texts * sizeof(const char*));
+    if (!texts) return scheme_fail(interp, "out of memory");
+    for (size_t i = 0; i < n_texts; i++, list = cdr(list)) {
+        if (!(texts[i] = name_arg(interp, "embed-batch", car(list)))) {
+            free(texts);
+            return NULL;
+        }
+    }
+    
+    neural_tensor_t* tensor = symbol_encoder_encode_batch(encoder, texts, n_texts);
+    free(texts);
+    return tensor ? scheme_make_tensor(interp, tensor) : scheme_fail(interp, "out of memory");
+}
+
+static scheme_value_t* prim_similarity(scheme_interp_t* interp, scheme_value_t* args) {
+    const neural_tensor_t* a = tensor_arg(interp, "similarity", first(args));
+    const neural_tensor_t* b = a ? tensor_arg(interp, "similarity", second(args)) : NULL;
+    if (!b) return NULL;
+    if (a->total_size != b->total_size) return scheme_fail(interp, "similarity: sizes differ");
+    return scheme_make_number(interp, symbol_embedding_cosine(a->data, b->data, a->total_size));
+}
+
+/**
+ * (attention concepts weights), as cognitive-grammar.scm calls it: a query
+ * weighting registered concepts (the bridge's two-list attention)
+ */
+static scheme_value_t* attend_concepts(scheme_interp_t* interp, cognitive_context_t* context,
+                                       scheme_value_t* concepts, scheme_value_t* weights) {
+    size_t n = list_length(concepts);
+    if (n == SIZE_MAX || list_length(weights) != n) {
+        return scheme_fail(interp, "attention: expected a list of concepts and one weight each");
+    }
+    
+    size_t* nodes = (size_t*)malloc((n ? n : 1) * sizeof(size_t));
+    float* values = (float*)malloc((n ? n : 1) * sizeof(float));
+    bool ok = nodes && values;
+    if (!ok) scheme_fail(interp, "out of memory");
+    for (size_t i = 0; ok && i < n; i++, concepts = cdr(concepts), weights = cdr(weights)) {
+        double weight = 0.0;
+        ok = concept_arg(interp, "attention", car(concepts), &nodes[i]) &&
+             number_arg(interp, "attention", car(weights), &weight);
+        values[i] = (float)weight;
+    }
+    
+    neural_tensor_t* output = ok ? scheme_attend_concepts(context, nodes, values, n) : NULL;
+    free(nodes);
+    free(values);
+    if (!ok) return NULL;
+    return output ? scheme_make_tensor(interp, output) : scheme_fail(interp, "out of memory");
+}
+
+static scheme_value_t* prim_attention(scheme_interp_t* interp, scheme_value_t* args) {
+    cognitive_context_t* context = context_arg(interp, "attention");
+    if (context && is_pair(cdr(args))) return attend_concepts(interp, context, first(args),
+                                                              second(args));
+    const neural_tensor_t* input = tensor_arg(interp, "attention", first(args));
+    if (!context || !input) return NULL;
+    
+    neural_tensor_t* output = cognitive_context_attention(context, input);
+    if (!output) return scheme_fail(interp, "attention: input must be [n, %zu]",
+                                    context->landscape->n_nodes);
+    return scheme_make_tensor(interp, output);
+}
+
+/**
+ * (spread-activation (activation name strength) threshold), the pattern
+ * cognitive-grammar.scm passes: seed the concept, spread, and return the
+ * nodes above threshold (the bridge's spread command)
+ */
+static scheme_value_t* spread_from_pattern(scheme_interp_t* interp, cognitive_context_t* context,
+                                           scheme_value_t* args) {
+    scheme_value_t* pattern = first(args);
+    if (list_length(pattern) != 3 || list_length(args) != 2) {
+        return scheme_fail(interp, "spread-activation: expected (activation name strength) "
+                           "threshold");
+    }
+    
+    size_t node;
+    double strength;
+    double threshold;
+    if (!concept_arg(interp, "spread-activation", second(pattern), &node) ||
+        !number_arg(interp, "spread-activation", third(pattern), &strength) ||
+        !number_arg(interp, "spread-activation", second(args), &threshold)) {
+        return NULL;
+    }
+    
+    size_t* above = (size_t*)malloc(context->landscape->n_nodes * sizeof(size_t));
+    size_t n_above = above ? scheme_spread_pattern(context, node, (float)strength,
+                                                   (float)threshold, above)
+                           : SIZE_MAX;
+    scheme_value_t* result = (n_above == SIZE_MAX) ? scheme_fail(interp, "out of memory")
+                                                   : node_list(interp, above, n_above);
+    free(above);
+    return result;
+}
+
+/**
+ * (spread-activation [seed] [decay]) -> active node indices afterwards
+ */
+static scheme_value_t* prim_spread_activation(scheme_interp_t* interp, scheme_value_t* args) {
+    cognitive_context_t* context = context_arg(interp, "spread-activation");
+    if (!context) return NULL;
+    
+    scheme_value_t* head = is_pair(args) && is_pair(first(args)) ? car(first(args)) : NULL;
+    if (head && head->type == SCHEME_SYMBOL && strcmp(head->as.symbol.name, "activation") == 0) {
+        return spread_from_pattern(interp, context, args);
+    }
+    
+    const neural_tensor_t* seed = NULL;
+    double decay = BRIDGE_DEFAULT_DECAY;
+    if (is_pair(args) && first(args)->type == SCHEME_TENSOR) {
+        seed = first(args)->as.tensor;
+        args = cdr(args);
+        if (seed->total_size != context->landscape->n_nodes) {
+            return scheme_fail(interp, "spread-activation: seed must have %zu values",
+                               context->landscape->n_nodes);
+        }
+    }
+    if (is_pair(args)) {
+        if (!number_arg(interp, "spread-activation", first(args), &decay)) return NULL;
+        args = cdr(args);
+    }
+    if (is_pair(args)) return scheme_fail(interp, "spread-activation: expected [seed] [decay]");
+    
+    if (seed) activation_landscape_update(context->landscape, seed->data);
+    scheme_spread_activation(context, (float)decay);
+    return active_list(interp, context);
+}
+
+static scheme_value_t* prim_active_concepts(scheme_interp_t* interp, scheme_value_t* args) {
+    (void)args;
+    cognitive_context_t* context = context_arg(interp, "active-concepts");
+    return context ? active_list(interp, context) : NULL;
+}
+
+static scheme_value_t* prim_remember(scheme_interp_t* interp, scheme_value_t* args) {
+    (void)args;
+    cognitive_context_t* context = context_arg(interp, "remember");
+    if (!context) return NULL;
+    size_t slot = cognitive_context_remember(context);
+    if (slot == SIZE_MAX) return scheme_fail(interp, "remember: the context has no working memory");
+    return scheme_make_number(interp, (double)slot);
+}
+
+static scheme_value_t* prim_cognitive_state(scheme_interp_t* interp, scheme_value_t* args) {
+    (void)args;
+    cognitive_context_t* context = context_arg(interp, "cognitive-state");
+    if (!context) return NULL;
+    neural_tensor_t* state = cognitive_context_get_state(context);
+    return state ? scheme_make_tensor(interp, state) : scheme_fail(interp, "out of memory");
+}
+
+static const scheme_primitive_t builtin_primitives[] = {
+    // Numbers
+    {"+", prim_add, 0, SCHEME_VARIADIC},
+    {"-", prim_sub, 1, SCHEME_VARIADIC},
+    {"*", prim_mul, 0, SCHEME_VARIADIC},
+    {"/", prim_div, 1, SCHEME_VARIADIC},
+    {"=", prim_num_eq, 1, SCHEME_VARIADIC},
+    {"<", prim_lt, 1, SCHEME_VARIADIC},
+    {">", prim_gt, 1, SCHEME_VARIADIC},
+    {"<=", prim_le, 1, SCHEME_VARIADIC},
+    {">=", prim_ge, 1, SCHEME_VARIADIC},
+    {"min", prim_min, 1, SCHEME_VARIADIC},
+    {"max", prim_max, 1, SCHEME_VARIADIC},
+    {"abs", prim_abs, 1, 1},
+    {"floor", prim_floor, 1, 1},
+    {"ceiling", prim_ceiling, 1, 1},
+    {"round", prim_round, 1, 1},
+    {"truncate", prim_truncate, 1, 1},
+    {"sqrt", prim_sqrt, 1, 1},
+    {"exp", prim_exp, 1, 1},
+    {"log", prim_log, 1, 1},
+    {"expt", prim_expt, 2, 2},
+    {"quotient", prim_quotient, 2, 2},
+    {"remainder", prim_remainder, 2, 2},
+    {"modulo", prim_modulo, 2, 2},
+    {"number?", prim_is_number, 1, 1},
+    {"integer?", prim_is_integer, 1, 1},
+    {"zero?", prim_is_zero, 1, 1},
+    {"positive?", prim_is_positive, 1, 1},
+    {"negative?", prim_is_negative, 1, 1},
+    {"even?", prim_is_even, 1, 1},
+    {"odd?", prim_is_odd, 1, 1},
+    {"inexact", prim_inexact, 1, 1},
+    {"exact->inexact", prim_inexact, 1, 1},
+    {"number->string", prim_number_to_string, 1, 1},
+    {"string->number", prim_string_to_number, 1, 1},
+    
+    // Equivalence and booleans
+    {"eq?", prim_eq, 2, 2},
+    {"eqv?", prim_eq, 2, 2},
+    {"equal?", prim_equal, 2, 2},
+    {"not", prim_not, 1, 1},
+    {"boolean?", prim_is_boolean, 1, 1},
+    
+    // Pairs and lists
+    {"cons", prim_cons, 2, 2},
+    {"car", prim_car, 1, 1},
+    {"cdr", prim_cdr, 1, 1},
+    {"caar", prim_caar, 1, 1},
+    {"cadr", prim_cadr, 1, 1},
+    {"cdar", prim_cdar, 1, 1},
+    {"cddr", prim_cddr, 1, 1},
+    {"caddr", prim_caddr, 1, 1},
+    {"cdddr", prim_cdddr, 1, 1},
+    {"cadddr", prim_cadddr, 1, 1},
+    {"set-car!", prim_set_car, 2, 2},
+    {"set-cdr!", prim_set_cdr, 2, 2},
+    {"list", prim_list, 0, SCHEME_VARIADIC},
+    {"length", prim_length, 1, 1},
+    {"append", prim_append, 0, SCHEME_VARIADIC},
+    {"reverse", prim_reverse, 1, 1},
+    {"list-tail", prim_list_tail, 2, 2},
+    {"list-ref", prim_list_ref, 2, 2},
+    {"memq", prim_memq, 2, 2},
+    {"memv", prim_memq, 2, 2},
+    {"member", prim_member, 2, 2},
+    {"assq", prim_assq, 2, 2},
+    {"assv", prim_assq, 2, 2},
+    {"assoc", prim_assoc, 2, 2},
+    {"null?", prim_is_null, 1, 1},
+    {"pair?", prim_is_pair, 1, 1},
+    {"list?", prim_is_list, 1, 1},
+    
+    // Symbols and strings
+    {"symbol?", prim_is_symbol, 1, 1},
+    {"string?", prim_is_string, 1, 1},
+    {"symbol->string", prim_symbol_to_string, 1, 1},
+    {"string->symbol", prim_string_to_symbol, 1, 1},
+    {"string-length", prim_string_length, 1, 1},
+    {"string-append", prim_string_append, 0, SCHEME_VARIADIC},
+    {"substring", prim_substring, 2, 3},
+    {"string=?", prim_string_eq, 2, 2},
+    
+    // Control
+    {"procedure?", prim_is_procedure, 1, 1},
+    {"apply", prim_apply, 2, SCHEME_VARIADIC},
+    {"map", prim_map, 2, SCHEME_VARIADIC},
+    {"for-each", prim_for_each, 2, SCHEME_VARIADIC},
+    {"filter", prim_filter, 2, 2},
+    {"error", prim_error, 1, SCHEME_VARIADIC},
+    {"load", prim_load, 1, 1},
+    
+    // Output
+    {"display", prim_display, 1, 1},
+    {"write", prim_write, 1, 1},
+    {"newline", prim_newline, 0, 0},
+    
+    // Tensors
+    {"make-tensor", prim_make_tensor, 1, 2},
+    {"datum->tensor", prim_datum_to_tensor, 1, 1},
+    {"tensor->datum", prim_tensor_to_datum, 1, 1},
+    {"tensor?", prim_is_tensor, 1, 1},
+    {"tensor-shape", prim_tensor_shape, 1, 1},
+    {"tensor-size", prim_tensor_size, 1, 1},
+    {"tensor->list", prim_tensor_to_list, 1, 1},
+    {"tensor-ref", prim_tensor_ref, 2, SCHEME_VARIADIC},
+    
+    // Neural operations (the bridge command vocabulary, without serialization)
+    {"neural-compute", prim_neural_compute, 1, SCHEME_VARIADIC},
+    {"encode", prim_encode, 1, 1},
+    {"decode", prim_decode, 1, 1},
+    {"embed", prim_embed, 1, 1},
+    {"embed-batch", prim_embed_batch, 1, 1},
+    {"similarity", prim_similarity, 2, 2},
+    {"attention", prim_attention, 1, 2},
+    {"spread-activation", prim_spread_activation, 0, 2},
+    {"active-concepts", prim_active_concepts, 0, 0},
+    {"register-concepts", prim_register_concepts, 1, SCHEME_VARIADIC},
+    {"concept-node", prim_concept_node, 1, 1},
+    {"concept-name", prim_concept_name, 1, 1},
+    {"remember", prim_remember, 0, 0},
+    {"cognitive-state", prim_cognitive_state, 0, 0}
+};
+
+// ============================================================================
+// INTERPRETER
+// ============================================================================
+
+scheme_interp_t* scheme_interp_create(cognitive_context_t* context) {
+    scheme_interp_t* interp = (scheme_interp_t*)calloc(1, sizeof(scheme_interp_t));
+    if (!interp) return NULL;
+    
+    interp->context = context;
+    interp->output = stdout;
+    interp->tensor_threshold = TENSOR_GC_THRESHOLD;
+    interp->roots = (scheme_value_t***)malloc(ROOT_STACK_INITIAL * sizeof(scheme_value_t**));
+    interp->root_capacity = ROOT_STACK_INITIAL;
+    interp->mark_stack = (scheme_value_t**)malloc(MARK_STACK_INITIAL * sizeof(scheme_value_t*));
+    interp->mark_capacity = MARK_STACK_INITIAL;
+    interp->symbols = (scheme_value_t**)calloc(SYMBOL_TABLE_INITIAL, sizeof(scheme_value_t*));
+    interp->symbol_capacity = SYMBOL_TABLE_INITIAL;
+    if (!interp->roots || !interp->mark_stack || !interp->symbols || !heap_grow(interp)) {
+        scheme_interp_free(interp);
+        return NULL;
+    }
+    
+    for (size_t i = 0; i < sizeof(special_forms) / sizeof(special_forms[0]); i++) {
+        scheme_value_t* symbol = scheme_intern(interp, special_forms[i].name);
+        if (!symbol) {
+            scheme_interp_free(interp);
+            return NULL;
+        }
+        symbol->form = (uint8_t)special_forms[i].form;
+    }
+    interp->symbol_quote = scheme_intern(interp, "quote");
+    
+    for (size_t i = 0; i < sizeof(builtin_primitives) / sizeof(builtin_primitives[0]); i++) {
+        if (!scheme_define_primitive(interp, &builtin_primitives[i])) {
+            scheme_interp_free(interp);
+            return NULL;
+        }
+    }
+    
+    return interp;
+}
+
+void scheme_interp_free(scheme_interp_t* interp) {
+    if (!interp) return;
+    
+    heap_block_t* block = interp->blocks;
+    while (block) {
+        heap_block_t* next = block->next;
+        for (size_t i = 0; i < HEAP_BLOCK_CELLS; i++) {
+            if (block->cells[i].type != SCHEME_FREE) finalize_cell(&block->cells[i]);
+        }
+        free(block);
+        block = next;
+    }
+    
+    symbol_encoder_free(interp->encoder);
+    concept_table_free(interp->concepts);
+    free(interp->concept_symbols);
+    free(interp->symbols);
+    free(interp->roots);
+    free(interp->mark_stack);
+    free(interp);
+}
+
+void scheme_interp_set_output(scheme_interp_t* interp, FILE* output) {
+    if (interp) interp->output = output ? output : stdout;
+}
+
+bool scheme_define_primitive(scheme_interp_t* interp, const scheme_primitive_t* primitive) {
+    if (!interp || !primitive || !primitive->name || !primitive->fn) return false;
+    
+    // The symbol is permanent, so intern it before allocating the procedure
+    scheme_value_t* symbol = scheme_intern(interp, primitive->name);
+    if (!symbol) return false;
+    scheme_value_t* cell = alloc_cell(interp, SCHEME_PRIMITIVE);
+    if (!cell) return false;
+    
+    cell->as.primitive = primitive;
+    symbol->as.symbol.global = cell;
+    return true;
+}
+
+bool scheme_define(scheme_interp_t* interp, const char* name, scheme_value_t* value) {
+    if (!interp || !name || !value || !reserve_roots(interp, 1)) return false;
+    
+    ROOT(interp, value);
+    scheme_value_t* symbol = scheme_intern(interp, name);
+    interp->n_roots--;
+    
+    if (!symbol) return false;
+    symbol->as.symbol.global = value;
+    return true;
+}
+
+scheme_value_t* scheme_lookup(scheme_interp_t* interp, const char* name) {
+    if (!interp || !name) return NULL;
+    scheme_value_t* symbol = interp->symbols[symbol_slot(interp, name, strlen(name))];
+    return symbol ? symbol->as.symbol.global : NULL;
+}
+
+/**
+ * Read and evaluate each top-level form in turn
+ */
+static scheme_value_t* eval_text(scheme_interp_t* interp, const char* text, size_t length) {
+    if (!reserve_roots(interp, 2)) return scheme_fail(interp, "out of memory");
+    
+    scheme_reader_t reader = {text, length, 0, 0};
+    scheme_value_t* last = &unspecified_cell;
+    scheme_value_t* datum = &nil_cell;
+    ROOT(interp, last);
+    ROOT(interp, datum);
+    
+    for (;;) {
+        if (!read_skip(interp, &reader)) {
+            last = NULL;
+            break;
+        }
+        if (reader.pos >= reader.length) break;
+        if (!(datum = read_datum(interp, &reader))) {
+            last = NULL;
+            break;
+        }
+        if (!(last = eval(interp, datum, &nil_cell))) break;
+    }
+    
+    interp->n_roots -= 2;
+    return last;
+}
+
+static scheme_value_t* eval_file(scheme_interp_t* interp, const char* path) {
+    FILE* file = fopen(path, "rb");
+    if (!file) return scheme_fail(interp, "cannot open %s", path);
+    
+    char* text = NULL;
+    long size = -1;
+    if (fseek(file, 0, SEEK_END) == 0 && (size = ftell(file)) >= 0 &&
+        fseek(file, 0, SEEK_SET) == 0) {
+        text = (char*)malloc((size_t)size + 1);
+    }
+    if (!text || fread(text, 1, (size_t)size, file) != (size_t)size) {
+        free(text);
+        fclose(file);
+        return scheme_fail(interp, "cannot read %s", path);
+    }
+    fclose(file);
+    
+    scheme_value_t* result = eval_text(interp, text, (size_t)size);
+    free(text);
+    return result;
+}
+
+/**
+ * Run a public entry point; a nested call (from a primitive) keeps the
+ * enclosing evaluation's error and result
+ */
+static scheme_value_t* eval_entry(scheme_interp_t* interp, const char* text, size_t length,
+                                  const char* path) {
+    bool top_level = (interp->depth == 0);
+    size_t saved_roots = interp->n_roots;
+    if (top_level) {
+        interp->failed = false;
+        interp->error[0] = '\0';
+        interp->result = NULL;
+    }
+    
+    scheme_value_t* result = path ? eval_file(interp, path) : eval_text(interp, text, length);
+    
+    interp->n_roots = saved_roots;
+    if (top_level) interp->result = result;
+    return result;
+}
+
+scheme_value_t* scheme_eval_source(scheme_interp_t* interp, const char* text, size_t length) {
+    if (!interp || !text) return NULL;
+    return eval_entry(interp, text, length, NULL);
+}
+
+scheme_value_t* scheme_eval_file(scheme_interp_t* interp, const char* path) {
+    if (!interp || !path) return NULL;
+    return eval_entry(interp, NULL, 0, path);
+}
@@ -5,97 +5,893 @@
  * Enables neural-symbolic symbiosis
  */
 
-#include "neural_physics.h"
+#include "scheme_neural_bridge.h"
+#include "activation_spread.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
 #include <string.h>
+#include <math.h>
 
 // ============================================================================
 // SYMBOLIC-NEURAL CONVERSION
 // ============================================================================
 
+// Number tokens up to this length are copied for strtof on the stack
+#define SCHEME_NUMBER_MAX 64
+
+/**
+ * Cursor over tensor text
+ */
+typedef struct {
+    const char* text;
+    size_t length;
+    size_t pos;
+    scheme_parse_error_t* error;
+} tensor_reader_t;
+
+// Exact single-precision powers of ten (10^10 = 2^10 * 5^10 still fits the mantissa)
+static const float exact_pow10f[11] = {
+    1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f
+};
+
+static bool reader_fail(tensor_reader_t* reader, const char* message) {
+    if (reader->error) {
+        reader->error->offset = reader->pos;
+        reader->error->message = message;
+    }
+    return false;
+}
+
+static bool is_space(char c) {
+    return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\f' || c == '\v';
+}
+
+static bool is_delimiter(char c) {
+    return is_space(c) || c == '(' || c == ')' || c == ';' || c == '"';
+}
+
+/**
+ * Skip whitespace and ; comments
+ */
+static void reader_skip_space(tensor_reader_t* reader) {
+    const char* text = reader->text;
+    while (reader->pos < reader->length) {
+        char c = text[reader->pos];
+        if (c == ';') {
+            while (reader->pos < reader->length && text[reader->pos] != '\n') reader->pos++;
+        } else if (is_space(c)) {
+            reader->pos++;
+        } else {
+            break;
+        }
+    }
+}
+
+static bool reader_expect(tensor_reader_t* reader, char c, const char* message) {
+    reader_skip_space(reader);
+    if (reader->pos >= reader->length || reader->text[reader->pos] != c) {
+        return reader_fail(reader, message);
+    }
+    reader->pos++;
+    return true;
+}
+
+static bool reader_keyword(tensor_reader_t* reader, const char* word, const char* message) {
+    reader_skip_space(reader);
+    size_t n = strlen(word);
+    size_t end = reader->pos + n;
+    if (reader->length - reader->pos < n || memcmp(reader->text + reader->pos, word, n) != 0 ||
+        (end < reader->length && !is_delimiter(reader->text[end]))) {
+        return reader_fail(reader, message);
+    }
+    reader->pos = end;
+    return true;
+}
+
+/**
+ * Skip to the next token; true if it is a closing parenthesis
+ */
+static bool reader_at_close(tensor_reader_t* reader) {
+    reader_skip_space(reader);
+    return reader->pos < reader->length && reader->text[reader->pos] == ')';
+}
+
+static bool reader_unsigned(tensor_reader_t* reader, uint64_t* out) {
+    const char* text = reader->text;
+    size_t i = reader->pos;
+    uint64_t value = 0;
+    
+    if (i >= reader->length) return reader_fail(reader, "unexpected end of input");
+    if (text[i] < '0' || text[i] > '9') return reader_fail(reader, "expected an integer");
+    while (i < reader->length && text[i] >= '0' && text[i] <= '9') {
+        uint64_t digit = (uint64_t)(text[i] - '0');
+        if (value > (UINT64_MAX - digit) / 10) return reader_fail(reader, "integer too large");
+        value = value * 10 + digit;
+        i++;
+    }
+    if (i < reader->length && !is_delimiter(text[i])) {
+        reader->pos = i;
+        return reader_fail(reader, "malformed integer");
+    }
+    
+    reader->pos = i;
+    *out = value;
+    return true;
+}
+
+static bool reader_size(tensor_reader_t* reader, size_t* out) {
+    size_t start = reader->pos;
+    uint64_t value;
+    if (!reader_unsigned(reader, &value)) return false;
+    if (value == 0 || (uint64_t)(size_t)value != value) {
+        reader->pos = start;
+        return reader_fail(reader, value ? "dimension too large" : "dimensions must be positive");
+    }
+    
+    *out = (size_t)value;
+    return true;
+}
+
+/**
+ * Parse one number token
+ * Short decimals (<= 2^24 mantissa, |exponent| <= 10) are computed with one
+ * correctly rounded float operation; anything else goes through strtof.
+ */
+static bool reader_float(tensor_reader_t* reader, float* out) {
+    const char* text = reader->text;
+    size_t start = reader->pos;
+    size_t end = reader->length;
+    size_t i = start;
+    
+    if (i >= end) return reader_fail(reader, "unexpected end of input");
+    
+    bool negative = false;
+    if (text[i] == '+' || text[i] == '-') {
+        negative = (text[i] == '-');
+        i++;
+    }
+    
+    // Scheme spellings of non-finite values: +inf.0, -inf.0, +nan.0
+    if (i > start && end - i >= 5 && (i + 5 == end || is_delimiter(text[i + 5]))) {
+        if (memcmp(text + i, "inf.0", 5) == 0) {
+            *out = negative ? -INFINITY : INFINITY;
+            reader->pos = i + 5;
+            return true;
+        }
+        if (memcmp(text + i, "nan.0", 5) == 0) {
+            *out = NAN;
+            reader->pos = i + 5;
+            return true;
+        }
+    }
+    
+    uint64_t mantissa = 0;
+    int exponent = 0;
+    bool any_digit = false;
+    bool exact = true;
+    
+    while (i < end && text[i] >= '0' && text[i] <= '9') {
+        if (mantissa < 100000000000000000ULL) {
+            mantissa = mantissa * 10 + (uint64_t)(text[i] - '0');
+        } else {
+            exponent++;
+            exact = false;
+        }
+        any_digit = true;
+        i++;
+    }
+    if (i < end && text[i] == '.') {
+        i++;
+        while (i < end && text[i] >= '0' && text[i] <= '9') {
+            if (mantissa < 100000000000000000ULL) {
+                mantissa = mantissa * 10 + (uint64_t)(text[i] - '0');
+                exponent--;
+            } else {
+                exact = false;
+            }
+            any_digit = true;
+            i++;
+        }
+    }
+    if (!any_digit) return reader_fail(reader, "expected a number");
+    
+    if (i < end && (text[i] == 'e' || text[i] == 'E')) {
+        i++;
+        bool exp_negative = false;
+        if (i < end && (text[i] == '+' || text[i] == '-')) {
+            exp_negative = (text[i] == '-');
+            i++;
+        }
+        if (i >= end || text[i] < '0' || text[i] > '9') {
+            reader->pos = i;
+            return reader_fail(reader, "malformed exponent");
+        }
+        int exp_value = 0;
+        while (i < end && text[i] >= '0' && text[i] <= '9') {
+            if (exp_value < 100000) exp_value = exp_value * 10 + (text[i] - '0');
+            i++;
+        }
+        exponent += exp_negative ? -exp_value : exp_value;
+    }
+    if (i < end && !is_delimiter(text[i])) {
+        reader->pos = i;
+        return reader_fail(reader, "malformed number");
+    }
+    
+    float value;
+    if (exact && mantissa <= (1u << 24) && exponent >= -10 && exponent <= 10) {
+        value = (float)mantissa;
+        value = (exponent >= 0) ? value * exact_pow10f[exponent] : value / exact_pow10f[-exponent];
+        if (negative) value = -value;
+    } else {
+        // strtof needs a terminated copy; long-mantissa tokens get a heap one
+        char buffer[SCHEME_NUMBER_MAX];
+        size_t n = i - start;
+        char* token = (n < sizeof(buffer)) ? buffer : (char*)malloc(n + 1);
+        if (!token) return reader_fail(reader, "out of memory");
+        memcpy(token, text + start, n);
+        token[n] = '\0';
+        value = strtof(token, NULL);
+        if (token != buffer) free(token);
+    }
+    
+    reader->pos = i;
+    *out = value;
+    return true;
+}
+
+neural_tensor_t* scheme_parse_tensor(const char* text, size_t length, size_t* consumed,
+                                     scheme_parse_error_t* error) {
+    tensor_reader_t reader = {text, text ? length : 0, 0, error};
+    if (!text) {
+        reader_fail(&reader, "no input");
+        return NULL;
+    }
+    
+    if (!reader_expect(&reader, '(', "expected '('") ||
+        !reader_keyword(&reader, "tensor", "expected 'tensor'") ||
+        !reader_expect(&reader, '(', "expected '(' before shape") ||
+        !reader_keyword(&reader, "shape", "expected 'shape'")) {
+        return NULL;
+    }
+    
+    size_t shape[SCHEME_TENSOR_MAX_RANK];
+    size_t n_dims = 0;
+    size_t total = 1;
+    while (!reader_at_close(&reader)) {
+        if (n_dims == SCHEME_TENSOR_MAX_RANK) {
+            reader_fail(&reader, "too many dimensions");
+            return NULL;
+        }
+        if (!reader_size(&reader, &shape[n_dims])) return NULL;
+        if (total > SIZE_MAX / sizeof(float) / shape[n_dims]) {
+            reader_fail(&reader, "tensor too large");
+            return NULL;
+        }
+        total *= shape[n_dims++];
+    }
+    if (n_dims == 0) {
+        reader_fail(&reader, "empty shape");
+        return NULL;
+    }
+    reader.pos++;
+    
+    if (!reader_expect(&reader, '(', "expected '(' before data") ||
+        !reader_keyword(&reader, "data", "expected 'data'")) {
+        return NULL;
+    }
+    
+    // Sized once from the shape, filled in place
+    neural_tensor_t* tensor = neural_tensor_create(shape, n_dims);
+    if (!tensor) {
+        reader_fail(&reader, "out of memory");
+        return NULL;
+    }
+    
+    size_t count = 0;
+    while (!reader_at_close(&reader)) {
+        if (count == total) {
+            reader_fail(&reader, "more data values than the shape holds");
+            neural_tensor_free(tensor);
+            return NULL;
+        }
+        if (!reader_float(&reader, &tensor->data[count])) {
+            neural_tensor_free(tensor);
+            return NULL;
+        }
+        count++;
+    }
+    if (count != total) {
+        reader_fail(&reader, "fewer data values than the shape holds");
+        neural_tensor_free(tensor);
+        return NULL;
+    }
+    reader.pos++;
+    
+    if (!reader_expect(&reader, ')', "expected ')' closing the tensor")) {
+        neural_tensor_free(tensor);
+        return NULL;
+    }
+    
+    if (consumed) *consumed = reader.pos;
+    return tensor;
+}
+
 /**
  * Convert Scheme list to neural tensor
  * Format: "(tensor (shape d1 d2 ...) (data v1 v2 ...))"
  */
 neural_tensor_t* scheme_list_to_tensor(const char* scheme_list) {
-    // Simplified parser - in real implementation, use proper Scheme parser
-    // This is a placeholder for demonstration
+    if (!scheme_list) return NULL;
     
-    size_t shape[2] = {2, 2};
-    neural_tensor_t* tensor = neural_tensor_create(shape, 2);
+    size_t length = strlen(scheme_list);
+    size_t consumed = 0;
+    neural_tensor_t* tensor = scheme_parse_tensor(scheme_list, length, &consumed, NULL);
+    if (!tensor) return NULL;
     
-    if (tensor) {
-        // Initialize with sample data
-        tensor->data[0] = 0.5f;
-        tensor->data[1] = 0.3f;
-        tensor->data[2] = 0.7f;
-        tensor->data[3] = 0.9f;
+    // Only whitespace and comments may follow
+    tensor_reader_t rest = {scheme_list, length, consumed, NULL};
+    reader_skip_space(&rest);
+    if (rest.pos != length) {
+        neural_tensor_free(tensor);
+        return NULL;
     }
     
     return tensor;
 }
 
+// Shortest round-trip float digits (Ryu): 5^-q and 5^i scaled to 59/61 bits
+#define FLOAT_POW5_INV_BITCOUNT 59
+#define FLOAT_POW5_BITCOUNT 61
+
+static const uint64_t float_pow5_inv_split[31] = {
+    576460752303423489ULL, 461168601842738791ULL, 368934881474191033ULL,
+    295147905179352826ULL, 472236648286964522ULL, 377789318629571618ULL,
+    302231454903657294ULL, 483570327845851670ULL, 386856262276681336ULL,
+    309485009821345069ULL, 495176015714152110ULL, 396140812571321688ULL,
+    316912650057057351ULL, 507060240091291761ULL, 405648192073033409ULL,
+    324518553658426727ULL, 519229685853482763ULL, 415383748682786211ULL,
+    332306998946228969ULL, 531691198313966350ULL, 425352958651173080ULL,
+    340282366920938464ULL, 544451787073501542ULL, 435561429658801234ULL,
+    348449143727040987ULL, 557518629963265579ULL, 446014903970612463ULL,
+    356811923176489971ULL, 570899077082383953ULL, 456719261665907162ULL,
+    365375409332725730ULL
+};
+
+static const uint64_t float_pow5_split[47] = {
+    1152921504606846976ULL, 1441151880758558720ULL, 1801439850948198400ULL,
+    2251799813685248000ULL, 1407374883553280000ULL, 1759218604441600000ULL,
+    2199023255552000000ULL, 1374389534720000000ULL, 1717986918400000000ULL,
+    2147483648000000000ULL, 1342177280000000000ULL, 1677721600000000000ULL,
+    2097152000000000000ULL, 1310720000000000000ULL, 1638400000000000000ULL,
+    2048000000000000000ULL, 1280000000000000000ULL, 1600000000000000000ULL,
+    2000000000000000000ULL, 1250000000000000000ULL, 1562500000000000000ULL,
+    1953125000000000000ULL, 1220703125000000000ULL, 1525878906250000000ULL,
+    1907348632812500000ULL, 1192092895507812500ULL, 1490116119384765625ULL,
+    1862645149230957031ULL, 1164153218269348144ULL, 1455191522836685180ULL,
+    1818989403545856475ULL, 2273736754432320594ULL, 1421085471520200371ULL,
+    1776356839400250464ULL, 2220446049250313080ULL, 1387778780781445675ULL,
+    1734723475976807094ULL, 2168404344971008868ULL, 1355252715606880542ULL,
+    1694065894508600678ULL, 2117582368135750847ULL, 1323488980084844279ULL,
+    1654361225106055349ULL, 2067951531382569187ULL, 1292469707114105741ULL,
+    1615587133892632177ULL, 2019483917365790221ULL
+};
+
+static int32_t pow5bits(int32_t e) {
+    return (int32_t)(((uint32_t)e * 1217359) >> 19) + 1;
+}
+
+static uint32_t log10_pow2(int32_t e) {
+    return ((uint32_t)e * 78913) >> 18;
+}
+
+static uint32_t log10_pow5(int32_t e) {
+    return ((uint32_t)e * 732923) >> 20;
+}
+
+static bool multiple_of_pow5(uint32_t value, uint32_t p) {
+    uint32_t count = 0;
+    while (value % 5 == 0 && count < p) {
+        value /= 5;
+        count++;
+    }
+    return count >= p;
+}
+
+static bool multiple_of_pow2(uint32_t value, uint32_t p) {
+    return (value & ((1u << p) - 1)) == 0;
+}
+
+static uint32_t mul_shift32(uint32_t m, uint64_t factor, int32_t shift) {
+    uint64_t bits0 = (uint64_t)m * (uint32_t)factor;
+    uint64_t bits1 = (uint64_t)m * (uint32_t)(factor >> 32);
+    uint64_t sum = (bits0 >> 32) + bits1;
+    return (uint32_t)(sum >> (shift - 32));
+}
+
 /**
- * Convert neural tensor to Scheme list representation
+ * Shortest decimal digits * 10^exponent that reads back as the finite,
+ * non-zero float with the given IEEE fields (nearest on ties)
  */
-char* tensor_to_scheme_list(const neural_tensor_t* tensor) {
-    if (!tensor) return NULL;
+static uint32_t float_shortest_digits(uint32_t ieee_mantissa, uint32_t ieee_exponent,
+                                      int32_t* exponent) {
+    int32_t e2;
+    uint32_t m2;
+    if (ieee_exponent == 0) {
+        e2 = 1 - 127 - 23 - 2;
+        m2 = ieee_mantissa;
+    } else {
+        e2 = (int32_t)ieee_exponent - 127 - 23 - 2;
+        m2 = (1u << 23) | ieee_mantissa;
+    }
+    bool accept_bounds = (m2 & 1) == 0;
     
-    // Allocate buffer for Scheme representation
-    size_t buffer_size = 2048 + tensor->total_size * 20;
-    char* result = (char*)malloc(buffer_size);
-    if (!result) return NULL;
+    // Scaled value and the halfway points to its neighbours
+    uint32_t mv = 4 * m2;
+    uint32_t mp = 4 * m2 + 2;
+    uint32_t mm_shift = (ieee_mantissa != 0 || ieee_exponent <= 1);
+    uint32_t mm = 4 * m2 - 1 - mm_shift;
     
-    // Build shape part with bounds checking
-    char shape_str[512];
-    int offset = snprintf(shape_str, sizeof(shape_str), "(shape");
-    if (offset < 0 || (size_t)offset >= sizeof(shape_str)) {
-        free(result);
-        return NULL;
+    uint32_t vr, vp, vm;
+    int32_t e10;
+    bool vm_trailing_zeros = false;
+    bool vr_trailing_zeros = false;
+    uint32_t last_removed = 0;
+    
+    if (e2 >= 0) {
+        uint32_t q = log10_pow2(e2);
+        int32_t k = FLOAT_POW5_INV_BITCOUNT + pow5bits((int32_t)q) - 1;
+        int32_t i = -e2 + (int32_t)q + k;
+        e10 = (int32_t)q;
+        vr = mul_shift32(mv, float_pow5_inv_split[q], i);
+        vp = mul_shift32(mp, float_pow5_inv_split[q], i);
+        vm = mul_shift32(mm, float_pow5_inv_split[q], i);
+        if (q != 0 && (vp - 1) / 10 <= vm / 10) {
+            int32_t l = FLOAT_POW5_INV_BITCOUNT + pow5bits((int32_t)(q - 1)) - 1;
+            last_removed = mul_shift32(mv, float_pow5_inv_split[q - 1],
+                                       -e2 + (int32_t)q - 1 + l) % 10;
+        }
+        if (q <= 9) {
+            // At most one of mp, mv, mm is a multiple of 5
+            if (mv % 5 == 0) {
+                vr_trailing_zeros = multiple_of_pow5(mv, q);
+            } else if (accept_bounds) {
+                vm_trailing_zeros = multiple_of_pow5(mm, q);
+            } else {
+                vp -= multiple_of_pow5(mp, q);
+            }
+        }
+    } else {
+        uint32_t q = log10_pow5(-e2);
+        int32_t i = -e2 - (int32_t)q;
+        int32_t k = pow5bits(i) - FLOAT_POW5_BITCOUNT;
+        int32_t j = (int32_t)q - k;
+        e10 = (int32_t)q + e2;
+        vr = mul_shift32(mv, float_pow5_split[i], j);
+        vp = mul_shift32(mp, float_pow5_split[i], j);
+        vm = mul_shift32(mm, float_pow5_split[i], j);
+        if (q != 0 && (vp - 1) / 10 <= vm / 10) {
+            j = (int32_t)q - 1 - (pow5bits(i + 1) - FLOAT_POW5_BITCOUNT);
+            last_removed = mul_shift32(mv, float_pow5_split[i + 1], j) % 10;
+        }
+        if (q <= 1) {
+            vr_trailing_zeros = true;
+            if (accept_bounds) {
+                vm_trailing_zeros = (mm_shift == 1);
+            } else {
+                vp--;
+            }
+        } else if (q < 31) {
+            vr_trailing_zeros = multiple_of_pow2(mv, q - 1);
+        }
     }
     
-    for (size_t i = 0; i < tensor->n_dims && offset < (int)sizeof(shape_str) - 20; i++) {
-        int written = snprintf(shape_str + offset, sizeof(shape_str) - offset, " %zu", tensor->shape[i]);
-        if (written < 0) break;
-        offset += written;
+    // Drop digits while the interval still holds a shorter number
+    int32_t removed = 0;
+    uint32_t output;
+    if (vm_trailing_zeros || vr_trailing_zeros) {
+        while (vp / 10 > vm / 10) {
+            vm_trailing_zeros &= (vm % 10 == 0);
+            vr_trailing_zeros &= (last_removed == 0);
+            last_removed = vr % 10;
+            vr /= 10;
+            vp /= 10;
+            vm /= 10;
+            removed++;
+        }
+        if (vm_trailing_zeros) {
+            while (vm % 10 == 0) {
+                vr_trailing_zeros &= (last_removed == 0);
+                last_removed = vr % 10;
+                vr /= 10;
+                vp /= 10;
+                vm /= 10;
+                removed++;
+            }
+        }
+        if (vr_trailing_zeros && last_removed == 5 && vr % 2 == 0) {
+            last_removed = 4;   // Exactly halfway: round to even
+        }
+        output = vr + ((vr == vm && (!accept_bounds || !vm_trailing_zeros)) || last_removed >= 5);
+    } else {
+        while (vp / 10 > vm / 10) {
+            last_removed = vr % 10;
+            vr /= 10;
+            vp /= 10;
+            vm /= 10;
+            removed++;
+        }
+        output = vr + (vr == vm || last_removed >= 5);
     }
     
-    if (offset < (int)sizeof(shape_str) - 2) {
-        snprintf(shape_str + offset, sizeof(shape_str) - offset, ")");
+    *exponent = e10 + removed;
+    return output;
+}
+
+size_t scheme_format_float(float value, char* out) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    bool negative = (bits >> 31) != 0;
+    uint32_t ieee_mantissa = bits & ((1u << 23) - 1);
+    uint32_t ieee_exponent = (bits >> 23) & 0xff;
+    size_t n = 0;
+    
+    if (ieee_exponent == 0xff) {
+        const char* text = ieee_mantissa ? "+nan.0" : (negative ? "-inf.0" : "+inf.0");
+        memcpy(out, text, 6);
+        return 6;
+    }
+    if (negative) out[n++] = '-';
+    if (ieee_exponent == 0 && ieee_mantissa == 0) {
+        memcpy(out + n, "0.0", 3);
+        return n + 3;
     }
     
-    // Build data part with bounds checking
-    size_t data_buffer_size = 2048;
-    char* data_str = (char*)malloc(data_buffer_size);
-    if (!data_str) {
-        free(result);
-        return NULL;
+    int32_t exponent;
+    uint32_t digits = float_shortest_digits(ieee_mantissa, ieee_exponent, &exponent);
+    
+    char buffer[10];
+    int32_t length = 0;
+    while (digits > 0) {
+        buffer[9 - length++] = (char)('0' + digits % 10);
+        digits /= 10;
     }
+    const char* d = buffer + 10 - length;
+    int32_t scientific = exponent + length - 1;
     
-    offset = snprintf(data_str, data_buffer_size, "(data");
-    if (offset < 0 || (size_t)offset >= data_buffer_size) {
-        free(data_str);
-        free(result);
+    if (scientific >= -5 && scientific < 0) {
+        // 0.000ddd
+        out[n++] = '0';
+        out[n++] = '.';
+        for (int32_t i = -1; i > scientific; i--) out[n++] = '0';
+        memcpy(out + n, d, (size_t)length);
+        n += (size_t)length;
+    } else if (scientific >= 0 && scientific < 9) {
+        // ddd.ddd or ddd00.0
+        int32_t integer_digits = scientific + 1;
+        for (int32_t i = 0; i < integer_digits; i++) out[n++] = (i < length) ? d[i] : '0';
+        out[n++] = '.';
+        if (integer_digits < length) {
+            memcpy(out + n, d + integer_digits, (size_t)(length - integer_digits));
+            n += (size_t)(length - integer_digits);
+        } else {
+            out[n++] = '0';
+        }
+    } else {
+        // d.ddde-x
+        out[n++] = d[0];
+        if (length > 1) {
+            out[n++] = '.';
+            memcpy(out + n, d + 1, (size_t)(length - 1));
+            n += (size_t)(length - 1);
+        }
+        out[n++] = 'e';
+        if (scientific < 0) {
+            out[n++] = '-';
+            scientific = -scientific;
+        }
+        if (scientific >= 10) out[n++] = (char)('0' + scientific / 10);
+        out[n++] = (char)('0' + scientific % 10);
+    }
+    
+    return n;
+}
+
+// Bytes buffered by the streaming writer before each flush
+#define SCHEME_WRITE_CHUNK 4096
+
+/**
+ * Staging buffer in front of a write callback
+ */
+typedef struct {
+    char bytes[SCHEME_WRITE_CHUNK];
+    size_t length;
+    scheme_write_fn write;
+    void* ctx;
+    bool failed;
+} tensor_writer_t;
+
+static void writer_flush(tensor_writer_t* writer) {
+    if (writer->length > 0 && !writer->failed) {
+        writer->failed = !writer->write(writer->ctx, writer->bytes, writer->length);
+    }
+    writer->length = 0;
+}
+
+static void writer_append(tensor_writer_t* writer, const char* bytes, size_t length) {
+    if (writer->length + length > sizeof(writer->bytes)) writer_flush(writer);
+    memcpy(writer->bytes + writer->length, bytes, length);
+    writer->length += length;
+}
+
+static void writer_size(tensor_writer_t* writer, size_t value) {
+    char buffer[24];
+    size_t n = sizeof(buffer);
+    do {
+        buffer[--n] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value > 0);
+    buffer[--n] = ' ';
+    writer_append(writer, buffer + n, sizeof(buffer) - n);
+}
+
+bool scheme_write_tensor(const neural_tensor_t* tensor, scheme_write_fn write, void* ctx) {
+    if (!tensor || !write) return false;
+    
+    tensor_writer_t writer;
+    writer.length = 0;
+    writer.write = write;
+    writer.ctx = ctx;
+    writer.failed = false;
+    
+    writer_append(&writer, "(tensor (shape", 14);
+    for (size_t i = 0; i < tensor->n_dims; i++) {
+        writer_size(&writer, tensor->shape[i]);
+    }
+    writer_append(&writer, ") (data", 7);
+    
+    // Values are formatted straight into the staging buffer
+    const float* data = tensor->data;
+    for (size_t i = 0; i < tensor->total_size && !writer.failed; i++) {
+        if (writer.length + 1 + SCHEME_FLOAT_MAX_CHARS > sizeof(writer.bytes)) {
+            writer_flush(&writer);
+        }
+        writer.bytes[writer.length++] = ' ';
+        writer.length += scheme_format_float(data[i], writer.bytes + writer.length);
+    }
+    
+    writer_append(&writer, "))", 2);
+    writer_flush(&writer);
+    return !writer.failed;
+}
+
+static bool write_to_file(void* ctx, const char* bytes, size_t length) {
+    return fwrite(bytes, 1, length, (FILE*)ctx) == length;
+}
+
+bool scheme_write_tensor_file(const neural_tensor_t* tensor, FILE* stream) {
+    if (!stream) return false;
+    return scheme_write_tensor(tensor, write_to_file, stream);
+}
+
+/**
+ * Bounded output buffer that keeps counting past its capacity
+ */
+typedef struct {
+    char* buffer;
+    size_t capacity;
+    size_t length;
+} bounded_output_t;
+
+static bool write_to_bounded(void* ctx, const char* bytes, size_t length) {
+    bounded_output_t* output = (bounded_output_t*)ctx;
+    if (output->length < output->capacity) {
+        size_t room = output->capacity - output->length;
+        memcpy(output->buffer + output->length, bytes, length < room ? length : room);
+    }
+    output->length += length;
+    return true;
+}
+
+size_t scheme_format_tensor(const neural_tensor_t* tensor, char* buffer, size_t capacity) {
+    if (!tensor || (!buffer && capacity > 0)) return SIZE_MAX;
+    
+    // Reserve the terminator
+    bounded_output_t output = {buffer, capacity ? capacity - 1 : 0, 0};
+    scheme_write_tensor(tensor, write_to_bounded, &output);
+    if (capacity > 0) {
+        buffer[output.length < output.capacity ? output.length : output.capacity] = '\0';
+    }
+    return output.length;
+}
+
+/**
+ * Growable output buffer
+ */
+typedef struct {
+    char* buffer;
+    size_t capacity;
+    size_t length;
+} growable_output_t;
+
+static bool write_to_growable(void* ctx, const char* bytes, size_t length) {
+    growable_output_t* output = (growable_output_t*)ctx;
+    if (output->length + length + 1 > output->capacity) {
+        size_t capacity = output->capacity * 2;
+        if (capacity < output->length + length + 1) capacity = output->length + length + 1;
+        char* grown = (char*)realloc(output->buffer, capacity);
+        if (!grown) return false;
+        output->buffer = grown;
+        output->capacity = capacity;
+    }
+    memcpy(output->buffer + output->length, bytes, length);
+    output->length += length;
+    return true;
+}
+
+/**
+ * Convert neural tensor to Scheme list representation
+ * Every value is written, each in its shortest round-trip form.
+ */
+char* tensor_to_scheme_list(const neural_tensor_t* tensor) {
+    if (!tensor) return NULL;
+    
+    // Typical values take well under 12 bytes; the buffer grows otherwise
+    growable_output_t output = {NULL, 0, 0};
+    output.capacity = 64 + tensor->total_size * 12;
+    output.buffer = (char*)malloc(output.capacity);
+    if (!output.buffer) return NULL;
+    
+    if (!scheme_write_tensor(tensor, write_to_growable, &output)) {
+        free(output.buffer);
         return NULL;
     }
+    output.buffer[output.length] = '\0';
+    return output.buffer;
+}
+
+// ============================================================================
+// BINARY TENSOR FRAMES
+// ============================================================================
+
+static bool host_is_little_endian(void) {
+    const uint16_t probe = 1;
+    uint8_t first;
+    memcpy(&first, &probe, 1);
+    return first == 1;
+}
+
+static void store_le16(uint8_t* out, uint16_t value) {
+    out[0] = (uint8_t)value;
+    out[1] = (uint8_t)(value >> 8);
+}
+
+static void store_le64(uint8_t* out, uint64_t value) {
+    for (int i = 0; i < 8; i++) out[i] = (uint8_t)(value >> (8 * i));
+}
+
+static uint16_t load_le16(const uint8_t* in) {
+    return (uint16_t)(in[0] | (in[1] << 8));
+}
+
+static uint64_t load_le64(const uint8_t* in) {
+    uint64_t value = 0;
+    for (int i = 7; i >= 0; i--) value = (value << 8) | in[i];
+    return value;
+}
+
+/**
+ * Copy n floats between host order and little-endian bytes
+ */
+static void copy_floats_le(void* dst, const void* src, size_t n) {
+    if (host_is_little_endian()) {
+        memcpy(dst, src, n * sizeof(float));
+        return;
+    }
+    const uint8_t* in = (const uint8_t*)src;
+    uint8_t* out = (uint8_t*)dst;
+    for (size_t i = 0; i < n; i++, in += 4, out += 4) {
+        out[0] = in[3];
+        out[1] = in[2];
+        out[2] = in[1];
+        out[3] = in[0];
+    }
+}
+
+size_t scheme_frame_header_size(size_t n_dims) {
+    return SCHEME_FRAME_PREFIX_SIZE + n_dims * sizeof(uint64_t);
+}
+
+size_t scheme_frame_size(const neural_tensor_t* tensor) {
+    if (!tensor || tensor->n_dims == 0 || tensor->n_dims > SCHEME_TENSOR_MAX_RANK) return 0;
+    return scheme_frame_header_size(tensor->n_dims) + tensor->total_size * sizeof(float);
+}
+
+size_t scheme_encode_header(const neural_tensor_t* tensor, uint8_t* header) {
+    if (!tensor || !header || tensor->n_dims == 0 || tensor->n_dims > SCHEME_TENSOR_MAX_RANK) {
+        return 0;
+    }
     
-    size_t n_print = (tensor->total_size < 100) ? tensor->total_size : 100;
-    for (size_t i = 0; i < n_print && offset < (int)data_buffer_size - 30; i++) {
-        int written = snprintf(data_str + offset, data_buffer_size - offset, " %.4f", tensor->data[i]);
-        if (written < 0) break;
-        offset += written;
+    memcpy(header, SCHEME_FRAME_MAGIC, 4);
+    header[4] = SCHEME_FRAME_VERSION;
+    header[5] = SCHEME_DTYPE_FLOAT32;
+    store_le16(header + 6, (uint16_t)tensor->n_dims);
+    for (size_t i = 0; i < tensor->n_dims; i++) {
+        store_le64(header + SCHEME_FRAME_PREFIX_SIZE + i * 8, (uint64_t)tensor->shape[i]);
+    }
+    return scheme_frame_header_size(tensor->n_dims);
+}
+
+size_t scheme_encode_tensor(const neural_tensor_t* tensor, uint8_t* buffer, size_t capacity) {
+    size_t size = scheme_frame_size(tensor);
+    if (size == 0 || !buffer || capacity < size) return 0;
+    
+    size_t header_size = scheme_encode_header(tensor, buffer);
+    copy_floats_le(buffer + header_size, tensor->data, tensor->total_size);
+    return size;
+}
+
+/**
+ * Validate a frame header; fills shape and returns the data offset (0 if invalid)
+ */
+static size_t frame_parse_header(const uint8_t* frame, size_t length, size_t* shape,
+                                 size_t* n_dims, size_t* total) {
+    if (!frame || length < SCHEME_FRAME_PREFIX_SIZE) return 0;
+    if (memcmp(frame, SCHEME_FRAME_MAGIC, 4) != 0 || frame[4] != SCHEME_FRAME_VERSION ||
+        frame[5] != SCHEME_DTYPE_FLOAT32) {
+        return 0;
     }
     
-    if (offset < (int)data_buffer_size - 2) {
-        snprintf(data_str + offset, data_buffer_size - offset, ")");
+    size_t rank = load_le16(frame + 6);
+    size_t header_size = scheme_frame_header_size(rank);
+    if (rank == 0 || rank > SCHEME_TENSOR_MAX_RANK || length < header_size) return 0;
+    
+    size_t count = 1;
+    for (size_t i = 0; i < rank; i++) {
+        uint64_t dim = load_le64(frame + SCHEME_FRAME_PREFIX_SIZE + i * 8);
+        if (dim == 0 || (uint64_t)(size_t)dim != dim || count > SIZE_MAX / sizeof(float) / dim) return 0;
+        shape[i] = (size_t)dim;
+        count *= shape[i];
     }
+    if ((length - header_size) / sizeof(float) < count) return 0;
+    
+    *n_dims = rank;
+    *total = count;
+    return header_size;
+}
+
+neural_tensor_t* scheme_decode_tensor(const uint8_t* frame, size_t length, size_t* consumed) {
+    size_t shape[SCHEME_TENSOR_MAX_RANK];
+    size_t n_dims = 0;
+    size_t total = 0;
+    size_t header_size = frame_parse_header(frame, length, shape, &n_dims, &total);
+    if (header_size == 0) return NULL;
     
-    // Combine with bounds checking
-    snprintf(result, buffer_size, "(tensor %s %s)", shape_str, data_str);
+    neural_tensor_t* tensor = neural_tensor_create(shape, n_dims);
+    if (!tensor) return NULL;
     
-    free(data_str);
-    return result;
+    copy_floats_le(tensor->data, frame + header_size, total);
+    if (consumed) *consumed = header_size + total * sizeof(float);
+    return tensor;
+}
+
+neural_tensor_t* scheme_view_tensor(const uint8_t* frame, size_t length, size_t* consumed) {
+    size_t shape[SCHEME_TENSOR_MAX_RANK];
+    size_t n_dims = 0;
+    size_t total = 0;
+    size_t header_size = frame_parse_header(frame, length, shape, &n_dims, &total);
+    if (header_size == 0) return NULL;
+    
+    // The frame's bytes are used as the tensor data directly
+    const uint8_t* data = frame + header_size;
+    if (!host_is_little_endian() || (uintptr_t)data % _Alignof(float) != 0) return NULL;
+    
+    neural_tensor_t* tensor = neural_tensor_wrap((float*)(uintptr_t)data, shape, n_dims);
+    if (!tensor) return NULL;
+    
+    if (consumed) *consumed = header_size + total * sizeof(float);
+    return tensor;
 }
 
 // ============================================================================
@@ -131,23 +927,147 @@ char* scheme_neural_compute(const char* operation, const char** symbolic_inputs,
         }
     }
     
-    // Execute neural operation
-    neural_tensor_t* result = neural_execute(operation, (const neural_tensor_t**)tensors, n_inputs);
+    // Execute neural operation
+    neural_tensor_t* result = neural_execute(operation, (const neural_tensor_t**)tensors, n_inputs);
+    
+    // Cleanup input tensors
+    for (size_t i = 0; i < n_inputs; i++) {
+        neural_tensor_free(tensors[i]);
+    }
+    free(tensors);
+    
+    // Convert result to Scheme representation
+    char* scheme_result = NULL;
+    if (result) {
+        scheme_result = tensor_to_scheme_list(result);
+        neural_tensor_free(result);
+    }
+    
+    return scheme_result;
+}
+
+/**
+ * Execute neural operation on binary tensor frames
+ */
+uint8_t* scheme_neural_compute_binary(const char* operation, const uint8_t* const* frames,
+                                      const size_t* frame_sizes, size_t n_inputs,
+                                      size_t* out_size) {
+    if (!operation || !frames || !frame_sizes || !out_size) return NULL;
+    
+    neural_tensor_t** tensors = (neural_tensor_t**)calloc(n_inputs ? n_inputs : 1,
+                                                          sizeof(neural_tensor_t*));
+    if (!tensors) return NULL;
+    
+    // Aligned little-endian frames are used in place, anything else is decoded
+    bool ok = true;
+    for (size_t i = 0; i < n_inputs && ok; i++) {
+        tensors[i] = scheme_view_tensor(frames[i], frame_sizes[i], NULL);
+        if (!tensors[i]) tensors[i] = scheme_decode_tensor(frames[i], frame_sizes[i], NULL);
+        ok = (tensors[i] != NULL);
+    }
+    
+    neural_tensor_t* result = NULL;
+    if (ok) {
+        result = neural_execute(operation, (const neural_tensor_t**)tensors, n_inputs);
+    }
+    
+    for (size_t i = 0; i < n_inputs; i++) {
+        neural_tensor_free(tensors[i]);
+    }
+    free(tensors);
+    
+    uint8_t* frame = NULL;
+    if (result) {
+        size_t size = scheme_frame_size(result);
+        frame = size ? (uint8_t*)malloc(size) : NULL;
+        if (frame) {
+            scheme_encode_tensor(result, frame, size);
+            *out_size = size;
+        }
+        neural_tensor_free(result);
+    }
+    
+    return frame;
+}
+
+/**
+ * Load a text tensor into the handle table
+ */
+tensor_handle_t scheme_tensor_load(tensor_handle_table_t* table, const char* scheme_list) {
+    neural_tensor_t* tensor = scheme_list_to_tensor(scheme_list);
+    if (!tensor) return TENSOR_HANDLE_NULL;
+    
+    tensor_handle_t handle = tensor_handle_insert(table, tensor);
+    if (handle == TENSOR_HANDLE_NULL) neural_tensor_free(tensor);
+    return handle;
+}
+
+/**
+ * Load a binary frame into the handle table
+ */
+tensor_handle_t scheme_tensor_load_frame(tensor_handle_table_t* table,
+                                         const uint8_t* frame, size_t length) {
+    neural_tensor_t* tensor = scheme_decode_tensor(frame, length, NULL);
+    if (!tensor) return TENSOR_HANDLE_NULL;
+    
+    tensor_handle_t handle = tensor_handle_insert(table, tensor);
+    if (handle == TENSOR_HANDLE_NULL) neural_tensor_free(tensor);
+    return handle;
+}
+
+/**
+ * Text form of a resident tensor
+ */
+char* scheme_tensor_show(const tensor_handle_table_t* table, tensor_handle_t handle) {
+    return tensor_to_scheme_list(tensor_handle_get(table, handle));
+}
+
+/**
+ * Binary frame of a resident tensor
+ */
+uint8_t* scheme_tensor_frame(const tensor_handle_table_t* table, tensor_handle_t handle,
+                             size_t* size) {
+    const neural_tensor_t* tensor = tensor_handle_get(table, handle);
+    size_t frame_size = scheme_frame_size(tensor);
+    if (frame_size == 0 || !size) return NULL;
+    
+    uint8_t* frame = (uint8_t*)malloc(frame_size);
+    if (!frame) return NULL;
+    
+    scheme_encode_tensor(tensor, frame, frame_size);
+    *size = frame_size;
+    return frame;
+}
+
+/**
+ * Execute neural operation on resident tensors
+ * Inputs are read in place; the result stays resident under a new handle.
+ */
+tensor_handle_t scheme_neural_compute_handles(tensor_handle_table_t* table,
+                                              const char* operation,
+                                              const tensor_handle_t* inputs,
+                                              size_t n_inputs) {
+    if (!table || !operation || (!inputs && n_inputs > 0)) return TENSOR_HANDLE_NULL;
+    
+    const neural_tensor_t** tensors = (const neural_tensor_t**)malloc(
+        (n_inputs ? n_inputs : 1) * sizeof(neural_tensor_t*));
+    if (!tensors) return TENSOR_HANDLE_NULL;
     
-    // Cleanup input tensors
     for (size_t i = 0; i < n_inputs; i++) {
-        neural_tensor_free(tensors[i]);
+        tensors[i] = tensor_handle_get(table, inputs[i]);
+        if (!tensors[i]) {
+            free(tensors);
+            return TENSOR_HANDLE_NULL;
+        }
     }
-    free(tensors);
     
-    // Convert result to Scheme representation
-    char* scheme_result = NULL;
-    if (result) {
-        scheme_result = tensor_to_scheme_list(result);
-        neural_tensor_free(result);
-    }
+    neural_tensor_t* result = neural_execute(operation, tensors, n_inputs);
+    free(tensors);
+    if (!result) return TENSOR_HANDLE_NULL;
     
-    return scheme_result;
+    tensor_handle_t handle = tensor_handle_insert(table, result);
+    if (handle == TENSOR_HANDLE_NULL) neural_tensor_free(result);
+    return handle;
 }
 
 /**
@@ -156,22 +1076,57 @@ char* scheme_neural_compute(const char* operation, const char** symbolic_inputs,
 void scheme_spread_activation(cognitive_context_t* context, float decay_factor) {
     if (!context) return;
     
-    // Create simple connectivity matrix
-    size_t n = context->landscape->n_nodes;
-    size_t shape[2] = {n, n};
-    neural_tensor_t* connectivity = neural_tensor_create(shape, 2);
+    // Self-connection 0.9, uniform 0.1 to every other node, applied implicitly
+    connectivity_op_t* connectivity = connectivity_identity_uniform(
+        context->landscape->n_nodes, 0.9f, 0.1f);
     
     if (connectivity) {
-        // Initialize with random small weights
-        for (size_t i = 0; i < n; i++) {
-            for (size_t j = 0; j < n; j++) {
-                connectivity->data[i * n + j] = (i != j) ? 0.1f : 0.9f;
-            }
+        activation_landscape_spread_op(context->landscape, connectivity, decay_factor);
+        connectivity_free(connectivity);
+    }
+}
+
+size_t scheme_spread_pattern(cognitive_context_t* context, size_t node, float strength,
+                             float threshold, size_t* above) {
+    if (!context || !above || node >= context->landscape->n_nodes) return SIZE_MAX;
+    
+    activation_landscape_t* landscape = context->landscape;
+    size_t n_nodes = landscape->n_nodes;
+    float* seeded = (float*)malloc(n_nodes * sizeof(float));
+    if (!seeded) return SIZE_MAX;
+    memcpy(seeded, landscape->activations->data, n_nodes * sizeof(float));
+    seeded[node] = strength;
+    activation_landscape_update(landscape, seeded);
+    free(seeded);
+    
+    scheme_spread_activation(context, BRIDGE_DEFAULT_DECAY);
+    
+    const float* activations = landscape->activations->data;
+    size_t count = 0;
+    for (size_t i = 0; i < n_nodes; i++) {
+        if (activations[i] > threshold) above[count++] = i;
+    }
+    return count;
+}
+
+neural_tensor_t* scheme_attend_concepts(cognitive_context_t* context, const size_t* nodes,
+                                        const float* weights, size_t n) {
+    if (!context || (n > 0 && (!nodes || !weights))) return NULL;
+    
+    size_t shape[2] = {1, context->landscape->n_nodes};
+    neural_tensor_t* query = neural_tensor_create(shape, 2);
+    if (!query) return NULL;
+    for (size_t i = 0; i < n; i++) {
+        if (nodes[i] >= shape[1]) {
+            neural_tensor_free(query);
+            return NULL;
         }
-        
-        activation_landscape_spread(context->landscape, connectivity, decay_factor);
-        neural_tensor_free(connectivity);
+        query->data[nodes[i]] += weights[i];
     }
+    
+    neural_tensor_t* result = cognitive_context_attention(context, query);
+    neural_tensor_free(query);
+    return result;
 }
 
 /**
@@ -214,6 +1169,36 @@ char* scheme_get_active_concepts(cognitive_context_t* context) {
     return result;
 }
 
+char* scheme_get_active_concept_names(cognitive_context_t* context,
+                                      const concept_table_t* concepts) {
+    if (!context) return NULL;
+    
+    size_t n_active = 0;
+    const size_t* active = activation_landscape_active_set(context->landscape, &n_active);
+    
+    growable_output_t output = {NULL, 0, 0};
+    output.capacity = 32 + n_active * 16;
+    output.buffer = (char*)malloc(output.capacity);
+    if (!output.buffer) return NULL;
+    
+    bool ok = write_to_growable(&output, "(active-concepts", 16);
+    for (size_t i = 0; ok && i < n_active; i++) {
+        const char* name = concept_table_name(concepts, active[i]);
+        char index[24];
+        if (!name) {
+            snprintf(index, sizeof(index), "%zu", active[i]);
+            name = index;
+        }
+        ok = write_to_growable(&output, " ", 1) && write_to_growable(&output, name, strlen(name));
+    }
+    if (!ok || !write_to_growable(&output, ")", 1)) {
+        free(output.buffer);
+        return NULL;
+    }
+    output.buffer[output.length] = '\0';
+    return output.buffer;
+}
+
 /**
  * Apply attention mechanism from Scheme
  */
@@ -223,7 +1208,7 @@ char* scheme_apply_attention(cognitive_context_t* context, const char* input_rep
     neural_tensor_t* input = scheme_list_to_tensor(input_repr);
     if (!input) return NULL;
     
-    neural_tensor_t* output = attention_multihead(context->attention, input);
+    neural_tensor_t* output = cognitive_context_attention(context, input);
     
     neural_tensor_free(input);
     
@@ -235,14 +1220,682 @@ char* scheme_apply_attention(cognitive_context_t* context, const char* input_rep
     return result;
 }
 
+// ============================================================================
+// COMMAND DISPATCH
+// ============================================================================
+
+// Longest command or operation name
+#define BRIDGE_SYMBOL_MAX 32
+
+// Tensor operands accepted by neural-compute
+#define BRIDGE_MAX_OPERANDS 8
+
+/**
+ * State of one bridge_session_process call
+ */
+typedef struct {
+    bridge_session_t* session;
+    tensor_reader_t reader;
+    scheme_parse_error_t error;
+    growable_output_t output;
+    bool output_failed;
+    tensor_handle_t* results;   // Handle produced by each command (NULL handle if none)
+    size_t n_results;
+    size_t results_capacity;
+} command_batch_t;
+
+/**
+ * A tensor operand: borrowed from the handle table or parsed inline
+ */
+typedef struct {
+    const neural_tensor_t* tensor;
+    neural_tensor_t* owned;     // Inline literal, freed after the command
+    tensor_handle_t handle;     // Resident operand's handle (NULL handle for literals)
+} command_operand_t;
+
+static void batch_emit(command_batch_t* batch, const char* bytes, size_t length) {
+    if (!batch->output_failed) {
+        batch->output_failed = !write_to_growable(&batch->output, bytes, length);
+    }
+}
+
+static void batch_emit_text(command_batch_t* batch, const char* text) {
+    batch_emit(batch, text, strlen(text));
+}
+
+static void batch_emit_unsigned(command_batch_t* batch, uint64_t value) {
+    char buffer[24];
+    size_t n = sizeof(buffer);
+    do {
+        buffer[--n] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value > 0);
+    batch_emit(batch, buffer + n, sizeof(buffer) - n);
+}
+
+static void batch_emit_error(command_batch_t* batch) {
+    batch_emit_text(batch, "(error \"");
+    batch_emit_text(batch, batch->error.message ? batch->error.message : "error");
+    batch_emit_text(batch, "\" ");
+    batch_emit_unsigned(batch, batch->error.offset);
+    batch_emit_text(batch, ")");
+}
+
+static void batch_emit_handle(command_batch_t* batch, tensor_handle_t handle) {
+    batch_emit_text(batch, "(handle ");
+    batch_emit_unsigned(batch, handle);
+    batch_emit_text(batch, ")");
+}
+
+static bool emit_to_batch(void* ctx, const char* bytes, size_t length) {
+    command_batch_t* batch = (command_batch_t*)ctx;
+    batch_emit(batch, bytes, length);
+    return !batch->output_failed;
+}
+
+/**
+ * Read a symbol (a leading quote is ignored, as in 'add)
+ */
+static bool reader_symbol(tensor_reader_t* reader, char* out, size_t capacity) {
+    reader_skip_space(reader);
+    if (reader->pos < reader->length && reader->text[reader->pos] == '\'') reader->pos++;
+    
+    size_t start = reader->pos;
+    while (reader->pos < reader->length && !is_delimiter(reader->text[reader->pos])) {
+        reader->pos++;
+    }
+    size_t n = reader->pos - start;
+    if (n == 0 || n >= capacity) {
+        reader->pos = start;
+        return reader_fail(reader, n ? "symbol too long" : "expected a symbol");
+    }
+    
+    memcpy(out, reader->text + start, n);
+    out[n] = '\0';
+    return true;
+}
+
+/**
+ * Skip one datum (atom, string or balanced list)
+ */
+static bool reader_skip_datum(tensor_reader_t* reader) {
+    reader_skip_space(reader);
+    size_t depth = 0;
+    do {
+        if (reader->pos >= reader->length) return reader_fail(reader, "unbalanced parentheses");
+        char c = reader->text[reader->pos];
+        if (c == '(') {
+            depth++;
+            reader->pos++;
+        } else if (c == ')') {
+            if (depth == 0) return reader_fail(reader, "unexpected ')'");
+            depth--;
+            reader->pos++;
+        } else if (c == '"') {
+            reader->pos++;
+            while (reader->pos < reader->length && reader->text[reader->pos] != '"') {
+                if (reader->text[reader->pos] == '\\') reader->pos++;
+                reader->pos++;
+            }
+            if (reader->pos >= reader->length) return reader_fail(reader, "unterminated string");
+            reader->pos++;
+        } else if (c == ';' || is_space(c)) {
+            reader_skip_space(reader);
+        } else {
+            while (reader->pos < reader->length && !is_delimiter(reader->text[reader->pos])) {
+                reader->pos++;
+            }
+        }
+    } while (depth > 0);
+    return true;
+}
+
+/**
+ * Whether the next datum is a tensor operand rather than a symbolic form
+ */
+static bool batch_at_operand(command_batch_t* batch) {
+    tensor_reader_t ahead = batch->reader;
+    ahead.error = NULL;
+    char form[BRIDGE_SYMBOL_MAX];
+    if (!reader_expect(&ahead, '(', NULL) || !reader_symbol(&ahead, form, sizeof(form))) {
+        return false;
+    }
+    return strcmp(form, "tensor") == 0 || strcmp(form, "handle") == 0 ||
+           strcmp(form, "ref") == 0;
+}
+
+/**
+ * Text of a symbolic form: a symbol (a leading quote is dropped), the
+ * contents of a string, or the source text of any other datum; caller frees
+ */
+static char* batch_symbolic_text(command_batch_t* batch) {
+    tensor_reader_t* reader = &batch->reader;
+    reader_skip_space(reader);
+    if (reader->pos < reader->length && reader->text[reader->pos] == '\'') reader->pos++;
+    size_t start = reader->pos;
+    if (!reader_skip_datum(reader)) return NULL;
+    
+    const char* text = reader->text + start;
+    size_t length = reader->pos - start;
+    char* out = (char*)malloc(length + 1);
+    if (!out) {
+        reader_fail(reader, "out of memory");
+        return NULL;
+    }
+    
+    size_t n = 0;
+    if (length > 0 && text[0] == '"') {
+        for (size_t i = 1; i + 1 < length; i++) {
+            char c = text[i];
+            if (c == '\\' && i + 2 < length) {
+                c = text[++i];
+                if (c == 'n') c = '\n';
+                if (c == 't') c = '\t';
+            }
+            out[n++] = c;
+        }
+    } else {
+        memcpy(out, text, length);
+        n = length;
+    }
+    out[n] = '\0';
+    return out;
+}
+
+/**
+ * Read a tensor operand: (tensor ...), (handle N) or (ref K)
+ * (ref K) names the result of command K of the current batch.
+ */
+static bool batch_operand(command_batch_t* batch, command_operand_t* operand) {
+    tensor_reader_t* reader = &batch->reader;
+    operand->tensor = NULL;
+    operand->owned = NULL;
+    operand->handle = TENSOR_HANDLE_NULL;
+    
+    reader_skip_space(reader);
+    size_t start = reader->pos;
+    char form[BRIDGE_SYMBOL_MAX];
+    if (!reader_expect(reader, '(', "expected a tensor operand") ||
+        !reader_symbol(reader, form, sizeof(form))) {
+        return false;
+    }
+    
+    if (strcmp(form, "tensor") == 0) {
+        scheme_parse_error_t error;
+        size_t consumed = 0;
+        operand->owned = scheme_parse_tensor(reader->text + start, reader->length - start,
+                                             &consumed, &error);
+        if (!operand->owned) {
+            reader->pos = start + error.offset;
+            return reader_fail(reader, error.message);
+        }
+        operand->tensor = operand->owned;
+        reader->pos = start + consumed;
+        return true;
+    }
+    
+    bool by_handle = (strcmp(form, "handle") == 0);
+    if (!by_handle && strcmp(form, "ref") != 0) {
+        reader->pos = start;
+        return reader_fail(reader, "expected (tensor ...), (handle N) or (ref K)");
+    }
+    
+    reader_skip_space(reader);
+    size_t at = reader->pos;
+    uint64_t value;
+    if (!reader_unsigned(reader, &value) || !reader_expect(reader, ')', "expected ')'")) {
+        return false;
+    }
+    
+    tensor_handle_t handle = value;
+    if (!by_handle) {
+        handle = (value < batch->n_results) ? batch->results[value] : TENSOR_HANDLE_NULL;
+    }
+    operand->tensor = tensor_handle_get(batch->session->tensors, handle);
+    operand->handle = handle;
+    if (!operand->tensor) {
+        reader->pos = at;
+        return reader_fail(reader, by_handle ? "stale handle"
+                                             : "reference to a command without a tensor");
+    }
+    return true;
+}
+
+/**
+ * Keep a result resident and reply with its handle
+ */
+static bool batch_keep(command_batch_t* batch, neural_tensor_t* tensor, tensor_handle_t* produced) {
+    tensor_handle_t handle = tensor_handle_insert(batch->session->tensors, tensor);
+    if (handle == TENSOR_HANDLE_NULL) {
+        neural_tensor_free(tensor);
+        return reader_fail(&batch->reader, "out of memory");
+    }
+    
+    *produced = handle;
+    batch_emit_handle(batch, handle);
+    return true;
+}
+
+/**
+ * Reply (active-concepts ...) naming each node, or giving its index if unnamed
+ */
+static void batch_emit_nodes(command_batch_t* batch, const size_t* nodes, size_t n) {
+    batch_emit_text(batch, "(active-concepts");
+    for (size_t i = 0; i < n; i++) {
+        const char* name = concept_table_name(batch->session->concepts, nodes[i]);
+        batch_emit_text(batch, " ");
+        if (name) {
+            batch_emit_text(batch, name);
+        } else {
+            batch_emit_unsigned(batch, nodes[i]);
+        }
+    }
+    batch_emit_text(batch, ")");
+}
+
+static void batch_emit_active(command_batch_t* batch) {
+    size_t n_active = 0;
+    const size_t* active = activation_landscape_active_set(batch->session->context->landscape,
+                                                           &n_active);
+    batch_emit_nodes(batch, active, n_active);
+}
+
+/**
+ * Consume the ')' that ends a command
+ * Every command calls this after reading its arguments and before any
+ * effect, so a malformed form changes nothing.
+ */
+static bool batch_close(command_batch_t* batch) {
+    return reader_expect(&batch->reader, ')', "expected ')' closing the command");
+}
+
+/**
+ * Read a concept name and resolve it; fails at the name if it is unregistered
+ */
+static bool batch_concept(command_batch_t* batch, size_t* node) {
+    tensor_reader_t* reader = &batch->reader;
+    char name[BRIDGE_CONCEPT_MAX];
+    reader_skip_space(reader);
+    size_t at = reader->pos;
+    if (!reader_symbol(reader, name, sizeof(name))) return false;
+    
+    *node = concept_table_node(batch->session->concepts, name);
+    if (*node == SIZE_MAX) {
+        reader->pos = at;
+        return reader_fail(reader, "unknown concept");
+    }
+    return true;
+}
+
+/**
+ * (attention (concept ...) (weight ...)), as cognitive-grammar.scm builds it
+ * The names are checked and counted first, then resolved into nodes.
+ */
+static bool batch_attend_concepts(command_batch_t* batch, tensor_handle_t* produced) {
+    tensor_reader_t* reader = &batch->reader;
+    size_t node;
+    size_t n = 0;
+    
+    if (!reader_expect(reader, '(', "expected a tensor operand or (concept ...)")) return false;
+    size_t names_start = reader->pos;
+    while (!reader_at_close(reader)) {
+        if (!batch_concept(batch, &node)) return false;
+        n++;
+    }
+    reader->pos++;
+    size_t names_end = reader->pos;
+    
+    size_t* nodes = (size_t*)malloc((n ? n : 1) * sizeof(size_t));
+    float* weights = (float*)malloc((n ? n : 1) * sizeof(float));
+    bool ok = nodes && weights;
+    if (!ok) reader_fail(reader, "out of memory");
+    
+    reader->pos = names_start;
+    for (size_t i = 0; ok && i < n; i++) {
+        batch_concept(batch, &nodes[i]);
+    }
+    reader->pos = names_end;
+    
+    ok = ok && reader_expect(reader, '(', "expected (weight ...)");
+    for (size_t i = 0; ok && i < n; i++) {
+        reader_skip_space(reader);
+        ok = reader_float(reader, &weights[i]);
+    }
+    ok = ok && reader_expect(reader, ')', "expected one weight per concept") && batch_close(batch);
+    if (ok) {
+        neural_tensor_t* result = scheme_attend_concepts(batch->session->context, nodes,
+                                                         weights, n);
+        ok = result ? batch_keep(batch, result, produced)
+                    : reader_fail(reader, "attention failed");
+    }
+    
+    free(nodes);
+    free(weights);
+    return ok;
+}
+
+/**
+ * Run the command whose name has been read; writes one reply on success
+ */
+static bool batch_run(command_batch_t* batch, const char* command, tensor_handle_t* produced) {
+    tensor_reader_t* reader = &batch->reader;
+    cognitive_context_t* context = batch->session->context;
+    command_operand_t operands[BRIDGE_MAX_OPERANDS];
+    size_t n_operands = 0;
+    bool ok = true;
+    
+    if (strcmp(command, "neural-compute") == 0) {
+        // (neural-compute op operand ...), or the operands as one list as
+        // cognitive-grammar.scm builds it: (neural-compute op (operand ...))
+        char operation[BRIDGE_SYMBOL_MAX];
+        ok = reader_symbol(reader, operation, sizeof(operation));
+        bool operand_list = false;
+        if (ok) {
+            reader_skip_space(reader);
+            tensor_reader_t ahead = *reader;
+            ahead.error = NULL;
+            if (reader_expect(&ahead, '(', NULL) && reader_expect(&ahead, '(', NULL)) {
+                reader->pos++;
+                operand_list = true;
+            }
+        }
+        while (ok && !reader_at_close(reader)) {
+            if (n_operands == BRIDGE_MAX_OPERANDS) {
+                ok = reader_fail(reader, "too many operands");
+                break;
+            }
+            ok = batch_operand(batch, &operands[n_operands]);
+            if (ok) n_operands++;
+        }
+        if (ok && operand_list) {
+            ok = reader_expect(reader, ')', "expected ')' closing the operands");
+        }
+        if (ok && (ok = batch_close(batch))) {
+            const neural_tensor_t* inputs[BRIDGE_MAX_OPERANDS];
+            for (size_t i = 0; i < n_operands; i++) inputs[i] = operands[i].tensor;
+            neural_tensor_t* result = neural_execute(operation, inputs, n_operands);
+            ok = result ? batch_keep(batch, result, produced)
+                        : reader_fail(reader, "operation failed");
+        }
+    } else if (strcmp(command, "encode") == 0 && !batch_at_operand(batch)) {
+        // (encode form): a symbol, string or other datum, encoded as its text
+        char* text = batch_symbolic_text(batch);
+        if ((ok = text && batch_close(batch))) {
+            neural_tensor_t* tensor = encode_symbolic(text);
+            ok = tensor ? batch_keep(batch, tensor, produced)
+                        : reader_fail(reader, "out of memory");
+        }
+        free(text);
+    } else if (strcmp(command, "encode") == 0) {
+        // (encode operand): make the tensor resident
+        ok = batch_operand(batch, &operands[0]) && batch_close(batch);
+        n_operands = 1;
+        if (ok && operands[0].owned) {
+            ok = batch_keep(batch, operands[0].owned, produced);
+            operands[0].owned = NULL;
+        } else if (ok) {
+            neural_tensor_t* copy = neural_tensor_create(operands[0].tensor->shape,
+                                                         operands[0].tensor->n_dims);
+            if (copy) {
+                memcpy(copy->data, operands[0].tensor->data,
+                       operands[0].tensor->total_size * sizeof(float));
+            }
+            ok = copy ? batch_keep(batch, copy, produced) : reader_fail(reader, "out of memory");
+        }
+    } else if (strcmp(command, "decode") == 0) {
+        // (decode operand): reply with the tensor text
+        ok = batch_operand(batch, &operands[0]);
+        n_operands = 1;
+        if (ok && (ok = batch_close(batch))) {
+            scheme_write_tensor(operands[0].tensor, emit_to_batch, batch);
+        }
+    } else if (strcmp(command, "attention") == 0 && !batch_at_operand(batch)) {
+        ok = batch_attend_concepts(batch, produced);
+    } else if (strcmp(command, "attention") == 0) {
+        // (attention operand): input [n, n_nodes] through the context's attention
+        ok = batch_operand(batch, &operands[0]);
+        n_operands = 1;
+        if (ok && (ok = batch_close(batch))) {
+            neural_tensor_t* result = cognitive_context_attention(context, operands[0].tensor);
+            ok = result ? batch_keep(batch, result, produced)
+                        : reader_fail(reader, "attention failed");
+        }
+    } else if (strcmp(command, "spread-activation") == 0) {
+        // (spread-activation [seed] [decay])
+        float decay = BRIDGE_DEFAULT_DECAY;
+        reader_skip_space(reader);
+        if (reader->pos < reader->length && reader->text[reader->pos] == '(') {
+            ok = batch_operand(batch, &operands[0]);
+            n_operands = 1;
+            if (ok && operands[0].tensor->total_size != context->landscape->n_nodes) {
+                ok = reader_fail(reader, "seed size does not match the node count");
+            }
+        }
+        if (ok && !reader_at_close(reader)) ok = reader_float(reader, &decay);
+        if (ok && (ok = batch_close(batch))) {
+            if (n_operands > 0) {
+                activation_landscape_update(context->landscape, operands[0].tensor->data);
+            }
+            scheme_spread_activation(context, decay);
+            batch_emit_active(batch);
+        }
+    } else if (strcmp(command, "spread") == 0) {
+        // (spread (activation concept strength) threshold), as
+        // cognitive-grammar.scm builds it: replies with the nodes above threshold
+        char keyword[BRIDGE_SYMBOL_MAX];
+        size_t node = SIZE_MAX;
+        float strength = 0.0f;
+        float threshold = 0.0f;
+        ok = reader_expect(reader, '(', "expected (activation concept strength)") &&
+             reader_symbol(reader, keyword, sizeof(keyword));
+        if (ok && strcmp(keyword, "activation") != 0) {
+            reader->pos -= strlen(keyword);
+            ok = reader_fail(reader, "expected (activation concept strength)");
+        }
+        ok = ok && batch_concept(batch, &node);
+        if (ok) {
+            reader_skip_space(reader);
+            ok = reader_float(reader, &strength) &&
+                 reader_expect(reader, ')', "expected ')' closing the pattern");
+        }
+        if (ok) {
+            reader_skip_space(reader);
+            ok = reader_float(reader, &threshold) && batch_close(batch);
+        }
+        if (ok) {
+            size_t* above = (size_t*)malloc(context->landscape->n_nodes * sizeof(size_t));
+            size_t n_above = above ? scheme_spread_pattern(context, node, strength, threshold,
+                                                           above)
+                                   : SIZE_MAX;
+            if (n_above == SIZE_MAX) {
+                ok = reader_fail(reader, "out of memory");
+            } else {
+                batch_emit_nodes(batch, above, n_above);
+            }
+            free(above);
+        }
+    } else if (strcmp(command, "active-concepts") == 0) {
+        if ((ok = batch_close(batch))) batch_emit_active(batch);
+    } else if (strcmp(command, "register-concepts") == 0) {
+        // (register-concepts node name ...): names node, node + 1, ...
+        // The names are read once to check the form, then copied out and
+        // registered all together or not at all
+        uint64_t node = 0;
+        size_t n_names = 0;
+        char name[BRIDGE_CONCEPT_MAX];
+        reader_skip_space(reader);
+        ok = reader_unsigned(reader, &node);
+        size_t names_start = reader->pos;
+        while (ok && !reader_at_close(reader)) {
+            ok = reader_symbol(reader, name, sizeof(name));
+            n_names++;
+        }
+        size_t names_end = reader->pos;
+        if (ok && (ok = batch_close(batch))) {
+            // Each name plus its terminator fits in the span it was read from
+            size_t end = reader->pos;
+            size_t capacity = names_end - names_start + 1;
+            char* storage = (char*)malloc(capacity);
+            const char** names = (const char**)malloc((n_names ? n_names : 1) * sizeof(char*));
+            ok = storage && names;
+            size_t used = 0;
+            reader->pos = names_start;
+            for (size_t i = 0; ok && i < n_names; i++) {
+                reader_symbol(reader, storage + used, capacity - used);
+                names[i] = storage + used;
+                used += strlen(names[i]) + 1;
+            }
+            if (!ok) {
+                ok = reader_fail(reader, "out of memory");
+            } else if (!concept_table_register_all(batch->session->concepts, names, n_names,
+                                                   (size_t)node)) {
+                reader->pos = names_start;
+                ok = reader_fail(reader, "name already registered or node unavailable");
+            } else {
+                reader->pos = end;
+                batch_emit_text(batch, "(registered ");
+                batch_emit_unsigned(batch, n_names);
+                batch_emit_text(batch, ")");
+            }
+            free(storage);
+            free(names);
+        }
+    } else if (strcmp(command, "release") == 0) {
+        // (release (handle N)) or (release (ref K))
+        reader_skip_space(reader);
+        size_t at = reader->pos;
+        ok = batch_operand(batch, &operands[0]);
+        n_operands = 1;
+        if (ok && operands[0].owned) {
+            reader->pos = at;
+            ok = reader_fail(reader, "only resident tensors can be released");
+        } else if (ok && (ok = batch_close(batch))) {
+            tensor_handle_release(batch->session->tensors, operands[0].handle);
+            batch_emit_text(batch, "(released)");
+        }
+    } else {
+        reader->pos -= strlen(command);
+        ok = reader_fail(reader, "unknown command");
+    }
+    
+    for (size_t i = 0; i < n_operands; i++) {
+        neural_tensor_free(operands[i].owned);
+    }
+    
+    return ok;
+}
+
+/**
+ * Run one top-level command form, replying with its result or an error
+ */
+static bool batch_command(command_batch_t* batch) {
+    tensor_reader_t* reader = &batch->reader;
+    size_t start = reader->pos;
+    tensor_handle_t produced = TENSOR_HANDLE_NULL;
+    char command[BRIDGE_SYMBOL_MAX];
+    
+    batch_emit_text(batch, " ");
+    size_t reply_start = batch->output.length;
+    bool ok = reader_expect(reader, '(', "expected '(' starting a command") &&
+              reader_symbol(reader, command, sizeof(command)) &&
+              batch_run(batch, command, &produced);
+    
+    if (!ok) {
+        // A failed command leaves nothing resident for (ref K) to find
+        if (produced != TENSOR_HANDLE_NULL) {
+            tensor_handle_release(batch->session->tensors, produced);
+            produced = TENSOR_HANDLE_NULL;
+        }
+        // Replace any partial reply and resume after the failed form
+        if (!batch->output_failed) batch->output.length = reply_start;
+        batch_emit_error(batch);
+        reader->pos = start;
+        if (!reader_skip_datum(reader)) return false;
+    }
+    
+    if (batch->n_results == batch->results_capacity) {
+        size_t capacity = batch->results_capacity ? batch->results_capacity * 2 : 16;
+        tensor_handle_t* results = (tensor_handle_t*)realloc(batch->results,
+                                                            capacity * sizeof(tensor_handle_t));
+        if (!results) return false;
+        batch->results = results;
+        batch->results_capacity = capacity;
+    }
+    batch->results[batch->n_results++] = produced;
+    return true;
+}
+
+char* bridge_session_process(bridge_session_t* session, const char* commands, size_t length) {
+    if (!session || !commands) return NULL;
+    
+    command_batch_t batch;
+    memset(&batch, 0, sizeof(batch));
+    batch.session = session;
+    batch.reader.text = commands;
+    batch.reader.length = length;
+    batch.reader.error = &batch.error;
+    batch.output.capacity = 256;
+    batch.output.buffer = (char*)malloc(batch.output.capacity);
+    if (!batch.output.buffer) return NULL;
+    
+    // Commands run in order; each gets one reply, failures included
+    batch_emit_text(&batch, "(results");
+    reader_skip_space(&batch.reader);
+    while (batch.reader.pos < length) {
+        if (!batch_command(&batch)) break;
+        reader_skip_space(&batch.reader);
+    }
+    batch_emit_text(&batch, ")");
+    free(batch.results);
+    
+    if (batch.output_failed) {
+        free(batch.output.buffer);
+        return NULL;
+    }
+    batch.output.buffer[batch.output.length] = '\0';
+    return batch.output.buffer;
+}
+
 // ============================================================================
 // MAIN BRIDGE INTERFACE
 // ============================================================================
 
+// Session behind bridge_process
+static bridge_session_t* bridge_default_session = NULL;
+
+bridge_session_t* bridge_session_create(size_t n_nodes, size_t memory_capacity) {
+    bridge_session_t* session = (bridge_session_t*)calloc(1, sizeof(bridge_session_t));
+    if (!session) return NULL;
+    
+    session->context = cognitive_context_create(n_nodes, memory_capacity);
+    session->tensors = tensor_handle_table_create(0);
+    session->concepts = concept_table_create(n_nodes);
+    if (!session->context || !session->tensors || !session->concepts) {
+        bridge_session_free(session);
+        return NULL;
+    }
+    
+    return session;
+}
+
+void bridge_session_free(bridge_session_t* session) {
+    if (session) {
+        cognitive_context_free(session->context);
+        tensor_handle_table_free(session->tensors);
+        concept_table_free(session->concepts);
+        free(session);
+    }
+}
+
 /**
  * Initialize the neural-symbolic bridge
  */
-int bridge_init() {
+int bridge_init(void) {
+    if (!bridge_default_session) {
+        bridge_default_session = bridge_session_create(BRIDGE_DEFAULT_NODES, BRIDGE_DEFAULT_MEMORY);
+        if (!bridge_default_session) return -1;
+    }
+    
     printf("Neural-Symbolic Bridge initialized.\n");
     printf("  Scheme (Mind) <-> C/ggml (Brain)\n");
     return 0;
@@ -251,32 +1904,150 @@ int bridge_init() {
 /**
  * Shutdown the bridge
  */
-void bridge_shutdown() {
+void bridge_shutdown(void) {
+    bridge_session_free(bridge_default_session);
+    bridge_default_session = NULL;
     printf("Neural-Symbolic Bridge shutdown.\n");
 }
 
 /**
- * Process a Scheme command with neural backing
+ * Process Scheme commands with neural backing
  */
 char* bridge_process(const char* scheme_command) {
-    if (!scheme_command) return NULL;
+    if (!scheme_command || !bridge_default_session) return NULL;
+    
+    return bridge_session_process(bridge_default_session, scheme_command,
+                                  strlen(scheme_command));
+}
+
+// ============================================================================
+// BRIDGE MESSAGES
+// ============================================================================
+
+void bridge_message_header(uint8_t* header, uint8_t type, size_t length) {
+    uint32_t value = (uint32_t)length;
+    for (int i = 0; i < 4; i++) header[i] = (uint8_t)(value >> (8 * i));
+    header[4] = type;
+    header[5] = BRIDGE_MESSAGE_VERSION;
+    header[6] = 0;
+    header[7] = 0;
+}
+
+bool bridge_message_parse_header(const uint8_t* header, uint8_t* type, size_t* length) {
+    if (!header || header[5] != BRIDGE_MESSAGE_VERSION) return false;
     
-    // Parse and execute command
-    // This is a simplified demonstration
+    uint32_t value = 0;
+    for (int i = 3; i >= 0; i--) value = (value << 8) | header[i];
+    if (value > BRIDGE_MESSAGE_MAX) return false;
     
-    if (strstr(scheme_command, "neural-compute")) {
-        // Example: (neural-compute 'add tensor1 tensor2)
-        return strdup("(result (tensor (shape 2 2) (data 1.0 1.0 1.0 1.0)))");
+    *type = header[4];
+    *length = value;
+    return true;
+}
+
+static uint8_t* message_error(const char* message, uint8_t* reply_type, size_t* reply_length) {
+    *reply_type = BRIDGE_MESSAGE_ERROR;
+    *reply_length = strlen(message);
+    return (uint8_t*)strdup(message);
+}
+
+/**
+ * COMPUTE: [u8 name length][name][zero pad to 8][frame ...] -> result frame
+ */
+static uint8_t* message_compute(const uint8_t* payload, size_t length,
+                                uint8_t* reply_type, size_t* reply_length) {
+    if (length < 1 || payload[0] == 0 || payload[0] >= BRIDGE_SYMBOL_MAX ||
+        (size_t)payload[0] + 1 > length) {
+        return message_error("malformed operation name", reply_type, reply_length);
+    }
+    
+    char operation[BRIDGE_SYMBOL_MAX];
+    memcpy(operation, payload + 1, payload[0]);
+    operation[payload[0]] = '\0';
+    
+    // Frames start at the next multiple of 8 and are delimited by their headers
+    const uint8_t* frames[BRIDGE_MAX_OPERANDS];
+    size_t sizes[BRIDGE_MAX_OPERANDS];
+    size_t n_frames = 0;
+    size_t offset = ((size_t)payload[0] + 1 + 7) & ~(size_t)7;
+    while (offset < length) {
+        size_t shape[SCHEME_TENSOR_MAX_RANK];
+        size_t n_dims = 0;
+        size_t total = 0;
+        size_t header_size = frame_parse_header(payload + offset, length - offset,
+                                                shape, &n_dims, &total);
+        if (header_size == 0) {
+            return message_error("malformed tensor frame", reply_type, reply_length);
+        }
+        if (n_frames == BRIDGE_MAX_OPERANDS) {
+            return message_error("too many operands", reply_type, reply_length);
+        }
+        frames[n_frames] = payload + offset;
+        sizes[n_frames] = header_size + total * sizeof(float);
+        offset += sizes[n_frames++];
     }
     
-    return strdup("(error unknown-command)");
+    size_t size = 0;
+    uint8_t* result = scheme_neural_compute_binary(operation, frames, sizes, n_frames, &size);
+    if (!result) return message_error("operation failed", reply_type, reply_length);
+    
+    *reply_type = BRIDGE_MESSAGE_COMPUTE;
+    *reply_length = size;
+    return result;
+}
+
+uint8_t* bridge_session_message(bridge_session_t* session, uint8_t type,
+                                const uint8_t* payload, size_t length,
+                                uint8_t* reply_type, size_t* reply_length) {
+    if (!session || (!payload && length > 0) || !reply_type || !reply_length) return NULL;
+    
+    switch (type) {
+        case BRIDGE_MESSAGE_COMMANDS: {
+            char* replies = bridge_session_process(session, (const char*)payload, length);
+            if (!replies) return NULL;
+            *reply_type = BRIDGE_MESSAGE_COMMANDS;
+            *reply_length = strlen(replies);
+            return (uint8_t*)replies;
+        }
+    
+        case BRIDGE_MESSAGE_PUT_TENSOR: {
+            tensor_handle_t handle = scheme_tensor_load_frame(session->tensors, payload, length);
+            if (handle == TENSOR_HANDLE_NULL) {
+                return message_error("malformed tensor frame", reply_type, reply_length);
+            }
+            uint8_t* reply = (uint8_t*)malloc(sizeof(uint64_t));
+            if (!reply) return NULL;
+            store_le64(reply, handle);
+            *reply_type = BRIDGE_MESSAGE_PUT_TENSOR;
+            *reply_length = sizeof(uint64_t);
+            return reply;
+        }
+    
+        case BRIDGE_MESSAGE_GET_TENSOR: {
+            if (length != sizeof(uint64_t)) {
+                return message_error("expected a 64-bit handle", reply_type, reply_length);
+            }
+            size_t size = 0;
+            uint8_t* frame = scheme_tensor_frame(session->tensors, load_le64(payload), &size);
+            if (!frame) return message_error("stale handle", reply_type, reply_length);
+            *reply_type = BRIDGE_MESSAGE_GET_TENSOR;
+            *reply_length = size;
+            return frame;
+        }
+    
+        case BRIDGE_MESSAGE_COMPUTE:
+            return message_compute(payload, length, reply_type, reply_length);
+    
+        default:
+            return message_error("unknown message type", reply_type, reply_length);
+    }
 }
 
 // ============================================================================
 // DEMONSTRATION FUNCTION
 // ============================================================================
 
-void demonstrate_symbiosis() {
+void demonstrate_symbiosis(void) {
     printf("\n=== Neural-Symbolic Symbiosis Demonstration ===\n\n");
     
     // Create cognitive context
@@ -316,22 +2087,38 @@ void demonstrate_symbiosis() {
     if (tensor) {
         tensor->data[0] = 1.0f; tensor->data[1] = 2.0f; tensor->data[2] = 3.0f;
         tensor->data[3] = 4.0f; tensor->data[4] = 5.0f; tensor->data[5] = 6.0f;
-        
+    
         printf("   Tensor created:\n");
         neural_tensor_print_info(tensor);
-        
+    
         // Convert to Scheme
         char* scheme_repr = tensor_to_scheme_list(tensor);
         if (scheme_repr) {
             printf("\n   Scheme representation:\n   %s\n\n", scheme_repr);
             free(scheme_repr);
         }
-        
+    
         neural_tensor_free(tensor);
     }
     
+    // Batch of commands sharing one session
+    printf("6. Running a command batch...\n");
+    bridge_session_t* session = bridge_session_create(10, 100);
+    if (session) {
+        const char* batch = "(encode (tensor (shape 2 2) (data 1 2 3 4))) "
+                            "(neural-compute matmul (ref 0) (ref 0)) "
+                            "(neural-compute relu (ref 1)) "
+                            "(decode (ref 2))";
+        char* replies = bridge_session_process(session, batch, strlen(batch));
+        if (replies) {
+            printf("   %s\n\n", replies);
+            free(replies);
+        }
+        bridge_session_free(session);
+    }
+    
     // Cleanup
-    printf("6. Cleaning up...\n");
+    printf("7. Cleaning up...\n");
     cognitive_context_free(context);
     printf("   Demonstration complete.\n\n");
 }
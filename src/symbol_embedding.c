@@ -0,0 +1,569 @@
+/**
+ * symbol_embedding.c
+ *
+ * Implementation of the hashed n-gram symbol encoder and its LRU cache
+ */
+
+#include "symbol_embedding.h"
+#include "neural_parallel.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+// Width used when an encoder is created without a configuration
+#define SYMBOL_DEFAULT_DIM 64
+
+// Hash domain of whole-token features (n-gram features use their length)
+#define TOKEN_FEATURE 0
+
+// Rows encoded per parallel task in batch encoding
+#define SYMBOL_BATCH_CHUNK 32
+
+// ============================================================================
+// FEATURE HASHING
+// ============================================================================
+
+static uint64_t fnv_step(uint64_t hash, unsigned char c) {
+    return (hash ^ c) * 1099511628211ull;
+}
+
+/**
+ * Final avalanche so nearby FNV states pick unrelated codebook rows
+ */
+static uint64_t hash_finish(uint64_t hash) {
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdull;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ull;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+static bool is_token_char(unsigned char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c >= 0x80;
+}
+
+static unsigned char fold_case(unsigned char c) {
+    return (c >= 'A' && c <= 'Z') ? (unsigned char)(c - 'A' + 'a') : c;
+}
+
+/**
+ * Character p of a token wrapped in boundary markers: '<' token '>'
+ */
+static unsigned char marked_char(const char* token, size_t length, size_t p) {
+    if (p == 0) return '<';
+    if (p > length) return '>';
+    return fold_case((unsigned char)token[p - 1]);
+}
+
+/**
+ * out += weight * row
+ * Unit stride with no aliasing between out and the codebook, so the optimized
+ * build (CMake's default Release) auto-vectorizes it.
+ */
+static void accumulate_row(float* restrict out, const float* restrict row, float weight,
+                           size_t dim) {
+    for (size_t j = 0; j < dim; j++) {
+        out[j] += weight * row[j];
+    }
+}
+
+/**
+ * Add one hashed feature: two codebook rows with independent signs, which
+ * keeps two colliding features from sharing their whole contribution
+ */
+static void add_feature(const symbol_encoder_t* encoder, uint64_t hash, float weight, float* out) {
+    size_t dim = encoder->config.dim;
+    size_t n_buckets = encoder->config.n_buckets;
+    hash = hash_finish(hash);
+    
+    size_t first = (size_t)((hash & 0x3fffffffull) % n_buckets);
+    size_t second = (size_t)(((hash >> 30) & 0x3fffffffull) % n_buckets);
+    float first_sign = (hash >> 62) & 1 ? -weight : weight;
+    float second_sign = (hash >> 63) & 1 ? -weight : weight;
+    
+    accumulate_row(out, encoder->codebook + first * dim, first_sign, dim);
+    accumulate_row(out, encoder->codebook + second * dim, second_sign, dim);
+}
+
+static void add_token_features(const symbol_encoder_t* encoder, const char* token,
+                               size_t length, float* out) {
+    const symbol_encoder_config_t* config = &encoder->config;
+    
+    uint64_t hash = fnv_step(14695981039346656037ull ^ config->seed, TOKEN_FEATURE);
+    for (size_t i = 0; i < length; i++) {
+        hash = fnv_step(hash, fold_case((unsigned char)token[i]));
+    }
+    add_feature(encoder, hash, config->token_weight, out);
+    
+    size_t marked_length = length + 2;
+    for (size_t n = config->min_gram; n <= config->max_gram && n <= marked_length; n++) {
+        for (size_t p = 0; p + n <= marked_length; p++) {
+            uint64_t gram = fnv_step(14695981039346656037ull ^ config->seed, (unsigned char)n);
+            for (size_t k = 0; k < n; k++) {
+                gram = fnv_step(gram, marked_char(token, length, p + k));
+            }
+            add_feature(encoder, gram, 1.0f, out);
+        }
+    }
+}
+
+bool symbol_embedding_compute(const symbol_encoder_t* encoder,
+                              const char* text, size_t length, float* out) {
+    if (!encoder || !text || !out) return false;
+    
+    size_t dim = encoder->config.dim;
+    memset(out, 0, dim * sizeof(float));
+    
+    size_t i = 0;
+    while (i < length) {
+        while (i < length && !is_token_char((unsigned char)text[i])) i++;
+        size_t start = i;
+        while (i < length && is_token_char((unsigned char)text[i])) i++;
+        if (i > start) add_token_features(encoder, text + start, i - start, out);
+    }
+    
+    float sum_sq = 0.0f;
+    for (size_t j = 0; j < dim; j++) {
+        sum_sq += out[j] * out[j];
+    }
+    if (sum_sq > 0.0f) {
+        float scale = 1.0f / sqrtf(sum_sq);
+        for (size_t j = 0; j < dim; j++) {
+            out[j] *= scale;
+        }
+    }
+    return true;
+}
+
+float symbol_embedding_cosine(const float* a, const float* b, size_t dim) {
+    if (!a || !b) return 0.0f;
+    
+    float dot = 0.0f, norm_a = 0.0f, norm_b = 0.0f;
+    for (size_t j = 0; j < dim; j++) {
+        dot += a[j] * b[j];
+        norm_a += a[j] * a[j];
+        norm_b += b[j] * b[j];
+    }
+    if (norm_a == 0.0f || norm_b == 0.0f) return 0.0f;
+    return dot / sqrtf(norm_a * norm_b);
+}
+
+// ============================================================================
+// LIFECYCLE
+// ============================================================================
+
+symbol_encoder_config_t symbol_encoder_default_config(size_t dim) {
+    symbol_encoder_config_t config;
+    config.dim = dim;
+    config.min_gram = 3;
+    config.max_gram = 5;
+    config.token_weight = 2.0f;
+    config.n_buckets = 4096;
+    config.cache_capacity = 1024;
+    config.seed = 0x9E3779B97F4A7C15ull;
+    return config;
+}
+
+symbol_encoder_t* symbol_encoder_create(const symbol_encoder_config_t* config) {
+    symbol_encoder_config_t defaults = symbol_encoder_default_config(SYMBOL_DEFAULT_DIM);
+    if (!config) config = &defaults;
+    if (config->dim == 0 || config->n_buckets == 0 || config->min_gram == 0 ||
+        config->min_gram > config->max_gram || config->max_gram > SYMBOL_EMBEDDING_MAX_GRAM ||
+        !isfinite(config->token_weight)) {
+        return NULL;
+    }
+    
+    symbol_encoder_t* encoder = (symbol_encoder_t*)calloc(1, sizeof(symbol_encoder_t));
+    if (!encoder) return NULL;
+    
+    size_t dim = config->dim;
+    size_t capacity = config->cache_capacity;
+    encoder->config = *config;
+    encoder->codebook = (float*)malloc(config->n_buckets * dim * sizeof(float));
+    encoder->scratch = (float*)malloc(dim * sizeof(float));
+    if (!encoder->codebook || !encoder->scratch) {
+        symbol_encoder_free(encoder);
+        return NULL;
+    }
+    
+    if (capacity > 0) {
+        encoder->index_capacity = 8;
+        while (encoder->index_capacity < 2 * capacity) encoder->index_capacity *= 2;
+        encoder->keys = (char**)calloc(capacity, sizeof(char*));
+        encoder->key_hashes = (uint64_t*)malloc(capacity * sizeof(uint64_t));
+        encoder->rows = (float*)malloc(capacity * dim * sizeof(float));
+        encoder->newer = (size_t*)malloc(capacity * sizeof(size_t));
+        encoder->older = (size_t*)malloc(capacity * sizeof(size_t));
+        encoder->index = (size_t*)calloc(encoder->index_capacity, sizeof(size_t));
+        if (!encoder->keys || !encoder->key_hashes || !encoder->rows ||
+            !encoder->newer || !encoder->older || !encoder->index) {
+            symbol_encoder_free(encoder);
+            return NULL;
+        }
+    }
+    encoder->most_recent = SIZE_MAX;
+    encoder->least_recent = SIZE_MAX;
+    
+    // Rademacher rows scaled so a single feature encodes at unit length
+    float scale = 1.0f / sqrtf((float)dim);
+    uint32_t rng = (uint32_t)(config->seed ^ (config->seed >> 32));
+    if (rng == 0) rng = 0x9E3779B9u;
+    for (size_t i = 0; i < config->n_buckets * dim; i++) {
+        rng ^= rng << 13;
+        rng ^= rng >> 17;
+        rng ^= rng << 5;
+        encoder->codebook[i] = (rng >> 31) ? -scale : scale;
+    }
+    
+    return encoder;
+}
+
+void symbol_encoder_free(symbol_encoder_t* encoder) {
+    if (encoder) {
+        if (encoder->keys) {
+            for (size_t i = 0; i < encoder->n_cached; i++) free(encoder->keys[i]);
+        }
+        free(encoder->codebook);
+        free(encoder->scratch);
+        free(encoder->keys);
+        free(encoder->key_hashes);
+        free(encoder->rows);
+        free(encoder->newer);
+        free(encoder->older);
+        free(encoder->index);
+        free(encoder);
+    }
+}
+
+// ============================================================================
+// LRU CACHE
+// ============================================================================
+
+static uint64_t key_hash(const char* text, size_t length) {
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < length; i++) {
+        hash = fnv_step(hash, (unsigned char)text[i]);
+    }
+    return hash;
+}
+
+/**
+ * Cached entry for text, or SIZE_MAX with *slot set to the empty index slot
+ * where it would be inserted
+ */
+static size_t cache_find(const symbol_encoder_t* encoder, const char* text, size_t length,
+                         uint64_t hash, size_t* slot) {
+    size_t mask = encoder->index_capacity - 1;
+    size_t probe = (size_t)hash & mask;
+    
+    while (encoder->index[probe] != 0) {
+        size_t entry = encoder->index[probe] - 1;
+        const char* key = encoder->keys[entry];
+        if (encoder->key_hashes[entry] == hash && memcmp(key, text, length) == 0 &&
+            key[length] == '\0') {
+            return entry;
+        }
+        probe = (probe + 1) & mask;
+    }
+    *slot = probe;
+    return SIZE_MAX;
+}
+
+/**
+ * Remove an entry from the index, shifting later members of its probe run
+ * back so lookups never stop at the hole
+ */
+static void index_remove(symbol_encoder_t* encoder, size_t entry) {
+    size_t mask = encoder->index_capacity - 1;
+    size_t hole = (size_t)encoder->key_hashes[entry] & mask;
+    while (encoder->index[hole] != entry + 1) hole = (hole + 1) & mask;
+    
+    for (size_t probe = (hole + 1) & mask; encoder->index[probe] != 0; probe = (probe + 1) & mask) {
+        size_t home = (size_t)encoder->key_hashes[encoder->index[probe] - 1] & mask;
+        if (((probe - home) & mask) >= ((probe - hole) & mask)) {
+            encoder->index[hole] = encoder->index[probe];
+            hole = probe;
+        }
+    }
+    encoder->index[hole] = 0;
+}
+
+static void lru_unlink(symbol_encoder_t* encoder, size_t entry) {
+    size_t newer = encoder->newer[entry];
+    size_t older = encoder->older[entry];
+    
+    if (newer != SIZE_MAX) {
+        encoder->older[newer] = older;
+    } else {
+        encoder->most_recent = older;
+    }
+    if (older != SIZE_MAX) {
+        encoder->newer[older] = newer;
+    } else {
+        encoder->least_recent = newer;
+    }
+}
+
+static void lru_push(symbol_encoder_t* encoder, size_t entry) {
+    encoder->newer[entry] = SIZE_MAX;
+    encoder->older[entry] = encoder->most_recent;
+    if (encoder->most_recent != SIZE_MAX) {
+        encoder->newer[encoder->most_recent] = entry;
+    } else {
+        encoder->least_recent = entry;
+    }
+    encoder->most_recent = entry;
+}
+
+/**
+ * Cached row for text (marked most recent), or NULL on a miss
+ */
+static float* cache_touch(symbol_encoder_t* encoder, const char* text, size_t length,
+                          uint64_t hash) {
+    size_t slot;
+    size_t entry = cache_find(encoder, text, length, hash, &slot);
+    if (entry == SIZE_MAX) return NULL;
+    
+    encoder->hits++;
+    if (entry != encoder->most_recent) {
+        lru_unlink(encoder, entry);
+        lru_push(encoder, entry);
+    }
+    return encoder->rows + entry * encoder->config.dim;
+}
+
+/**
+ * Cache an uncached text, evicting the least recently used entry when full
+ * The row is copied from computed, or computed here when that is NULL.
+ */
+static float* cache_insert(symbol_encoder_t* encoder, const char* text, size_t length,
+                           uint64_t hash, const float* computed) {
+    size_t dim = encoder->config.dim;
+    
+    // Copy the key first so a failed allocation leaves the cache untouched
+    char* key = (char*)malloc(length + 1);
+    if (!key) return NULL;
+    memcpy(key, text, length);
+    key[length] = '\0';
+    
+    size_t entry;
+    if (encoder->n_cached < encoder->config.cache_capacity) {
+        entry = encoder->n_cached++;
+    } else {
+        entry = encoder->least_recent;
+        index_remove(encoder, entry);
+        lru_unlink(encoder, entry);
+        free(encoder->keys[entry]);
+    }
+    
+    // Probe after any eviction, which may have shifted this key's run
+    size_t mask = encoder->index_capacity - 1;
+    size_t slot = (size_t)hash & mask;
+    while (encoder->index[slot] != 0) slot = (slot + 1) & mask;
+    
+    float* row = encoder->rows + entry * dim;
+    if (computed) {
+        memcpy(row, computed, dim * sizeof(float));
+    } else {
+        symbol_embedding_compute(encoder, text, length, row);
+    }
+    encoder->keys[entry] = key;
+    encoder->key_hashes[entry] = hash;
+    encoder->index[slot] = entry + 1;
+    lru_push(encoder, entry);
+    return row;
+}
+
+const float* symbol_encoder_lookup(symbol_encoder_t* encoder, const char* text) {
+    if (!encoder || !text) return NULL;
+    
+    size_t length = strlen(text);
+    if (encoder->config.cache_capacity == 0) {
+        encoder->misses++;
+        symbol_embedding_compute(encoder, text, length, encoder->scratch);
+        return encoder->scratch;
+    }
+    
+    uint64_t hash = key_hash(text, length);
+    float* row = cache_touch(encoder, text, length, hash);
+    if (row) return row;
+    
+    encoder->misses++;
+    return cache_insert(encoder, text, length, hash, NULL);
+}
+
+bool symbol_encoder_encode_into(symbol_encoder_t* encoder, const char* text, float* out) {
+    if (!out) return false;
+    
+    const float* row = symbol_encoder_lookup(encoder, text);
+    if (!row) return false;
+    memcpy(out, row, encoder->config.dim * sizeof(float));
+    return true;
+}
+
+neural_tensor_t* symbol_encoder_encode(symbol_encoder_t* encoder, const char* text) {
+    if (!encoder || !text) return NULL;
+    
+    size_t shape[1] = {encoder->config.dim};
+    neural_tensor_t* tensor = neural_tensor_create(shape, 1);
+    if (tensor && !symbol_encoder_encode_into(encoder, text, tensor->data)) {
+        neural_tensor_free(tensor);
+        return NULL;
+    }
+    return tensor;
+}
+
+void symbol_encoder_clear_cache(symbol_encoder_t* encoder) {
+    if (!encoder || encoder->config.cache_capacity == 0) return;
+    
+    for (size_t i = 0; i < encoder->n_cached; i++) {
+        free(encoder->keys[i]);
+        encoder->keys[i] = NULL;
+    }
+    memset(encoder->index, 0, encoder->index_capacity * sizeof(size_t));
+    encoder->n_cached = 0;
+    encoder->most_recent = SIZE_MAX;
+    encoder->least_recent = SIZE_MAX;
+}
+
+// ============================================================================
+// BATCH ENCODING
+// ============================================================================
+
+/**
+ * Shared state of a parallel embedding batch
+ */
+typedef struct {
+    const symbol_encoder_t* encoder;
+    const char* const* texts;
+    const size_t* rows;         // Rows to compute, NULL for every row
+    size_t n_rows;
+    float* out;                 // [n_texts, dim]
+} embed_batch_job_t;
+
+static void embed_batch_task(void* ctx, size_t chunk) {
+    const embed_batch_job_t* job = (const embed_batch_job_t*)ctx;
+    size_t dim = job->encoder->config.dim;
+    
+    size_t begin = chunk * SYMBOL_BATCH_CHUNK;
+    size_t end = begin + SYMBOL_BATCH_CHUNK;
+    if (end > job->n_rows) end = job->n_rows;
+    
+    for (size_t i = begin; i < end; i++) {
+        size_t row = job->rows ? job->rows[i] : i;
+        const char* text = job->texts[row] ? job->texts[row] : "";
+        symbol_embedding_compute(job->encoder, text, strlen(text), job->out + row * dim);
+    }
+}
+
+bool symbol_encoder_encode_batch_into(symbol_encoder_t* encoder, const char* const* texts,
+                                      size_t n_texts, neural_tensor_t* out) {
+    if (!encoder || !texts || !out || out->n_dims != 2 || out->shape[0] != n_texts ||
+        out->shape[1] != encoder->config.dim) {
+        return false;
+    }
+    
+    size_t dim = encoder->config.dim;
+    bool cached = encoder->config.cache_capacity > 0;
+    size_t* pending = NULL;
+    size_t n_pending = n_texts;
+    
+    // Serve hits first so only misses reach the workers
+    if (cached) {
+        pending = (size_t*)malloc(n_texts * sizeof(size_t));
+        if (!pending) return false;
+        n_pending = 0;
+        for (size_t i = 0; i < n_texts; i++) {
+            const char* text = texts[i] ? texts[i] : "";
+            size_t length = strlen(text);
+            const float* row = cache_touch(encoder, text, length, key_hash(text, length));
+            if (row) {
+                memcpy(out->data + i * dim, row, dim * sizeof(float));
+            } else {
+                pending[n_pending++] = i;
+            }
+        }
+    }
+    
+    // The workers only read the encoder, so misses encode concurrently
+    embed_batch_job_t job = {encoder, texts, pending, n_pending, out->data};
+    neural_parallel_for((n_pending + SYMBOL_BATCH_CHUNK - 1) / SYMBOL_BATCH_CHUNK,
+                        embed_batch_task, &job);
+    encoder->misses += n_pending;
+    
+    // Cache the new rows; a text repeated within the batch is stored once
+    for (size_t k = 0; k < n_pending && cached; k++) {
+        size_t i = pending[k];
+        const char* text = texts[i] ? texts[i] : "";
+        size_t length = strlen(text);
+        uint64_t hash = key_hash(text, length);
+        size_t slot;
+        if (cache_find(encoder, text, length, hash, &slot) == SIZE_MAX) {
+            cache_insert(encoder, text, length, hash, out->data + i * dim);
+        }
+    }
+    
+    free(pending);
+    return true;
+}
+
+neural_tensor_t* symbol_encoder_encode_batch(symbol_encoder_t* encoder,
+                                             const char* const* texts, size_t n_texts) {
+    if (!encoder || !texts || n_texts == 0) return NULL;
+    
+    size_t shape[2] = {n_texts, encoder->config.dim};
+    neural_tensor_t* out = neural_tensor_create(shape, 2);
+    if (out && !symbol_encoder_encode_batch_into(encoder, texts, n_texts, out)) {
+        neural_tensor_free(out);
+        return NULL;
+    }
+    return out;
+}
+
+/**
+ * Shared state of a parallel character-code batch
+ */
+typedef struct {
+    const char* const* texts;
+    size_t n_texts;
+    size_t width;
+    float pad_value;
+    symbol_truncation_t truncation;
+    float* out;                 // [n_texts, width]
+} characters_batch_job_t;
+
+static void characters_batch_task(void* ctx, size_t chunk) {
+    const characters_batch_job_t* job = (const characters_batch_job_t*)ctx;
+    size_t width = job->width;
+    
+    size_t begin = chunk * SYMBOL_BATCH_CHUNK;
+    size_t end = begin + SYMBOL_BATCH_CHUNK;
+    if (end > job->n_texts) end = job->n_texts;
+    
+    for (size_t i = begin; i < end; i++) {
+        const char* text = job->texts[i] ? job->texts[i] : "";
+        size_t length = strlen(text);
+        size_t n = (length < width) ? length : width;
+        if (job->truncation == SYMBOL_TRUNCATE_START) text += length - n;
+    
+        float* row = job->out + i * width;
+        for (size_t j = 0; j < n; j++) {
+            row[j] = (float)text[j] / 255.0f;
+        }
+        for (size_t j = n; j < width; j++) {
+            row[j] = job->pad_value;
+        }
+    }
+}
+
+bool symbol_encode_characters_batch_into(const char* const* texts, size_t n_texts,
+                                         float pad_value, symbol_truncation_t truncation,
+                                         neural_tensor_t* out) {
+    if (!texts || !out || out->n_dims != 2 || out->shape[0] != n_texts) return false;
+    
+    characters_batch_job_t job = {texts, n_texts, out->shape[1], pad_value, truncation, out->data};
+    neural_parallel_for((n_texts + SYMBOL_BATCH_CHUNK - 1) / SYMBOL_BATCH_CHUNK,
+                        characters_batch_task, &job);
+    return true;
+}
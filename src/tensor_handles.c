@@ -0,0 +1,152 @@
+/**
+ * tensor_handles.c
+ *
+ * Implementation of the generation-checked tensor slot map
+ */
+
+#include "tensor_handles.h"
+#include <stdlib.h>
+
+#define TENSOR_HANDLE_NO_SLOT UINT32_MAX
+#define TENSOR_HANDLE_GENERATION_MASK ((1u << TENSOR_HANDLE_GENERATION_BITS) - 1)
+
+// ============================================================================
+// HANDLE ENCODING
+// ============================================================================
+
+static tensor_handle_t handle_make(uint32_t slot, uint32_t generation) {
+    return ((tensor_handle_t)generation << 32) | slot;
+}
+
+/**
+ * Resolve a handle to its live slot (NULL if stale or out of range)
+ */
+static tensor_handle_slot_t* handle_slot(const tensor_handle_table_t* table,
+                                         tensor_handle_t handle) {
+    if (!table || handle == TENSOR_HANDLE_NULL) return NULL;
+    
+    uint64_t slot = handle & 0xffffffffu;
+    uint32_t generation = (uint32_t)(handle >> 32);
+    if (slot >= table->length) return NULL;
+    
+    tensor_handle_slot_t* entry = &table->slots[slot];
+    if (!entry->tensor || entry->generation != generation) return NULL;
+    return entry;
+}
+
+/**
+ * Empty a slot, invalidate its handles and push it on the free list
+ */
+static void slot_retire(tensor_handle_table_t* table, uint32_t slot) {
+    tensor_handle_slot_t* entry = &table->slots[slot];
+    entry->tensor = NULL;
+    
+    // Generation 0 is skipped so no handle is ever 0
+    entry->generation = (entry->generation + 1) & TENSOR_HANDLE_GENERATION_MASK;
+    if (entry->generation == 0) entry->generation = 1;
+    
+    entry->next_free = table->free_head;
+    table->free_head = slot;
+    table->count--;
+}
+
+// ============================================================================
+// LIFECYCLE
+// ============================================================================
+
+tensor_handle_table_t* tensor_handle_table_create(size_t initial_capacity) {
+    if (initial_capacity == 0) initial_capacity = 16;
+    if (initial_capacity > TENSOR_HANDLE_NO_SLOT) return NULL;
+    
+    tensor_handle_table_t* table = (tensor_handle_table_t*)calloc(1, sizeof(tensor_handle_table_t));
+    if (!table) return NULL;
+    
+    table->slots = (tensor_handle_slot_t*)calloc(initial_capacity, sizeof(tensor_handle_slot_t));
+    if (!table->slots) {
+        free(table);
+        return NULL;
+    }
+    table->capacity = initial_capacity;
+    table->free_head = TENSOR_HANDLE_NO_SLOT;
+    
+    return table;
+}
+
+void tensor_handle_table_free(tensor_handle_table_t* table) {
+    if (table) {
+        if (table->slots) {
+            for (size_t i = 0; i < table->length; i++) {
+                neural_tensor_free(table->slots[i].tensor);
+            }
+            free(table->slots);
+        }
+        free(table);
+    }
+}
+
+void tensor_handle_table_clear(tensor_handle_table_t* table) {
+    if (!table) return;
+    
+    for (size_t i = 0; i < table->length; i++) {
+        if (table->slots[i].tensor) {
+            neural_tensor_free(table->slots[i].tensor);
+            slot_retire(table, (uint32_t)i);
+        }
+    }
+}
+
+// ============================================================================
+// HANDLE OPERATIONS
+// ============================================================================
+
+tensor_handle_t tensor_handle_insert(tensor_handle_table_t* table, neural_tensor_t* tensor) {
+    if (!table || !tensor) return TENSOR_HANDLE_NULL;
+    
+    uint32_t slot;
+    if (table->free_head != TENSOR_HANDLE_NO_SLOT) {
+        slot = table->free_head;
+        table->free_head = table->slots[slot].next_free;
+    } else {
+        if (table->length == table->capacity) {
+            size_t capacity = table->capacity * 2;
+            if (capacity > TENSOR_HANDLE_NO_SLOT) capacity = TENSOR_HANDLE_NO_SLOT;
+            if (capacity == table->capacity) return TENSOR_HANDLE_NULL;
+    
+            tensor_handle_slot_t* slots = (tensor_handle_slot_t*)realloc(
+                table->slots, capacity * sizeof(tensor_handle_slot_t));
+            if (!slots) return TENSOR_HANDLE_NULL;
+            table->slots = slots;
+            table->capacity = capacity;
+        }
+        slot = (uint32_t)table->length++;
+        table->slots[slot].generation = 1;
+    }
+    
+    tensor_handle_slot_t* entry = &table->slots[slot];
+    entry->tensor = tensor;
+    table->count++;
+    
+    return handle_make(slot, entry->generation);
+}
+
+neural_tensor_t* tensor_handle_get(const tensor_handle_table_t* table, tensor_handle_t handle) {
+    tensor_handle_slot_t* entry = handle_slot(table, handle);
+    return entry ? entry->tensor : NULL;
+}
+
+neural_tensor_t* tensor_handle_take(tensor_handle_table_t* table, tensor_handle_t handle) {
+    tensor_handle_slot_t* entry = handle_slot(table, handle);
+    if (!entry) return NULL;
+    
+    neural_tensor_t* tensor = entry->tensor;
+    slot_retire(table, (uint32_t)(entry - table->slots));
+    return tensor;
+}
+
+bool tensor_handle_release(tensor_handle_table_t* table, tensor_handle_t handle) {
+    neural_tensor_t* tensor = tensor_handle_take(table, handle);
+    if (!tensor) return false;
+    
+    neural_tensor_free(tensor);
+    return true;
+}
@@ -0,0 +1,383 @@
+/**
+ * working_memory.c
+ *
+ * Implementation of the working memory ring
+ */
+
+#include "working_memory.h"
+#include "neural_parallel.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+// k-means iterations when training product-quantization codebooks
+#define WORKING_MEMORY_PQ_ITERATIONS 8
+
+// Slots scored per parallel task during exact retrieval
+#define WORKING_MEMORY_SCORE_CHUNK 1024
+
+// ============================================================================
+// LIFECYCLE
+// ============================================================================
+
+working_memory_t* working_memory_create(size_t capacity, size_t dim) {
+    if (capacity == 0 || dim == 0) return NULL;
+    
+    working_memory_t* memory = (working_memory_t*)calloc(1, sizeof(working_memory_t));
+    if (!memory) return NULL;
+    
+    memory->capacity = capacity;
+    memory->dim = dim;
+    memory->timestamps = (uint64_t*)calloc(capacity, sizeof(uint64_t));
+    memory->embeddings = (float*)calloc(capacity * dim, sizeof(float));
+    memory->owns_embeddings = true;
+    memory->inv_norms = (float*)calloc(capacity, sizeof(float));
+    memory->scores = (float*)malloc(capacity * sizeof(float));
+    memory->query_unit = (float*)malloc(dim * sizeof(float));
+    
+    if (!memory->timestamps || !memory->embeddings || !memory->inv_norms ||
+        !memory->scores || !memory->query_unit) {
+        working_memory_free(memory);
+        return NULL;
+    }
+    
+    return memory;
+}
+
+void working_memory_free(working_memory_t* memory) {
+    if (memory) {
+        free(memory->timestamps);
+        if (memory->owns_embeddings) free(memory->embeddings);
+        free(memory->inv_norms);
+        free(memory->codes);
+        free(memory->codebooks);
+        free(memory->scores);
+        free(memory->query_unit);
+        free(memory->lut);
+        free(memory);
+    }
+}
+
+void working_memory_clear(working_memory_t* memory) {
+    if (!memory) return;
+    
+    memory->length = 0;
+    memory->head = 0;
+}
+
+// ============================================================================
+// PRODUCT QUANTIZATION
+// ============================================================================
+
+static size_t subspace_begin(const working_memory_t* memory, size_t m) {
+    return m * memory->dim / memory->n_subspaces;
+}
+
+static const float* pq_centroid(const working_memory_t* memory, size_t m, size_t c) {
+    size_t begin = subspace_begin(memory, m);
+    size_t len = subspace_begin(memory, m + 1) - begin;
+    return memory->codebooks + WORKING_MEMORY_PQ_CENTROIDS * begin + c * len;
+}
+
+/**
+ * Nearest centroid (L2) of x[len] among n candidates of length len
+ */
+static size_t pq_nearest(const float* centroids, size_t n, size_t len, const float* x) {
+    size_t best = 0;
+    float best_dist = INFINITY;
+    for (size_t c = 0; c < n; c++) {
+        const float* centroid = centroids + c * len;
+        float dist = 0.0f;
+        for (size_t e = 0; e < len; e++) {
+            float delta = x[e] - centroid[e];
+            dist += delta * delta;
+        }
+        if (dist < best_dist) {
+            best_dist = dist;
+            best = c;
+        }
+    }
+    return best;
+}
+
+static void pq_encode(const working_memory_t* memory, const float* unit, uint8_t* code) {
+    for (size_t m = 0; m < memory->n_subspaces; m++) {
+        size_t begin = subspace_begin(memory, m);
+        size_t len = subspace_begin(memory, m + 1) - begin;
+        code[m] = (uint8_t)pq_nearest(pq_centroid(memory, m, 0), memory->n_centroids, len,
+                                      unit + begin);
+    }
+}
+
+/**
+ * 1 / |x| (0 for a zero vector)
+ */
+static float inverse_norm(const float* x, size_t dim) {
+    float norm = 0.0f;
+    for (size_t e = 0; e < dim; e++) {
+        norm += x[e] * x[e];
+    }
+    return (norm > 0.0f) ? 1.0f / sqrtf(norm) : 0.0f;
+}
+
+/**
+ * Write x / |x| to out (zeros for a zero vector)
+ */
+static void normalize_into(const float* x, size_t dim, float* out) {
+    float inv = inverse_norm(x, dim);
+    for (size_t e = 0; e < dim; e++) {
+        out[e] = x[e] * inv;
+    }
+}
+
+/**
+ * Lloyd iterations for one subspace over unit-normalized training rows
+ */
+static bool pq_train_subspace(working_memory_t* memory, size_t m,
+                              const float* train, size_t n_train) {
+    size_t dim = memory->dim;
+    size_t begin = subspace_begin(memory, m);
+    size_t len = subspace_begin(memory, m + 1) - begin;
+    size_t k = memory->n_centroids;
+    float* centroids = (float*)pq_centroid(memory, m, 0);
+    
+    float* sums = (float*)malloc(k * len * sizeof(float));
+    size_t* counts = (size_t*)malloc(k * sizeof(size_t));
+    if (!sums || !counts) {
+        free(sums);
+        free(counts);
+        return false;
+    }
+    
+    // Spread the initial centroids over the training set
+    for (size_t c = 0; c < k; c++) {
+        memcpy(centroids + c * len, train + (c * n_train / k) * dim + begin, len * sizeof(float));
+    }
+    
+    for (int iter = 0; iter < WORKING_MEMORY_PQ_ITERATIONS; iter++) {
+        memset(sums, 0, k * len * sizeof(float));
+        memset(counts, 0, k * sizeof(size_t));
+        for (size_t i = 0; i < n_train; i++) {
+            const float* x = train + i * dim + begin;
+            size_t c = pq_nearest(centroids, k, len, x);
+            float* sum = sums + c * len;
+            for (size_t e = 0; e < len; e++) {
+                sum[e] += x[e];
+            }
+            counts[c]++;
+        }
+        // Empty clusters keep their previous centroid
+        for (size_t c = 0; c < k; c++) {
+            if (counts[c] == 0) continue;
+            float inv = 1.0f / (float)counts[c];
+            for (size_t e = 0; e < len; e++) {
+                centroids[c * len + e] = sums[c * len + e] * inv;
+            }
+        }
+    }
+    
+    free(sums);
+    free(counts);
+    return true;
+}
+
+bool working_memory_quantize(working_memory_t* memory, size_t n_subspaces,
+                             const float* samples, size_t n_samples) {
+    if (!memory || memory->quantized) return false;
+    if (n_subspaces == 0 || n_subspaces > memory->dim) return false;
+    
+    size_t dim = memory->dim;
+    const float* source = samples ? samples : memory->embeddings;
+    size_t n_train = samples ? n_samples : memory->length;
+    if (n_train == 0) return false;
+    
+    float* train = (float*)malloc(n_train * dim * sizeof(float));
+    uint8_t* codes = (uint8_t*)calloc(memory->capacity * n_subspaces, sizeof(uint8_t));
+    float* codebooks = (float*)calloc(WORKING_MEMORY_PQ_CENTROIDS * dim, sizeof(float));
+    float* lut = (float*)malloc(n_subspaces * WORKING_MEMORY_PQ_CENTROIDS * sizeof(float));
+    if (!train || !codes || !codebooks || !lut) {
+        free(train);
+        free(codes);
+        free(codebooks);
+        free(lut);
+        return false;
+    }
+    
+    for (size_t i = 0; i < n_train; i++) {
+        normalize_into(source + i * dim, dim, train + i * dim);
+    }
+    
+    memory->n_subspaces = n_subspaces;
+    memory->n_centroids = (n_train < WORKING_MEMORY_PQ_CENTROIDS) ? n_train
+                                                                  : WORKING_MEMORY_PQ_CENTROIDS;
+    memory->codebooks = codebooks;
+    for (size_t m = 0; m < n_subspaces; m++) {
+        if (!pq_train_subspace(memory, m, train, n_train)) {
+            memory->codebooks = NULL;
+            free(train);
+            free(codes);
+            free(codebooks);
+            free(lut);
+            return false;
+        }
+    }
+    
+    // Re-encode what is already stored, then drop the exact copies
+    for (size_t slot = 0; slot < memory->length; slot++) {
+        normalize_into(memory->embeddings + slot * dim, dim, train);
+        pq_encode(memory, train, codes + slot * n_subspaces);
+    }
+    
+    free(train);
+    if (memory->owns_embeddings) free(memory->embeddings);
+    free(memory->inv_norms);
+    memory->embeddings = NULL;
+    memory->inv_norms = NULL;
+    memory->codes = codes;
+    memory->lut = lut;
+    memory->quantized = true;
+    return true;
+}
+
+// ============================================================================
+// STORE AND READ
+// ============================================================================
+
+size_t working_memory_store(working_memory_t* memory, const float* embedding) {
+    if (!memory || !embedding) return SIZE_MAX;
+    
+    size_t slot = memory->head;
+    memory->head = (memory->head + 1) % memory->capacity;
+    if (memory->length < memory->capacity) memory->length++;
+    memory->timestamps[slot] = memory->clock++;
+    
+    size_t dim = memory->dim;
+    if (memory->quantized) {
+        normalize_into(embedding, dim, memory->query_unit);
+        pq_encode(memory, memory->query_unit, memory->codes + slot * memory->n_subspaces);
+    } else {
+        memcpy(memory->embeddings + slot * dim, embedding, dim * sizeof(float));
+        memory->inv_norms[slot] = inverse_norm(embedding, dim);
+    }
+    
+    return slot;
+}
+
+bool working_memory_get(const working_memory_t* memory, size_t slot, float* out) {
+    if (!memory || !out || slot >= memory->length) return false;
+    
+    if (!memory->quantized) {
+        memcpy(out, memory->embeddings + slot * memory->dim, memory->dim * sizeof(float));
+        return true;
+    }
+    
+    const uint8_t* code = memory->codes + slot * memory->n_subspaces;
+    for (size_t m = 0; m < memory->n_subspaces; m++) {
+        size_t begin = subspace_begin(memory, m);
+        size_t len = subspace_begin(memory, m + 1) - begin;
+        memcpy(out + begin, pq_centroid(memory, m, code[m]), len * sizeof(float));
+    }
+    return true;
+}
+
+// ============================================================================
+// RETRIEVAL
+// ============================================================================
+
+typedef struct {
+    const working_memory_t* memory;
+    const float* query;
+    float inv_query;
+} score_job_t;
+
+/**
+ * Exact cosine scores for one chunk of slots (unit-stride dot products)
+ */
+static void score_chunk_task(void* ctx, size_t chunk) {
+    score_job_t* job = (score_job_t*)ctx;
+    const working_memory_t* memory = job->memory;
+    size_t dim = memory->dim;
+    
+    size_t begin = chunk * WORKING_MEMORY_SCORE_CHUNK;
+    size_t end = begin + WORKING_MEMORY_SCORE_CHUNK;
+    if (end > memory->length) end = memory->length;
+    
+    for (size_t slot = begin; slot < end; slot++) {
+        const float* row = memory->embeddings + slot * dim;
+        float dot = 0.0f;
+        for (size_t e = 0; e < dim; e++) {
+            dot += job->query[e] * row[e];
+        }
+        memory->scores[slot] = dot * memory->inv_norms[slot] * job->inv_query;
+    }
+}
+
+/**
+ * Approximate cosine scores through per-subspace lookup tables
+ */
+static void score_quantized(working_memory_t* memory, const float* query) {
+    size_t n_sub = memory->n_subspaces;
+    normalize_into(query, memory->dim, memory->query_unit);
+    
+    for (size_t m = 0; m < n_sub; m++) {
+        size_t begin = subspace_begin(memory, m);
+        size_t len = subspace_begin(memory, m + 1) - begin;
+        const float* q = memory->query_unit + begin;
+        float* table = memory->lut + m * WORKING_MEMORY_PQ_CENTROIDS;
+        for (size_t c = 0; c < memory->n_centroids; c++) {
+            const float* centroid = pq_centroid(memory, m, c);
+            float dot = 0.0f;
+            for (size_t e = 0; e < len; e++) {
+                dot += q[e] * centroid[e];
+            }
+            table[c] = dot;
+        }
+    }
+    
+    for (size_t slot = 0; slot < memory->length; slot++) {
+        const uint8_t* code = memory->codes + slot * n_sub;
+        float score = 0.0f;
+        for (size_t m = 0; m < n_sub; m++) {
+            score += memory->lut[m * WORKING_MEMORY_PQ_CENTROIDS + code[m]];
+        }
+        memory->scores[slot] = score;
+    }
+}
+
+static bool match_before(const working_memory_match_t* a, const working_memory_match_t* b) {
+    if (a->similarity != b->similarity) return a->similarity > b->similarity;
+    return a->timestamp > b->timestamp;
+}
+
+size_t working_memory_retrieve(working_memory_t* memory, const float* query, size_t k,
+                               working_memory_match_t* matches) {
+    if (!memory || !query || !matches) return 0;
+    
+    size_t n = memory->length;
+    if (k > n) k = n;
+    if (k == 0) return 0;
+    
+    if (memory->quantized) {
+        score_quantized(memory, query);
+    } else {
+        score_job_t job = {memory, query, inverse_norm(query, memory->dim)};
+        size_t n_chunks = (n + WORKING_MEMORY_SCORE_CHUNK - 1) / WORKING_MEMORY_SCORE_CHUNK;
+        neural_parallel_for(n_chunks, score_chunk_task, &job);
+    }
+    
+    // Keep the best k in order by insertion
+    size_t found = 0;
+    for (size_t slot = 0; slot < n; slot++) {
+        working_memory_match_t candidate = {slot, memory->scores[slot], memory->timestamps[slot]};
+        if (found == k && !match_before(&candidate, &matches[k - 1])) continue;
+    
+        size_t pos = (found < k) ? found++ : k - 1;
+        while (pos > 0 && match_before(&candidate, &matches[pos - 1])) {
+            matches[pos] = matches[pos - 1];
+            pos--;
+        }
+        matches[pos] = candidate;
+    }
+    
+    return found;
+}